@@ -0,0 +1,468 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+#include "misc/combinatorics.h"
+#include "misc/CsrGraph.h"
+#include "misc/EdgeValueIndex.h"
+#include "misc/GraphGenerator.h"
+#include "misc/MatchSet.h"
+#include "misc/Matrix.h"
+#include "misc/PatternBuilder.h"
+#include "patternResolver.h"
+#include "fastPatternResolver.h"
+#include "sparsePatternResolver.h"
+
+/**
+ * Воспроизводимый замер скорости методов поиска изоморфных подграфов
+ *
+ * Запуск: Benchmark [--sources 40,80] [--patterns 3,4] [--densities 0.2,0.5] [--values 2,16]
+ *                   [--checks hard,soft] [--engines fast,count,indexed,sparse,parallel,brute]
+ *                   [--planted 3] [--warmup 1] [--repeat 5] [--threads 4] [--seed 1]
+ *                   [--brute-limit 100000] [--format csv|json] [--output <file>]
+ *
+ * Для каждой точки декартова произведения параметров строится дата-граф и паттерн,
+ * в дата-граф добавляются копии паттерна, после чего каждый метод запускается
+ * `warmup` раз без замера и `repeat` раз с замером. Генератор каждой точки
+ * `GraphGenerator` инициализируется зерном, полученным из общего зерна и параметров
+ * точки, поэтому одна и та же точка даёт одинаковую нагрузку при любом наборе
+ * остальных параметров и на любой платформе. Результаты вместе с параметрами
+ * записываются в CSV или JSON; кол-во найденных вхождений всех методов сверяется
+ * между собой
+ */
+
+/**
+ * Параметры замера
+ */
+struct BenchmarkOptions {
+    /**
+     * Размеры дата-графов
+     */
+    std::vector<int> sources = {40, 80};
+    /**
+     * Размеры паттернов
+     */
+    std::vector<int> patterns = {3, 4};
+    /**
+     * Доли ненулевых элементов
+     */
+    std::vector<double> densities = {0.2, 0.5};
+    /**
+     * Кол-ва различных ненулевых значений элементов
+     */
+    std::vector<int> values = {2, 16};
+    /**
+     * Режимы сверки: `true` - жёсткая
+     */
+    std::vector<bool> checks = {true, false};
+    /**
+     * Замеряемые методы
+     */
+    std::vector<std::string> engines = {"fast", "count", "indexed", "sparse", "parallel", "brute"};
+    /**
+     * Кол-во копий паттерна, добавляемых в дата-граф
+     */
+    int planted = 3;
+    /**
+     * Кол-во запусков без замера
+     */
+    int warmup = 1;
+    /**
+     * Кол-во запусков с замером
+     */
+    int repeat = 5;
+    /**
+     * Кол-во потоков многопоточного метода
+     */
+    int threads = 4;
+    /**
+     * Общее зерно генератора
+     */
+    unsigned int seed = 1;
+    /**
+     * Наибольшее кол-во комбинаций `C(n, k)`, при котором запускается полный перебор
+     */
+    long long bruteLimit = 100000;
+    /**
+     * Формат вывода: `csv` или `json`
+     */
+    std::string format = "csv";
+    /**
+     * Файл результата; пустая строка - стандартный вывод
+     */
+    std::string output;
+};
+
+/**
+ * Результат замера одного метода в одной точке
+ */
+struct BenchmarkResult {
+    /**
+     * Метод
+     */
+    std::string engine;
+    /**
+     * Размер дата-графа
+     */
+    int sourceSize;
+    /**
+     * Размер паттерна
+     */
+    int patternSize;
+    /**
+     * Доля ненулевых элементов
+     */
+    double density;
+    /**
+     * Кол-во различных ненулевых значений
+     */
+    int valueRange;
+    /**
+     * Флаг жёсткой сверки
+     */
+    bool hardCheck;
+    /**
+     * Зерно генератора точки
+     */
+    unsigned int seed;
+    /**
+     * Кол-во найденных вхождений
+     */
+    long long matches;
+    /**
+     * Время запусков в микросекундах
+     */
+    std::vector<double> times;
+};
+
+/**
+ * Разбить строку по запятым
+ *
+ * @param s строка
+ * @return части строки
+ */
+std::vector<std::string> splitList(const std::string &s) {
+    std::vector<std::string> res;
+    std::stringstream ss(s);
+    std::string item;
+    while (std::getline(ss, item, ','))
+        if (!item.empty())
+            res.push_back(item);
+    if (res.empty())
+        throw std::invalid_argument("empty list: " + s);
+    return res;
+}
+
+/**
+ * Разобрать аргументы командной строки
+ *
+ * @param argc кол-во аргументов
+ * @param argv аргументы
+ * @return параметры замера
+ */
+BenchmarkOptions parseOptions(int argc, char **argv) {
+    BenchmarkOptions options;
+    for (int i = 1; i < argc; i += 2) {
+        std::string key = argv[i];
+        if (i + 1 >= argc)
+            throw std::invalid_argument("no value for " + key);
+        std::string value = argv[i + 1];
+
+        if (key == "--sources" || key == "--patterns" || key == "--values") {
+            std::vector<int> list;
+            for (const std::string &item: splitList(value)) {
+                list.push_back(std::stoi(item));
+                if (list.back() <= 0)
+                    throw std::invalid_argument(key + " must be positive: " + item);
+            }
+            (key == "--sources" ? options.sources : key == "--patterns" ? options.patterns : options.values) = list;
+        } else if (key == "--densities") {
+            options.densities.clear();
+            for (const std::string &item: splitList(value)) {
+                options.densities.push_back(std::stod(item));
+                if (options.densities.back() < 0 || options.densities.back() > 1)
+                    throw std::invalid_argument("density must be in [0, 1]: " + item);
+            }
+        } else if (key == "--checks") {
+            options.checks.clear();
+            for (const std::string &item: splitList(value)) {
+                if (item != "hard" && item != "soft")
+                    throw std::invalid_argument("check must be hard or soft: " + item);
+                options.checks.push_back(item == "hard");
+            }
+        } else if (key == "--engines") {
+            options.engines = splitList(value);
+            for (const std::string &engine: options.engines)
+                if (engine != "fast" && engine != "count" && engine != "indexed" && engine != "sparse" &&
+                    engine != "parallel" && engine != "brute")
+                    throw std::invalid_argument("unknown engine: " + engine);
+        } else if (key == "--planted")
+            options.planted = std::stoi(value);
+        else if (key == "--warmup")
+            options.warmup = std::stoi(value);
+        else if (key == "--repeat")
+            options.repeat = std::stoi(value);
+        else if (key == "--threads")
+            options.threads = std::stoi(value);
+        else if (key == "--seed")
+            options.seed = (unsigned int) std::stoul(value);
+        else if (key == "--brute-limit")
+            options.bruteLimit = std::stoll(value);
+        else if (key == "--format") {
+            if (value != "csv" && value != "json")
+                throw std::invalid_argument("format must be csv or json: " + value);
+            options.format = value;
+        } else if (key == "--output")
+            options.output = value;
+        else
+            throw std::invalid_argument("unknown option: " + key);
+    }
+    if (options.planted < 0 || options.warmup < 0 || options.repeat <= 0 || options.threads <= 0)
+        throw std::invalid_argument("planted, warmup, repeat and threads must be positive");
+    return options;
+}
+
+/**
+ * Зерно генератора точки
+ *
+ * @param options     параметры замера
+ * @param sourceSize  размер дата-графа
+ * @param patternSize размер паттерна
+ * @param density     доля ненулевых элементов
+ * @param valueRange  кол-во различных ненулевых значений
+ * @return зерно
+ */
+unsigned int configSeed(const BenchmarkOptions &options, int sourceSize, int patternSize, double density,
+                        int valueRange) {
+    // режим сверки в зерно не входит: жёсткий и мягкий поиск идут по одной нагрузке
+    std::seed_seq seq{
+            options.seed, (unsigned int) sourceSize, (unsigned int) patternSize,
+            (unsigned int) std::lround(density * 1000000), (unsigned int) valueRange
+    };
+    unsigned int res;
+    seq.generate(&res, &res + 1);
+    return res;
+}
+
+/**
+ * Замерить время запусков метода
+ *
+ * @param options параметры замера
+ * @param run     метод; возвращает кол-во найденных вхождений
+ * @param result  результат, в который записываются времена и кол-во вхождений
+ */
+void measure(const BenchmarkOptions &options, const std::function<long long()> &run, BenchmarkResult &result) {
+    for (int i = 0; i < options.warmup; i++)
+        result.matches = run();
+    for (int i = 0; i < options.repeat; i++) {
+        auto start = std::chrono::steady_clock::now();
+        result.matches = run();
+        auto elapsed = std::chrono::steady_clock::now() - start;
+        result.times.push_back(
+                (double) std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() / 1000.0
+        );
+    }
+}
+
+/**
+ * Замерить все методы в одной точке
+ *
+ * @param options     параметры замера
+ * @param sourceSize  размер дата-графа
+ * @param patternSize размер паттерна
+ * @param density     доля ненулевых элементов
+ * @param valueRange  кол-во различных ненулевых значений
+ * @param results     список, в который добавляются результаты
+ * @return флаг, совпало ли кол-во вхождений у всех методов
+ */
+bool runConfig(const BenchmarkOptions &options, int sourceSize, int patternSize, double density, int valueRange,
+               std::vector<BenchmarkResult> &results) {
+    unsigned int seed = configSeed(options, sourceSize, patternSize, density, valueRange);
+    GraphGenerator generator(seed);
+
+    // формируем дата-граф и паттерн; ненулевые элементы выбираются из [1, valueRange]
+    Matrix source = generator.uniformMatrix(sourceSize, 1, valueRange + 1, density);
+    Matrix pattern = generator.uniformMatrix(patternSize, 1, valueRange + 1, density);
+
+    // добавляем в дата-граф копии паттерна; раундов ограниченное число, чтобы
+    // плотно занятый граф не зациклил генерацию
+    PatternBuilder pb(source);
+    pb.plantPatterns(pattern, options.planted, generator, options.threads);
+
+    // структуры, которые строятся один раз для дата-графа, в замер не входят
+    EdgeValueIndex index(source);
+    CsrGraph sparse(source);
+
+    bool consistent = true;
+    for (bool hardCheck: options.checks) {
+        long long expected = -1;
+        for (const std::string &engine: options.engines) {
+            BenchmarkResult result{engine, sourceSize, patternSize, density, valueRange, hardCheck, seed, 0, {}};
+
+            if (engine == "fast")
+                measure(options, [&source, &pattern, hardCheck]() {
+                    MatchSet matches(pattern.getSize());
+                    fastGetAllPatterns(source, pattern, hardCheck, matches);
+                    return matches.getSize();
+                }, result);
+            else if (engine == "count")
+                measure(options, [&source, &pattern, hardCheck]() {
+                    return fastCountAllPatterns(source, pattern, hardCheck);
+                }, result);
+            else if (engine == "indexed")
+                measure(options, [&source, &pattern, hardCheck, &index]() {
+                    return (long long) fastGetAllPatterns(source, pattern, hardCheck, index).size();
+                }, result);
+            else if (engine == "sparse")
+                measure(options, [&sparse, &pattern, hardCheck]() {
+                    return sparseCountAllPatterns(sparse, pattern, hardCheck);
+                }, result);
+            else if (engine == "parallel")
+                measure(options, [&source, &pattern, hardCheck, &options]() {
+                    return fastCountAllPatterns(source, pattern, hardCheck, options.threads);
+                }, result);
+            else {
+                // полный перебор запускается только на небольших точках
+                bool small;
+                try {
+                    small = binomial(sourceSize, patternSize) <= options.bruteLimit;
+                } catch (const std::overflow_error &) {
+                    small = false;
+                }
+                if (!small)
+                    continue;
+                measure(options, [&source, &pattern, hardCheck]() {
+                    MatchSet matches(pattern.getSize());
+                    getAllPatterns(source, pattern, hardCheck, matches);
+                    return matches.getSize();
+                }, result);
+            }
+
+            // все методы должны найти одинаковое кол-во вхождений
+            if (expected < 0)
+                expected = result.matches;
+            else if (result.matches != expected) {
+                std::cerr << "mismatch: " << engine << " found " << result.matches << " instead of " << expected
+                          << " (n=" << sourceSize << ", k=" << patternSize << ", seed=" << seed << ")" << std::endl;
+                consistent = false;
+            }
+            results.push_back(result);
+        }
+    }
+    return consistent;
+}
+
+/**
+ * Перцентиль времени по ближайшему рангу
+ *
+ * @param sorted отсортированные времена
+ * @param p      перцентиль от `0` до `100`
+ * @return значение перцентиля
+ */
+double percentile(const std::vector<double> &sorted, double p) {
+    auto rank = (size_t) std::ceil(p / 100.0 * (double) sorted.size());
+    return sorted[rank == 0 ? 0 : rank - 1];
+}
+
+/**
+ * Записать результаты
+ *
+ * @param out     поток вывода
+ * @param options параметры замера
+ * @param results результаты
+ */
+void writeResults(std::ostream &out, const BenchmarkOptions &options, const std::vector<BenchmarkResult> &results) {
+    const char *columns[] = {
+            "engine", "sourceSize", "patternSize", "density", "valueRange", "hardCheck", "planted", "seed",
+            "warmup", "repeat", "threads", "matches", "minUs", "medianUs", "p95Us", "meanUs"
+    };
+    bool json = options.format == "json";
+
+    if (json)
+        out << "{\"baseSeed\": " << options.seed << ", \"results\": [" << std::endl;
+    else
+        for (int i = 0; i < 16; i++)
+            out << (i ? "," : "") << columns[i] << (i == 15 ? "\n" : "");
+
+    for (size_t r = 0; r < results.size(); r++) {
+        const BenchmarkResult &result = results[r];
+        std::vector<double> sorted(result.times);
+        std::sort(sorted.begin(), sorted.end());
+        double mean = 0;
+        for (double t: sorted)
+            mean += t / (double) sorted.size();
+
+        std::ostringstream values[16];
+        values[0] << (json ? "\"" + result.engine + "\"" : result.engine);
+        values[1] << result.sourceSize;
+        values[2] << result.patternSize;
+        values[3] << result.density;
+        values[4] << result.valueRange;
+        values[5] << (result.hardCheck ? "true" : "false");
+        values[6] << options.planted;
+        values[7] << result.seed;
+        values[8] << options.warmup;
+        values[9] << options.repeat;
+        values[10] << options.threads;
+        values[11] << result.matches;
+        values[12] << sorted.front();
+        values[13] << percentile(sorted, 50);
+        values[14] << percentile(sorted, 95);
+        values[15] << mean;
+
+        if (json) {
+            out << "  {";
+            for (int i = 0; i < 16; i++)
+                out << (i ? ", " : "") << "\"" << columns[i] << "\": " << values[i].str();
+            out << "}" << (r + 1 < results.size() ? "," : "") << std::endl;
+        } else
+            for (int i = 0; i < 16; i++)
+                out << (i ? "," : "") << values[i].str() << (i == 15 ? "\n" : "");
+    }
+
+    if (json)
+        out << "]}" << std::endl;
+}
+
+/**
+ * Главный метод
+ * @return код возрата: `0`, `1` при ошибке параметров, `2`, если методы нашли разное кол-во вхождений
+ */
+int main(int argc, char **argv) {
+    try {
+        BenchmarkOptions options = parseOptions(argc, argv);
+
+        std::vector<BenchmarkResult> results;
+        bool consistent = true;
+        for (int sourceSize: options.sources)
+            for (int patternSize: options.patterns) {
+                if (patternSize > sourceSize)
+                    continue;
+                for (double density: options.densities)
+                    for (int valueRange: options.values) {
+                        std::cerr << "n=" << sourceSize << " k=" << patternSize << " density=" << density
+                                  << " values=" << valueRange << std::endl;
+                        consistent &= runConfig(options, sourceSize, patternSize, density, valueRange, results);
+                    }
+            }
+
+        if (options.output.empty())
+            writeResults(std::cout, options, results);
+        else {
+            std::ofstream out(options.output);
+            if (!out)
+                throw std::invalid_argument("can not open " + options.output);
+            writeResults(out, options, results);
+        }
+        return consistent ? 0 : 2;
+    } catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+}
@@ -0,0 +1,44 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include "misc/binaryIO.h"
+#include "misc/textIO.h"
+
+/**
+ * Перевод матрицы из текстового формата в двоичный
+ *
+ * Запуск: ConvertGraph <in> <out> [dense|csr]
+ *
+ * Матрица читается в текстовом формате `readMatrix()` и записывается в двоичном
+ * формате с плотной (по умолчанию) или разреженной раскладкой и степенями вершин;
+ * такой файл открывается `MappedGraph` отображением в память без разбора текста
+ */
+int main(int argc, char **argv) {
+    if (argc != 3 && argc != 4) {
+        std::cerr << "usage: " << argv[0] << " <in> <out> [dense|csr]" << std::endl;
+        return 1;
+    }
+
+    try {
+        std::string layout = argc == 4 ? argv[3] : "dense";
+        if (layout != "dense" && layout != "csr")
+            throw std::invalid_argument("unknown layout " + layout);
+
+        std::ifstream in(argv[1]);
+        if (!in)
+            throw std::invalid_argument(std::string("can not open ") + argv[1]);
+        Matrix matrix = readMatrix(in);
+
+        if (layout == "dense")
+            writeBinaryMatrix(argv[2], matrix);
+        else
+            writeBinaryGraph(argv[2], CsrGraph(matrix));
+
+        std::cout << argv[2] << ": " << matrix.getSize() << " vertices, " << layout << std::endl;
+    } catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
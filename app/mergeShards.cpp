@@ -0,0 +1,50 @@
+#include <algorithm>
+#include <iostream>
+#include <fstream>
+#include <string>
+#include "misc/textIO.h"
+
+/**
+ * Объединение результатов поиска по частям перебора
+ *
+ * Запуск: MergeShards <out> <in...>
+ *
+ * Комбинации из всех входных файлов сортируются лексикографически, повторы
+ * удаляются, и результат записывается в выходной файл
+ */
+int main(int argc, char **argv) {
+    if (argc < 3) {
+        std::cerr << "usage: " << argv[0] << " <out> <in...>" << std::endl;
+        return 1;
+    }
+
+    try {
+        // читаем комбинации всех частей
+        std::vector<CombinatoricsData> patterns;
+        for (int i = 2; i < argc; i++) {
+            std::ifstream in(argv[i]);
+            if (!in)
+                throw std::invalid_argument(std::string("can not open ") + argv[i]);
+            std::vector<CombinatoricsData> shard = readCombinations(in);
+            for (CombinatoricsData &cd: shard)
+                patterns.push_back(cd);
+        }
+
+        // сортируем комбинации лексикографически и удаляем повторы
+        std::sort(patterns.begin(), patterns.end());
+        patterns.erase(std::unique(patterns.begin(), patterns.end()), patterns.end());
+
+        // записываем результат
+        std::ofstream out(argv[1]);
+        if (!out)
+            throw std::invalid_argument(std::string("can not open ") + argv[1]);
+        writeCombinations(out, patterns);
+
+        std::cout << patterns.size() << " patterns" << std::endl;
+    } catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
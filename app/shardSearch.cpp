@@ -0,0 +1,77 @@
+#include <iostream>
+#include <fstream>
+#include <memory>
+#include <string>
+#include "misc/binaryIO.h"
+#include "misc/textIO.h"
+#include "fastPatternResolver.h"
+
+/**
+ * Поиск изоморфных подграфов в одной части перебора
+ *
+ * Запуск: ShardSearch <source> <pattern> <hardCheck 0|1> <shardIndex> <shardCount> <out>
+ *
+ * Матрицы читаются в текстовом формате `readMatrix()` или в двоичном формате
+ * `writeBinaryMatrix()`; двоичные файлы отображаются в память без копирования.
+ * Найденные комбинации записываются по одной на строку; результаты всех частей
+ * объединяются программой MergeShards
+ */
+/**
+ * Открыть матрицу из файла
+ *
+ * @param path   путь к файлу
+ * @param mapped отображение двоичного файла; матрица-результат действительна, пока оно живо
+ * @return матрица; для двоичного файла - представление отображённой памяти
+ */
+Matrix openMatrix(const std::string &path, std::unique_ptr<MappedGraph> &mapped) {
+    if (isBinaryGraphFile(path)) {
+        mapped.reset(new MappedGraph(path));
+        // разреженный граф приходится развернуть в плотную матрицу
+        if (!mapped->isDense())
+            return mapped->getGraph().toMatrix();
+        Matrix &matrix = mapped->getMatrix();
+        return Matrix(matrix.getData(), matrix.getSize(), matrix.getStride());
+    }
+
+    std::ifstream in(path);
+    if (!in)
+        throw std::invalid_argument("can not open " + path);
+    return readMatrix(in);
+}
+
+int main(int argc, char **argv) {
+    if (argc != 7) {
+        std::cerr << "usage: " << argv[0]
+                  << " <source> <pattern> <hardCheck 0|1> <shardIndex> <shardCount> <out>" << std::endl;
+        return 1;
+    }
+
+    try {
+        // читаем дата-граф и паттерн
+        std::unique_ptr<MappedGraph> mappedSource, mappedPattern;
+        Matrix source = openMatrix(argv[1], mappedSource);
+        Matrix pattern = openMatrix(argv[2], mappedPattern);
+
+        bool hardCheck = std::stoi(argv[3]) != 0;
+        int shardIndex = std::stoi(argv[4]);
+        int shardCount = std::stoi(argv[5]);
+
+        // ищем паттерны в своей части перебора
+        std::vector<CombinatoricsData> patterns =
+                fastGetAllPatternsShard(source, pattern, hardCheck, shardIndex, shardCount);
+
+        // записываем найденные комбинации
+        std::ofstream out(argv[6]);
+        if (!out)
+            throw std::invalid_argument(std::string("can not open ") + argv[6]);
+        writeCombinations(out, patterns);
+
+        std::cout << "shard " << shardIndex << "/" << shardCount << ": "
+                  << patterns.size() << " patterns" << std::endl;
+    } catch (const std::exception &e) {
+        std::cerr << e.what() << std::endl;
+        return 1;
+    }
+
+    return 0;
+}
@@ -0,0 +1,230 @@
+#pragma once
+
+#include <vector>
+#include "misc/BitGraph.h"
+#include "misc/IntSpan.h"
+#include "misc/Matrix.h"
+
+/**
+ * Поиск нескольких паттернов в одном дата-графе за один обход
+ *
+ * Паттерны объединяются в префиксное дерево: узел глубины `d` соответствует
+ * ведущей подматрице размера `d + 1` (первым `d + 1` точкам паттерна), и паттерны
+ * с одинаковой ведущей подматрицей проходят через одни и те же узлы. Дерево
+ * обходится один раз: частичная комбинация, найденная для общего узла, продолжается
+ * во всех его дочерних узлах, а не перебирается заново для каждого паттерна
+ *
+ * Точки каждого паттерна сопоставляются в порядке их индексов - только так
+ * паттерны с общей ведущей подматрицей делят узлы дерева. Кандидаты для точки
+ * получаются пересечением битовых плоскостей уже выбранных вершин, как в `FastPatternSearch`
+ */
+class BatchPatternSearch {
+    /**
+     * Элемент паттерна не накладывает ограничений на элемент дата-графа
+     */
+    static const int NO_PLANE = -1;
+    /**
+     * Элемент дата-графа должен быть нулевым
+     */
+    static const int ZERO_PLANE = -2;
+
+    /**
+     * Узел префиксного дерева
+     */
+    struct Node {
+        /**
+         * Элементы паттерна, которые добавляет узел к ведущей подматрице родителя:
+         * диагональный, затем строка и столбец новой точки; по ним узлы сравниваются при слиянии
+         */
+        std::vector<int> key;
+        /**
+         * Флаг, должна ли петля вершины совпадать с диагональным элементом паттерна
+         */
+        bool loopConstrained;
+        /**
+         * Диагональный элемент паттерна
+         */
+        int loop;
+        /**
+         * Плоскости рёбер из выбранных вершин в новую: `fromPrefix[j]` - для точки `j`
+         */
+        std::vector<int> fromPrefix;
+        /**
+         * Плоскости рёбер из новой вершины в выбранные: `toPrefix[j]` - для точки `j`
+         */
+        std::vector<int> toPrefix;
+        /**
+         * Номера паттернов, которые заканчиваются в этом узле
+         */
+        std::vector<int> patternIds;
+        /**
+         * Дочерние узлы
+         */
+        std::vector<int> children;
+    };
+
+    /**
+     * Битовое представление дата-графа
+     */
+    BitGraph graph;
+    /**
+     * Размер стороны дата-графа
+     */
+    int sourceSize;
+    /**
+     * Кол-во 64-битных слов в битовой строке вершин дата-графа
+     */
+    int wordsCnt;
+    /**
+     * Значения петель вершин дата-графа
+     */
+    std::vector<int> loops;
+    /**
+     * Наибольший размер паттерна
+     */
+    int maxPatternSize;
+    /**
+     * Узлы префиксного дерева; нулевой - корень, соответствующий пустой подматрице
+     */
+    std::vector<Node> nodes;
+
+    /**
+     * Получить номер битовой плоскости, которой должен принадлежать элемент дата-графа,
+     * соответствующий элементу паттерна
+     *
+     * @param value     элемент паттерна
+     * @param hardCheck флаг, нужна ли жёсткая проверка
+     * @return номер битовой плоскости, `NO_PLANE` или `ZERO_PLANE`
+     */
+    int getConstraintPlane(int value, bool hardCheck) const;
+
+    /**
+     * Проверить, подходит ли петля вершины узлу
+     *
+     * @param node   узел
+     * @param vertex вершина дата-графа
+     * @return флаг, подходит ли петля
+     */
+    bool fitsLoop(const Node &node, int vertex) const {
+        return !node.loopConstrained || loops[vertex] == node.loop;
+    }
+
+    /**
+     * Заполнить кандидатов для точки узла: свободные вершины, совместимые со всеми выбранными
+     *
+     * @param node        узел
+     * @param depth       глубина узла
+     * @param combination выбранные вершины
+     * @param used        битовая строка занятых вершин
+     * @param candidates  битовая строка, в которую записываются кандидаты
+     */
+    void fillCandidates(
+            const Node &node, int depth, const std::vector<int> &combination, const uint64_t *used,
+            uint64_t *candidates
+    ) const;
+
+    /**
+     * Шаг обхода префиксного дерева
+     *
+     * @param parent      узел, ведущая подматрица которого уже сопоставлена
+     * @param depth       кол-во выбранных точек
+     * @param combination выбранные вершины
+     * @param used        битовая строка занятых вершин
+     * @param buffers     битовые строки кандидатов по глубинам
+     * @param consumer    лямбда выражение (int patternId, IntSpan c)->bool; возвращает `false`,
+     *                    если поиск нужно остановить
+     * @return флаг, был ли обход доведён до конца, а не остановлен обработчиком
+     */
+    template<typename F>
+    bool findPatternStep(
+            int parent, int depth, std::vector<int> &combination, std::vector<uint64_t> &used,
+            std::vector<uint64_t> &buffers, const F &consumer
+    ) const;
+
+public:
+    /**
+     * Конструктор
+     *
+     * @param source    дата-граф
+     * @param patterns  искомые паттерны
+     * @param hardCheck флаг, нужна ли жёсткая проверка
+     */
+    BatchPatternSearch(const Matrix &source, const std::vector<Matrix> &patterns, bool hardCheck);
+
+    /**
+     * Получить кол-во узлов префиксного дерева без учёта корня
+     * @return кол-во узлов
+     */
+    int getNodeCount() const {
+        return (int) nodes.size() - 1;
+    }
+
+    /**
+     * Запустить поиск всех вхождений всех паттернов
+     *
+     * @param consumer обработчик найденной комбинации (int patternId, IntSpan c)->bool;
+     *                 возвращает `false`, если поиск нужно остановить
+     * @return флаг, был ли обход доведён до конца, а не остановлен обработчиком
+     */
+    template<typename F>
+    bool run(const F &consumer) const {
+        std::vector<int> combination(maxPatternSize, 0);
+        std::vector<uint64_t> used(wordsCnt, 0);
+        std::vector<uint64_t> buffers((long long) maxPatternSize * wordsCnt, 0);
+        // пустые паттерны входят в любой дата-граф ровно один раз
+        for (int id: nodes[0].patternIds)
+            if (!consumer(id, IntSpan(combination.data(), 0)))
+                return false;
+        return findPatternStep(0, 0, combination, used, buffers, consumer);
+    }
+};
+
+/**
+ * Шаг обхода префиксного дерева
+ *
+ * Для каждого дочернего узла кандидаты считаются отдельно, но частичная комбинация
+ * родителя у всех них общая
+ *
+ * @param parent      узел, ведущая подматрица которого уже сопоставлена
+ * @param depth       кол-во выбранных точек
+ * @param combination выбранные вершины
+ * @param used        битовая строка занятых вершин
+ * @param buffers     битовые строки кандидатов по глубинам
+ * @param consumer    лямбда выражение (int patternId, IntSpan c)->bool; возвращает `false`,
+ *                    если поиск нужно остановить
+ * @return флаг, был ли обход доведён до конца, а не остановлен обработчиком
+ */
+template<typename F>
+bool BatchPatternSearch::findPatternStep(
+        int parent, int depth, std::vector<int> &combination, std::vector<uint64_t> &used,
+        std::vector<uint64_t> &buffers, const F &consumer
+) const {
+    uint64_t *candidates = buffers.data() + (long long) depth * wordsCnt;
+    for (int child: nodes[parent].children) {
+        const Node &node = nodes[child];
+        fillCandidates(node, depth, combination, used.data(), candidates);
+
+        bool completed = forEachBitWhile(candidates, wordsCnt, [this, &node, &child, &depth, &combination, &used,
+                &buffers, &consumer](int vertex) {
+            if (!fitsLoop(node, vertex))
+                return true;
+            combination[depth] = vertex;
+
+            // сообщаем о паттернах, которые заканчиваются в этом узле
+            for (int id: node.patternIds)
+                if (!consumer(id, IntSpan(combination.data(), depth + 1)))
+                    return false;
+
+            // продолжаем комбинацию в дочерних узлах
+            if (node.children.empty())
+                return true;
+            setBit(used.data(), vertex);
+            bool res = findPatternStep(child, depth + 1, combination, used, buffers, consumer);
+            clearBit(used.data(), vertex);
+            return res;
+        });
+        if (!completed)
+            return false;
+    }
+    return true;
+}
@@ -0,0 +1,1130 @@
+#pragma once
+
+#include <atomic>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+#include <unordered_map>
+#include "misc/Matrix.h"
+#include "misc/BitGraph.h"
+#include "misc/EdgeValueIndex.h"
+#include "misc/SearchStatistics.h"
+#include "misc/TaskPool.h"
+
+/**
+ * Быстрый поиск паттерна в дата-графе
+ *
+ * Для каждой точки паттерна хранится домен - битовая строка вершин дата-графа,
+ * которые ещё могут быть ей сопоставлены. Начальные домены отбираются по
+ * диагональному элементу и по кол-ву исходящих и входящих рёбер каждого значения.
+ * После выбора очередной точки комбинации домены всех ещё не выбранных точек
+ * сужаются строками битовых плоскостей выбранной вершины (прямая проверка),
+ * и если какой-то домен опустел, ветка перебора сразу отбрасывается
+ *
+ * Точки паттерна перебираются не по порядку индексов, а в порядке сопоставления:
+ * сначала самая ограниченная точка, затем каждый раз та, что сильнее всего связана
+ * с уже упорядоченными. Комбинация при этом хранится в индексах паттерна,
+ * поэтому результат не зависит от порядка сопоставления
+ *
+ * Если передан индекс значений рёбер `EdgeValueIndex`, перебор начинается не с вершин
+ * первой точки, а с позиций самого редкого в дата-графе значения ребра паттерна:
+ * обе точки этого ребра выбираются сразу, и объём работы определяется
+ * избирательностью значения, а не размером дата-графа
+ *
+ * Дополнительно можно задать ограничения порядка вида `c[a] < c[b]` на вершины,
+ * сопоставленные точкам паттерна: они проверяются той же прямой проверкой, что и рёбра,
+ * и позволяют отсечь симметричные друг другу комбинации
+ *
+ * Сам объект после построения не изменяется: всё, что меняется при переборе,
+ * лежит в состоянии `SearchState`, поэтому несколько потоков могут
+ * вести поиск одновременно, каждый со своим состоянием
+ *
+ * Паттерны из 3-8 точек перебираются ядрами `Kernel`, собранными под размер паттерна:
+ * комбинация и ограничения по глубинам лежат в массивах фиксированного размера,
+ * а глубина перебора - параметр шаблона, поэтому циклы по точкам разворачиваются
+ * компилятором. Паттерны других размеров перебираются общим кодом
+ *
+ * Если библиотека собрана с опцией `PATTERNS_SEARCH_STATISTICS`, методы перебора
+ * могут вернуть статистику `SearchStatistics`: узлы по глубинам, отсечения по причинам,
+ * найденные вхождения и время построения и перебора
+ */
+class FastPatternSearch {
+public:
+    /**
+     * Состояние перебора одного потока
+     */
+    struct SearchState {
+        /**
+         * Домены точек паттерна по глубинам рекурсии начиная с первой: на глубине `cnt`
+         * для каждой точки паттерна хранится битовая строка вершин, совместимых со всеми
+         * `cnt` уже выбранными точками комбинации
+         */
+        std::vector<uint64_t> domains;
+        /**
+         * Текущая комбинация в индексах паттерна: `combination[u]` - вершина дата-графа,
+         * сопоставленная точке `u`
+         */
+        std::vector<int> combination;
+        /**
+         * Статистика перебора этого состояния
+         */
+        SearchStatistics statistics;
+    };
+
+private:
+    /**
+     * Элемент паттерна не накладывает ограничений на элемент дата-графа
+     */
+    static const int NO_PLANE = -1;
+    /**
+     * Элемент дата-графа должен быть нулевым
+     */
+    static const int ZERO_PLANE = -2;
+    /**
+     * Наименьший размер паттерна, для которого перебор собирается отдельным ядром
+     */
+    static const int MIN_UNROLLED_SIZE = 3;
+    /**
+     * Наибольший размер паттерна, для которого перебор собирается отдельным ядром
+     */
+    static const int MAX_UNROLLED_SIZE = 8;
+
+    /**
+     * Ядро перебора для паттерна размера `P`
+     */
+    template<int P>
+    class Kernel;
+
+    /**
+     * Замер времени построения поиска; объявлен первым, чтобы учитывать и построение битовых плоскостей
+     */
+    SearchStatistics::Timer buildTimer;
+    /**
+     * Битовое представление дата-графа
+     */
+    BitGraph graph;
+    /**
+     * Размер стороны дата-графа
+     */
+    int sourceSize;
+    /**
+     * Размер стороны паттерна
+     */
+    int patternSize;
+    /**
+     * Кол-во 64-битных слов в битовой строке вершин дата-графа
+     */
+    int wordsCnt;
+    /**
+     * Ограничения на рёбра: элемент `[u * patternSize + w]` - номер битовой плоскости,
+     * которой должен принадлежать элемент дата-графа, соответствующий
+     * элементу паттерна `pattern[u][w]` (или `NO_PLANE`, `ZERO_PLANE`)
+     */
+    std::vector<int> planes;
+    /**
+     * Ограничения порядка: элемент `[u * patternSize + w]` равен `1`, если вершина точки `u`
+     * должна быть меньше вершины точки `w`, `-1` - если больше, и `0`, если ограничения нет;
+     * пустой, если ограничений порядка не задано
+     */
+    std::vector<int> symmetry;
+    /**
+     * Начальные домены точек паттерна
+     */
+    std::vector<uint64_t> domains;
+    /**
+     * Порядок сопоставления: `order[cnt]` - точка паттерна, выбираемая на глубине `cnt`
+     */
+    std::vector<int> order;
+    /**
+     * Флаг, начинается ли перебор с позиций ребра из индекса значений
+     */
+    bool seeded;
+    /**
+     * Флаг, можно ли перебирать паттерн ядром, собранным под его размер
+     */
+    bool specialized;
+    /**
+     * Позиции самого редкого значения ребра паттерна, совместимые с начальными доменами
+     * первых двух точек: пары вершин для `order[0]` и `order[1]` подряд
+     */
+    std::vector<int> seeds;
+    /**
+     * Статистика построения поиска: отсечения начальных доменов и время построения
+     */
+    SearchStatistics statistics;
+
+    /**
+     * Получить номер битовой плоскости, которой должен принадлежать элемент дата-графа,
+     * соответствующий элементу паттерна
+     *
+     * @param value     элемент паттерна
+     * @param hardCheck флаг, нужна ли жёсткая проверка
+     * @return номер битовой плоскости, `NO_PLANE` или `ZERO_PLANE`
+     */
+    int getConstraintPlane(int value, bool hardCheck) const;
+
+    /**
+     * Заполнить начальные домены точек паттерна
+     *
+     * @param source    дата-граф
+     * @param pattern   искомый паттерн
+     * @param hardCheck флаг, нужна ли жёсткая проверка
+     */
+    void initDomains(const Matrix &source, const Matrix &pattern, bool hardCheck);
+
+    /**
+     * Построить порядок сопоставления точек паттерна
+     *
+     * @param start точки, с которых порядок должен начинаться
+     */
+    void initOrder(const std::vector<int> &start = std::vector<int>());
+
+    /**
+     * Выбрать самое редкое значение ребра паттерна и запомнить его позиции
+     *
+     * @param pattern искомый паттерн
+     * @param index   индекс значений рёбер дата-графа
+     */
+    void initSeeds(const Matrix &pattern, const EdgeValueIndex &index);
+
+    /**
+     * Разложить начальные задачи параллельного перебора по очередям потоков
+     *
+     * @param pool        пул задач
+     * @param threadCount кол-во потоков
+     */
+    void pushRoots(TaskPool<std::vector<int>> &pool, int threadCount) const;
+
+    /**
+     * Записать статистику построения и перебора
+     *
+     * @param res              статистика, к которой добавляются счётчики
+     * @param searchStatistics статистика перебора
+     * @param timer            замер времени, начатый перед перебором
+     */
+    void collectStatistics(
+            SearchStatistics &res, const SearchStatistics &searchStatistics, const SearchStatistics::Timer &timer
+    ) const;
+
+    /**
+     * Получить домен точки паттерна на заданной глубине
+     *
+     * @param state состояние перебора
+     * @param cnt   глубина рекурсии
+     * @param u     точка паттерна
+     * @return битовая строка домена
+     */
+    const uint64_t *getDomain(const SearchState &state, int cnt, int u) const {
+        if (cnt == 0)
+            return domains.data() + (long long) u * wordsCnt;
+        return state.domains.data() + ((long long) (cnt - 1) * patternSize + u) * wordsCnt;
+    }
+
+    /**
+     * Прямая проверка: сузить домены ещё не выбранных точек паттерна после того,
+     * как точке паттерна на глубине `cnt` сопоставлена вершина дата-графа
+     *
+     * @param state  состояние перебора
+     * @param cnt    кол-во уже выбранных точек до текущей
+     * @param vertex вершина дата-графа, сопоставленная точке на глубине `cnt`
+     * @return флаг, остались ли все домены непустыми
+     */
+    bool forwardCheck(SearchState &state, int cnt, int vertex) const;
+
+    /**
+     * Получить префикс комбинации в порядке сопоставления для ветки перебора
+     *
+     * @param c      текущая комбинация в индексах паттерна
+     * @param cnt    кол-во уже выбранных точек
+     * @param vertex вершина дата-графа, сопоставляемая точке на глубине `cnt`
+     * @return вершины дата-графа, сопоставленные первым `cnt + 1` точкам
+     */
+    std::vector<int> getBranchPrefix(const int *c, int cnt, int vertex) const {
+        std::vector<int> prefix(cnt + 1);
+        for (int i = 0; i < cnt; i++)
+            prefix[i] = c[order[i]];
+        prefix[cnt] = vertex;
+        return prefix;
+    }
+
+    /**
+     * Шаг поиска паттерна общим перебором, для паттерна любого размера
+     *
+     * @param state    состояние перебора
+     * @param cnt      кол-во обработанных элементов
+     * @param consumer лямбда выражение (int *c)->bool; возвращает `false`, если поиск нужно остановить
+     * @param splitter лямбда выражение (const int *c, int cnt, int vertex)->bool, которое
+     *                 может забрать ветку с вершиной `vertex` на глубине `cnt` в отдельную задачу
+     * @return флаг, был ли перебор доведён до конца, а не остановлен обработчиком
+     */
+    template<typename F, typename S>
+    bool genericFindPatternStep(SearchState &state, int cnt, const F &consumer, const S &splitter) const;
+
+    /**
+     * Шаг подсчёта вхождений паттерна общим перебором, для паттерна любого размера
+     *
+     * @param state    состояние перебора
+     * @param cnt      кол-во обработанных элементов
+     * @param splitter лямбда выражение (const int *c, int cnt, int vertex)->bool, которое
+     *                 может забрать ветку с вершиной `vertex` на глубине `cnt` в отдельную задачу
+     * @return кол-во вхождений в поддереве перебора без забранных веток
+     */
+    template<typename S>
+    long long genericCountPatternStep(SearchState &state, int cnt, const S &splitter) const;
+
+    /**
+     * Передать шаг поиска ядру, собранному под размер паттерна `P`, или следующему размеру
+     *
+     * @tparam P       проверяемый размер паттерна
+     * @param state    состояние перебора
+     * @param cnt      кол-во обработанных элементов
+     * @param consumer лямбда выражение (int *c)->bool
+     * @param splitter лямбда выражение (const int *c, int cnt, int vertex)->bool
+     * @return флаг, был ли перебор доведён до конца, а не остановлен обработчиком
+     */
+    template<int P, typename F, typename S>
+    bool findPatternStep(SearchState &state, int cnt, const F &consumer, const S &splitter, std::false_type) const {
+        if (patternSize != P)
+            return findPatternStep<P + 1>(
+                    state, cnt, consumer, splitter, std::integral_constant<bool, (P + 1 > MAX_UNROLLED_SIZE)>()
+            );
+        return Kernel<P>(*this, state).find(cnt, consumer, splitter);
+    }
+
+    /**
+     * Передать шаг поиска общему перебору: размеры паттерна со специализированными ядрами кончились
+     *
+     * @param state    состояние перебора
+     * @param cnt      кол-во обработанных элементов
+     * @param consumer лямбда выражение (int *c)->bool
+     * @param splitter лямбда выражение (const int *c, int cnt, int vertex)->bool
+     * @return флаг, был ли перебор доведён до конца, а не остановлен обработчиком
+     */
+    template<int P, typename F, typename S>
+    bool findPatternStep(SearchState &state, int cnt, const F &consumer, const S &splitter, std::true_type) const {
+        return genericFindPatternStep(state, cnt, consumer, splitter);
+    }
+
+    /**
+     * Шаг поиска паттерна
+     *
+     * Паттерны размером от `MIN_UNROLLED_SIZE` до `MAX_UNROLLED_SIZE` перебираются ядром,
+     * собранным под их размер, остальные - общим перебором
+     *
+     * @param state    состояние перебора
+     * @param cnt      кол-во обработанных элементов
+     * @param consumer лямбда выражение (int *c)->bool; возвращает `false`, если поиск нужно остановить
+     * @param splitter лямбда выражение (const int *c, int cnt, int vertex)->bool, которое
+     *                 может забрать ветку с вершиной `vertex` на глубине `cnt` в отдельную задачу
+     * @return флаг, был ли перебор доведён до конца, а не остановлен обработчиком
+     */
+    template<typename F, typename S>
+    bool findPatternStep(SearchState &state, int cnt, const F &consumer, const S &splitter) const {
+        if (!specialized)
+            return genericFindPatternStep(state, cnt, consumer, splitter);
+        return findPatternStep<MIN_UNROLLED_SIZE>(state, cnt, consumer, splitter, std::false_type());
+    }
+
+    /**
+     * Передать шаг подсчёта ядру, собранному под размер паттерна `P`, или следующему размеру
+     *
+     * @tparam P       проверяемый размер паттерна
+     * @param state    состояние перебора
+     * @param cnt      кол-во обработанных элементов
+     * @param splitter лямбда выражение (const int *c, int cnt, int vertex)->bool
+     * @return кол-во вхождений в поддереве перебора без забранных веток
+     */
+    template<int P, typename S>
+    long long countPatternStep(SearchState &state, int cnt, const S &splitter, std::false_type) const {
+        if (patternSize != P)
+            return countPatternStep<P + 1>(
+                    state, cnt, splitter, std::integral_constant<bool, (P + 1 > MAX_UNROLLED_SIZE)>()
+            );
+        return Kernel<P>(*this, state).count(cnt, splitter);
+    }
+
+    /**
+     * Передать шаг подсчёта общему перебору
+     *
+     * @param state    состояние перебора
+     * @param cnt      кол-во обработанных элементов
+     * @param splitter лямбда выражение (const int *c, int cnt, int vertex)->bool
+     * @return кол-во вхождений в поддереве перебора без забранных веток
+     */
+    template<int P, typename S>
+    long long countPatternStep(SearchState &state, int cnt, const S &splitter, std::true_type) const {
+        return genericCountPatternStep(state, cnt, splitter);
+    }
+
+    /**
+     * Шаг подсчёта вхождений паттерна
+     *
+     * Ядро выбирается так же, как в `findPatternStep()`
+     *
+     * @param state    состояние перебора
+     * @param cnt      кол-во обработанных элементов
+     * @param splitter лямбда выражение (const int *c, int cnt, int vertex)->bool, которое
+     *                 может забрать ветку с вершиной `vertex` на глубине `cnt` в отдельную задачу
+     * @return кол-во вхождений в поддереве перебора без забранных веток
+     */
+    template<typename S>
+    long long countPatternStep(SearchState &state, int cnt, const S &splitter) const {
+        if (!specialized)
+            return genericCountPatternStep(state, cnt, splitter);
+        return countPatternStep<MIN_UNROLLED_SIZE>(state, cnt, splitter, std::false_type());
+    }
+
+    /**
+     * Перебрать все вхождения паттерна с начальных веток
+     *
+     * @param state    состояние перебора
+     * @param consumer обработчик найденной комбинации (int *c)->bool; возвращает `false`,
+     *                 если поиск нужно остановить
+     * @return флаг, был ли перебор доведён до конца, а не остановлен обработчиком
+     */
+    template<typename F>
+    bool runRoots(SearchState &state, const F &consumer) const {
+        // пустой паттерн входит в любой дата-граф ровно один раз
+        if (patternSize == 0) {
+            state.statistics.addMatches();
+            return consumer(state.combination.data());
+        }
+        if (!seeded)
+            return findPatternStep(state, 0, consumer, [](const int *, int, int) { return false; });
+
+        // перебираем ветки, начинающиеся с позиций самого редкого ребра
+        std::vector<int> prefix(2);
+        for (long long k = 0; k < (long long) seeds.size(); k += 2) {
+            prefix[0] = seeds[k];
+            prefix[1] = seeds[k + 1];
+            if (!runPrefix(state, prefix, consumer))
+                return false;
+        }
+        return true;
+    }
+
+    /**
+     * Посчитать все вхождения паттерна с начальных веток
+     *
+     * @param state состояние перебора
+     * @return кол-во вхождений паттерна
+     */
+    long long countRoots(SearchState &state) const;
+
+public:
+    /**
+     * Конструктор
+     *
+     * @param source          дата-граф
+     * @param pattern         искомый паттерн
+     * @param hardCheck       флаг, нужна ли жёсткая проверка
+     * @param lessConstraints ограничения порядка: для каждой пары `(a, b)` вершина, сопоставленная
+     *                        точке `a`, должна быть меньше вершины, сопоставленной точке `b`
+     */
+    FastPatternSearch(
+            const Matrix &source, const Matrix &pattern, bool hardCheck,
+            const std::vector<std::pair<int, int>> &lessConstraints = std::vector<std::pair<int, int>>()
+    );
+
+    /**
+     * Конструктор поиска, начинающегося с позиций самого редкого значения ребра паттерна
+     *
+     * Если у паттерна нет ненулевых недиагональных элементов, поиск работает как обычный
+     *
+     * @param source          дата-граф
+     * @param pattern         искомый паттерн
+     * @param hardCheck       флаг, нужна ли жёсткая проверка
+     * @param index           индекс значений рёбер дата-графа; нужен только на время конструктора
+     * @param lessConstraints ограничения порядка: для каждой пары `(a, b)` вершина, сопоставленная
+     *                        точке `a`, должна быть меньше вершины, сопоставленной точке `b`
+     */
+    FastPatternSearch(
+            const Matrix &source, const Matrix &pattern, bool hardCheck, const EdgeValueIndex &index,
+            const std::vector<std::pair<int, int>> &lessConstraints = std::vector<std::pair<int, int>>()
+    );
+
+    /**
+     * Проверить, начинается ли перебор с позиций ребра из индекса значений
+     * @return флаг, начинается ли перебор с позиций ребра
+     */
+    bool isSeeded() const {
+        return seeded;
+    }
+
+    /**
+     * Получить кол-во начальных пар вершин перебора с позиций ребра
+     * @return кол-во пар; `0`, если перебор начинается с вершин первой точки
+     */
+    long long getSeedsCount() const {
+        return (long long) seeds.size() / 2;
+    }
+
+    /**
+     * Получить размер стороны паттерна
+     * @return размер стороны паттерна
+     */
+    int getPatternSize() const {
+        return patternSize;
+    }
+
+    /**
+     * Включить или выключить перебор ядрами, собранными под размер паттерна; нужно для
+     * сверки ядер с общим перебором. Вызывается до начала перебора
+     *
+     * @param specialized флаг, можно ли использовать специализированные ядра
+     */
+    void setSpecialized(bool specialized) {
+        this->specialized = specialized;
+    }
+
+    /**
+     * Проверить, перебирается ли паттерн ядром, собранным под его размер
+     * @return флаг, используется ли специализированное ядро
+     */
+    bool isSpecialized() const {
+        return specialized && patternSize >= MIN_UNROLLED_SIZE && patternSize <= MAX_UNROLLED_SIZE;
+    }
+
+    /**
+     * Получить порядок сопоставления точек паттерна
+     * @return порядок сопоставления: точки паттерна по глубинам рекурсии
+     */
+    const std::vector<int> &getOrder() const {
+        return order;
+    }
+
+    /**
+     * Получить статистику построения поиска
+     * @return отсечения вершин из начальных доменов и время построения
+     */
+    const SearchStatistics &getBuildStatistics() const {
+        return statistics;
+    }
+
+    /**
+     * Создать пустое состояние перебора
+     * @return состояние перебора
+     */
+    SearchState createState() const;
+
+    /**
+     * Восстановить состояние перебора по префиксу комбинации
+     *
+     * @param state  состояние перебора
+     * @param prefix вершины дата-графа, сопоставленные первым точкам в порядке сопоставления
+     * @return флаг, совместим ли префикс с паттерном
+     */
+    bool restoreState(SearchState &state, const std::vector<int> &prefix) const;
+
+    /**
+     * Оценить стоимость перебора поддеревьев для каждой вершины из домена первой точки
+     *
+     * Оценка - произведение размеров доменов всех остальных точек после прямой проверки
+     * от этой вершины, то есть верхняя граница кол-ва листьев поддерева
+     *
+     * @return пары (вершина, оценка стоимости) в порядке возрастания вершин
+     */
+    std::vector<std::pair<int, double>> estimateRootCosts() const;
+
+    /**
+     * Получить вершины первой точки в порядке, в котором вхождение паттерна вероятнее
+     * найти быстрее
+     *
+     * Вершины, после прямой проверки от которых какой-то домен пуст, отбрасываются;
+     * остальные упорядочены по убыванию оценки стоимости поддерева: чем больше кандидатов
+     * осталось у следующих точек, тем меньше шанс, что ветка окажется тупиковой
+     *
+     * @return вершины первой точки
+     */
+    std::vector<int> getPromisingRoots() const;
+
+    /**
+     * Получить вершины первой точки, поддеревья которых относятся к заданной части перебора
+     *
+     * Поддеревья распределяются жадно: от самого дорогого к самому дешёвому, каждое в
+     * наименее загруженную часть. Распределение зависит только от дата-графа и паттерна,
+     * поэтому независимые процессы получают согласованные непересекающиеся части
+     *
+     * @param shardIndex номер части
+     * @param shardCount кол-во частей
+     * @return вершины первой точки в порядке возрастания
+     */
+    std::vector<int> getShardRoots(int shardIndex, int shardCount) const;
+
+    /**
+     * Продолжить поиск вхождений паттерна с заданного префикса комбинации
+     *
+     * @param prefix   вершины дата-графа, сопоставленные первым точкам в порядке сопоставления
+     * @param consumer обработчик найденной комбинации (int *c)->bool; возвращает `false`,
+     *                 если поиск нужно остановить
+     * @return флаг, был ли перебор доведён до конца, а не остановлен обработчиком
+     */
+    template<typename F>
+    bool runPrefix(const std::vector<int> &prefix, const F &consumer) const {
+        SearchState state = createState();
+        return runPrefix(state, prefix, consumer);
+    }
+
+    /**
+     * Продолжить поиск вхождений паттерна с заданного префикса комбинации, используя
+     * уже созданное состояние перебора; так при обходе многих префиксов подряд память
+     * под состояние выделяется один раз
+     *
+     * @param state    состояние перебора
+     * @param prefix   вершины дата-графа, сопоставленные первым точкам в порядке сопоставления
+     * @param consumer обработчик найденной комбинации (int *c)->bool; возвращает `false`,
+     *                 если поиск нужно остановить
+     * @return флаг, был ли перебор доведён до конца, а не остановлен обработчиком
+     */
+    template<typename F>
+    bool runPrefix(SearchState &state, const std::vector<int> &prefix, const F &consumer) const {
+        // если префикс не совместим с паттерном, вхождений нет
+        if (!restoreState(state, prefix))
+            return true;
+        if ((int) prefix.size() == patternSize) {
+            state.statistics.addMatches();
+            return consumer(state.combination.data());
+        }
+        return findPatternStep(
+                state, (int) prefix.size(), consumer, [](const int *, int, int) { return false; }
+        );
+    }
+
+    /**
+     * Запустить поиск всех вхождений паттерна
+     *
+     * @param consumer   обработчик найденной комбинации (int *c)->bool; возвращает `false`,
+     *                   если поиск нужно остановить
+     * @param statistics статистика, к которой добавляются счётчики построения и перебора;
+     *                   `nullptr`, если она не нужна
+     * @return флаг, был ли перебор доведён до конца, а не остановлен обработчиком
+     */
+    template<typename F>
+    bool run(const F &consumer, SearchStatistics *statistics = nullptr) const {
+        SearchStatistics::Timer timer;
+        SearchState state = createState();
+        bool res = runRoots(state, consumer);
+        if (statistics)
+            collectStatistics(*statistics, state.statistics, timer);
+        return res;
+    }
+
+    /**
+     * Посчитать все вхождения паттерна, не перебирая сами комбинации на последней глубине:
+     * домен последней точки уже совместим со всеми выбранными точками, поэтому кол-во
+     * вхождений в ветке равно кол-ву единичных битов в нём
+     *
+     * @param statistics статистика, к которой добавляются счётчики построения и перебора;
+     *                   `nullptr`, если она не нужна
+     * @return кол-во вхождений паттерна
+     */
+    long long count(SearchStatistics *statistics = nullptr) const;
+
+    /**
+     * Посчитать все вхождения паттерна в несколько потоков
+     *
+     * Работа делится между потоками так же, как в `runParallel()`
+     *
+     * @param threadCount кол-во потоков
+     * @param statistics  статистика, к которой добавляются счётчики построения и перебора
+     *                    всех потоков; `nullptr`, если она не нужна
+     * @return кол-во вхождений паттерна
+     */
+    long long countParallel(int threadCount, SearchStatistics *statistics = nullptr) const;
+
+    /**
+     * Запустить поиск всех вхождений паттерна в несколько потоков
+     *
+     * Каждая вершина из домена первой точки (или каждая позиция самого редкого ребра)
+     * становится отдельной задачей; если во время
+     * перебора какой-то поток простаивает, то ветки, которые ещё не начаты, отдаются в очередь
+     * задач, откуда их забирают свободные потоки. Каждый поток работает со своим состоянием
+     * перебора и передаёт комбинации обработчику вместе со своим номером
+     *
+     * Если обработчик попросил остановиться, новые ветки и задачи больше не начинаются;
+     * комбинации, которые другие потоки нашли одновременно с этим, ещё могут быть переданы
+     *
+     * @param threadCount кол-во потоков
+     * @param consumer    обработчик найденной комбинации (int worker, int *c)->bool; возвращает `false`,
+     *                    если поиск нужно остановить
+     * @param statistics  статистика, к которой добавляются счётчики построения и перебора
+     *                    всех потоков; `nullptr`, если она не нужна
+     * @return флаг, был ли перебор доведён до конца, а не остановлен обработчиком
+     */
+    template<typename F>
+    bool runParallel(int threadCount, const F &consumer, SearchStatistics *statistics = nullptr) const;
+};
+
+/**
+ * Ядро перебора для паттерна размера `P`
+ *
+ * Перебирает те же вершины в том же порядке, что и общий перебор, и меняет то же
+ * состояние, но размер паттерна известен при компиляции. Комбинация, точки по глубинам
+ * и ограничения между глубинами копируются из поиска в массивы фиксированного размера
+ * внутри ядра, а глубина - параметр шаблона: каждая глубина перебора - отдельная функция,
+ * цикл прямой проверки по оставшимся точкам имеет постоянные границы и разворачивается
+ * компилятором, а смещения доменов считаются с постоянным шагом `P`. Сами домены остаются
+ * в состоянии перебора: их длина зависит от размера дата-графа
+ *
+ * Ядро создаётся на каждый вызов шага перебора с уже восстановленным состоянием
+ */
+template<int P>
+class FastPatternSearch::Kernel {
+    /**
+     * Поиск
+     */
+    const FastPatternSearch &search;
+    /**
+     * Состояние перебора: домены и статистика
+     */
+    SearchState &state;
+    /**
+     * Кол-во 64-битных слов в битовой строке вершин дата-графа
+     */
+    int wordsCnt;
+    /**
+     * Точки паттерна по глубинам
+     */
+    int order[P];
+    /**
+     * Ограничения на рёбра из строки вершины: элемент `[cnt][next]` - номер битовой плоскости
+     * (или `NO_PLANE`, `ZERO_PLANE`) для пары точек на глубинах `cnt` и `next`
+     */
+    int outPlanes[P][P];
+    /**
+     * Ограничения на рёбра из столбца вершины, в тех же индексах, что и `outPlanes`
+     */
+    int inPlanes[P][P];
+    /**
+     * Ограничения порядка между точками на глубинах `cnt` и `next`, как в `symmetry`
+     */
+    int relations[P][P];
+    /**
+     * Текущая комбинация в индексах паттерна
+     */
+    int combination[P];
+
+    /**
+     * Получить домен точки паттерна на заданной глубине
+     *
+     * @tparam CNT глубина рекурсии
+     * @param u    точка паттерна
+     * @return битовая строка домена
+     */
+    template<int CNT>
+    const uint64_t *getDomain(int u) const {
+        if (CNT == 0)
+            return search.domains.data() + (long long) u * wordsCnt;
+        return state.domains.data() + ((long long) (CNT - 1) * P + u) * wordsCnt;
+    }
+
+    /**
+     * Прямая проверка, как у `FastPatternSearch::forwardCheck()`
+     *
+     * @tparam CNT  кол-во уже выбранных точек до текущей
+     * @param vertex вершина дата-графа, сопоставленная точке на глубине `CNT`
+     * @return флаг, остались ли все домены непустыми
+     */
+    template<int CNT>
+    bool forwardCheck(int vertex) {
+        for (int next = CNT + 1; next < P; next++) {
+            // ещё не выбранная точка паттерна
+            int w = order[next];
+            uint64_t *domain = state.domains.data() + ((long long) CNT * P + w) * wordsCnt;
+            const uint64_t *prev = getDomain<CNT>(w);
+            for (int k = 0; k < wordsCnt; k++)
+                domain[k] = prev[k];
+            // выбранная вершина уже занята
+            clearBit(domain, vertex);
+
+            // элемент дата-графа из строки выбранной вершины
+            int plane = outPlanes[CNT][next];
+            if (plane == ZERO_PLANE)
+                andNotWords(domain, search.graph.getNonZeroOut(vertex), wordsCnt);
+            else if (plane != NO_PLANE)
+                andWords(domain, search.graph.getValueOut(plane, vertex), wordsCnt);
+
+            // элемент дата-графа из столбца выбранной вершины
+            plane = inPlanes[CNT][next];
+            if (plane == ZERO_PLANE)
+                andNotWords(domain, search.graph.getNonZeroIn(vertex), wordsCnt);
+            else if (plane != NO_PLANE)
+                andWords(domain, search.graph.getValueIn(plane, vertex), wordsCnt);
+
+            // ограничение порядка между выбранной и ещё не выбранной точкой
+            if (relations[CNT][next] > 0)
+                clearBitsUpTo(domain, vertex);
+            else if (relations[CNT][next] < 0)
+                clearBitsFrom(domain, wordsCnt, vertex);
+
+            // если домен опустел, ветку можно отбросить
+            uint64_t any = 0;
+            for (int k = 0; k < wordsCnt; k++)
+                any |= domain[k];
+            if (!any)
+                return false;
+        }
+        return true;
+    }
+
+    /**
+     * Шаг поиска на глубине `CNT`, после которой есть ещё точки
+     *
+     * @tparam CNT     кол-во обработанных элементов
+     * @param consumer лямбда выражение (int *c)->bool
+     * @param splitter лямбда выражение (const int *c, int cnt, int vertex)->bool
+     * @return флаг, был ли перебор доведён до конца, а не остановлен обработчиком
+     */
+    template<int CNT, typename F, typename S>
+    bool findStep(const F &consumer, const S &splitter, std::false_type) {
+        int u = order[CNT];
+        return forEachBitWhile(getDomain<CNT>(u), wordsCnt, [this, &u, &consumer, &splitter](int vertex) {
+            // если ветку забрали в отдельную задачу, здесь её перебирать не нужно
+            if (splitter((const int *) combination, CNT, vertex))
+                return true;
+            combination[u] = vertex;
+            state.statistics.addNodes(CNT);
+            // если после сужения доменов ни один из них не опустел, переходим к следующей глубине
+            if (forwardCheck<CNT>(vertex))
+                return findStep<CNT + 1>(consumer, splitter, std::integral_constant<bool, CNT + 2 == P>());
+            state.statistics.addPrunes(SearchStatistics::EMPTY_DOMAIN);
+            return true;
+        });
+    }
+
+    /**
+     * Шаг поиска на последней глубине: каждый кандидат даёт комбинацию
+     *
+     * @tparam CNT     кол-во обработанных элементов, равное `P - 1`
+     * @param consumer лямбда выражение (int *c)->bool
+     * @param splitter лямбда выражение (const int *c, int cnt, int vertex)->bool
+     * @return флаг, был ли перебор доведён до конца, а не остановлен обработчиком
+     */
+    template<int CNT, typename F, typename S>
+    bool findStep(const F &consumer, const S &splitter, std::true_type) {
+        int u = order[CNT];
+        return forEachBitWhile(getDomain<CNT>(u), wordsCnt, [this, &u, &consumer, &splitter](int vertex) {
+            if (splitter((const int *) combination, CNT, vertex))
+                return true;
+            combination[u] = vertex;
+            state.statistics.addNodes(CNT);
+            state.statistics.addMatches();
+            return (bool) consumer((int *) combination);
+        });
+    }
+
+    /**
+     * Перейти от глубины, известной при запуске, к шагу поиска с глубиной-параметром шаблона
+     *
+     * @tparam CNT     проверяемая глубина
+     * @param cnt      кол-во обработанных элементов
+     * @param consumer лямбда выражение (int *c)->bool
+     * @param splitter лямбда выражение (const int *c, int cnt, int vertex)->bool
+     * @return флаг, был ли перебор доведён до конца, а не остановлен обработчиком
+     */
+    template<int CNT, typename F, typename S>
+    bool findFrom(int cnt, const F &consumer, const S &splitter, std::false_type) {
+        if (cnt != CNT)
+            return findFrom<CNT + 1>(cnt, consumer, splitter, std::integral_constant<bool, CNT + 1 == P>());
+        return findStep<CNT>(consumer, splitter, std::integral_constant<bool, CNT + 1 == P>());
+    }
+
+    /**
+     * Глубина не меньше размера паттерна: перебирать нечего
+     *
+     * @return `true`
+     */
+    template<int CNT, typename F, typename S>
+    bool findFrom(int, const F &, const S &, std::true_type) {
+        return true;
+    }
+
+    /**
+     * Шаг подсчёта на глубине `CNT`, после которой есть ещё точки
+     *
+     * @tparam CNT     кол-во обработанных элементов
+     * @param splitter лямбда выражение (const int *c, int cnt, int vertex)->bool
+     * @return кол-во вхождений в поддереве перебора без забранных веток
+     */
+    template<int CNT, typename S>
+    long long countStep(const S &splitter, std::false_type) {
+        int u = order[CNT];
+        long long res = 0;
+        forEachBit(getDomain<CNT>(u), wordsCnt, [this, &u, &splitter, &res](int vertex) {
+            // если ветку забрали в отдельную задачу, здесь её считать не нужно
+            if (splitter((const int *) combination, CNT, vertex))
+                return;
+            combination[u] = vertex;
+            state.statistics.addNodes(CNT);
+            // если после сужения доменов ни один из них не опустел, считаем вхождения в ветке
+            if (forwardCheck<CNT>(vertex))
+                res += countStep<CNT + 1>(splitter, std::integral_constant<bool, CNT + 2 == P>());
+            else
+                state.statistics.addPrunes(SearchStatistics::EMPTY_DOMAIN);
+        });
+        return res;
+    }
+
+    /**
+     * Шаг подсчёта на последней глубине: каждый кандидат из домена даёт ровно одно вхождение
+     *
+     * @tparam CNT кол-во обработанных элементов, равное `P - 1`
+     * @return кол-во вхождений
+     */
+    template<int CNT, typename S>
+    long long countStep(const S &, std::true_type) {
+        long long res = countBits(getDomain<CNT>(order[CNT]), wordsCnt);
+        state.statistics.addNodes(CNT, res);
+        state.statistics.addMatches(res);
+        return res;
+    }
+
+    /**
+     * Перейти от глубины, известной при запуске, к шагу подсчёта с глубиной-параметром шаблона
+     *
+     * @tparam CNT     проверяемая глубина
+     * @param cnt      кол-во обработанных элементов
+     * @param splitter лямбда выражение (const int *c, int cnt, int vertex)->bool
+     * @return кол-во вхождений в поддереве перебора без забранных веток
+     */
+    template<int CNT, typename S>
+    long long countFrom(int cnt, const S &splitter, std::false_type) {
+        if (cnt != CNT)
+            return countFrom<CNT + 1>(cnt, splitter, std::integral_constant<bool, CNT + 1 == P>());
+        return countStep<CNT>(splitter, std::integral_constant<bool, CNT + 1 == P>());
+    }
+
+    /**
+     * Глубина не меньше размера паттерна: считать нечего
+     *
+     * @return `0`
+     */
+    template<int CNT, typename S>
+    long long countFrom(int, const S &, std::true_type) {
+        return 0;
+    }
+
+public:
+    /**
+     * Конструктор
+     *
+     * @param search поиск; размер его паттерна должен быть равен `P`
+     * @param state  состояние перебора, восстановленное до глубины, с которой начнётся шаг
+     */
+    Kernel(const FastPatternSearch &search, SearchState &state) :
+            search(search), state(state), wordsCnt(search.wordsCnt) {
+        for (int cnt = 0; cnt < P; cnt++) {
+            order[cnt] = search.order[cnt];
+            combination[cnt] = state.combination[cnt];
+        }
+        for (int cnt = 0; cnt < P; cnt++)
+            for (int next = 0; next < P; next++) {
+                int u = order[cnt];
+                int w = order[next];
+                outPlanes[cnt][next] = search.planes[u * P + w];
+                inPlanes[cnt][next] = search.planes[w * P + u];
+                relations[cnt][next] = search.symmetry.empty() ? 0 : search.symmetry[u * P + w];
+            }
+    }
+
+    /**
+     * Шаг поиска паттерна, как `FastPatternSearch::findPatternStep()`
+     *
+     * @param cnt      кол-во обработанных элементов
+     * @param consumer лямбда выражение (int *c)->bool; возвращает `false`, если поиск нужно остановить
+     * @param splitter лямбда выражение (const int *c, int cnt, int vertex)->bool, которое
+     *                 может забрать ветку с вершиной `vertex` на глубине `cnt` в отдельную задачу
+     * @return флаг, был ли перебор доведён до конца, а не остановлен обработчиком
+     */
+    template<typename F, typename S>
+    bool find(int cnt, const F &consumer, const S &splitter) {
+        return findFrom<0>(cnt, consumer, splitter, std::false_type());
+    }
+
+    /**
+     * Шаг подсчёта вхождений паттерна, как `FastPatternSearch::countPatternStep()`
+     *
+     * @param cnt      кол-во обработанных элементов
+     * @param splitter лямбда выражение (const int *c, int cnt, int vertex)->bool, которое
+     *                 может забрать ветку с вершиной `vertex` на глубине `cnt` в отдельную задачу
+     * @return кол-во вхождений в поддереве перебора без забранных веток
+     */
+    template<typename S>
+    long long count(int cnt, const S &splitter) {
+        return countFrom<0>(cnt, splitter, std::false_type());
+    }
+};
+
+/**
+ * Шаг поиска паттерна общим перебором
+ *
+ * Кандидаты для точки паттерна на глубине `cnt` - это её домен на текущей глубине:
+ * все они уже совместимы с выбранными точками, поэтому для каждого остаётся только
+ * сузить домены следующих точек
+ *
+ * @param state    состояние перебора
+ * @param cnt      кол-во обработанных элементов
+ * @param consumer лямбда выражение (int *c)->bool; возвращает `false`, если поиск нужно остановить
+ * @param splitter лямбда выражение (const int *c, int cnt, int vertex)->bool, которое
+ *                 может забрать ветку с вершиной `vertex` на глубине `cnt` в отдельную задачу
+ * @return флаг, был ли перебор доведён до конца, а не остановлен обработчиком
+ */
+template<typename F, typename S>
+bool FastPatternSearch::genericFindPatternStep(SearchState &state, int cnt, const F &consumer, const S &splitter) const {
+    // точка паттерна, которой сопоставляется вершина на этой глубине
+    int u = order[cnt];
+    // перебираем кандидатов из домена текущей точки, пока обработчик не попросит остановиться
+    return forEachBitWhile(getDomain(state, cnt, u), wordsCnt, [this, &state, &cnt, &u, &consumer, &splitter](
+            int vertex
+    ) {
+        // если ветку забрали в отдельную задачу, здесь её перебирать не нужно
+        if (splitter((const int *) state.combination.data(), cnt, vertex))
+            return true;
+
+        // добавляем индекс точки в комбинацию
+        state.combination[u] = vertex;
+        state.statistics.addNodes(cnt);
+
+        // если получено нужное кол-во элементов комбинации
+        if (cnt == patternSize - 1) {
+            // обрабатываем её
+            state.statistics.addMatches();
+            return (bool) consumer(state.combination.data());
+        }
+        // иначе, если после сужения доменов ни один из них не опустел
+        if (forwardCheck(state, cnt, vertex))
+            // вызываем следующий шаг рекурсии
+            return genericFindPatternStep(state, cnt + 1, consumer, splitter);
+        state.statistics.addPrunes(SearchStatistics::EMPTY_DOMAIN);
+        return true;
+    });
+}
+
+/**
+ * Запустить поиск всех вхождений паттерна в несколько потоков
+ *
+ * @param threadCount кол-во потоков
+ * @param consumer    обработчик найденной комбинации (int worker, int *c)->bool; возвращает `false`,
+ *                    если поиск нужно остановить
+ * @param statistics  статистика, к которой добавляются счётчики построения и перебора
+ *                    всех потоков; `nullptr`, если она не нужна
+ * @return флаг, был ли перебор доведён до конца, а не остановлен обработчиком
+ */
+template<typename F>
+bool FastPatternSearch::runParallel(int threadCount, const F &consumer, SearchStatistics *statistics) const {
+    if (threadCount < 1)
+        throw std::invalid_argument(
+                "FastPatternSearch::runParallel() thread count is not acceptable: " + std::to_string(threadCount)
+        );
+
+    // пустой паттерн обрабатываем в текущем потоке
+    if (patternSize == 0)
+        return run([&consumer](int *c) { return consumer(0, c); }, statistics);
+
+    SearchStatistics::Timer timer;
+
+    // задача - префикс комбинации в порядке сопоставления
+    TaskPool<std::vector<int>> pool(threadCount);
+
+    // раскладываем начальные ветки по очередям потоков
+    pushRoots(pool, threadCount);
+
+    // состояния перебора потоков
+    std::vector<SearchState> states;
+    for (int i = 0; i < threadCount; i++)
+        states.push_back(createState());
+
+    // флаг, что обработчик попросил остановить поиск
+    std::atomic<bool> stopped(false);
+
+    pool.run([this, &pool, &states, &consumer, &stopped](int worker, std::vector<int> &prefix) {
+        // после остановки оставшиеся задачи только выбираются из очередей
+        if (stopped.load(std::memory_order_relaxed))
+            return;
+
+        SearchState &state = states[worker];
+        // восстанавливаем состояние по префиксу задачи
+        if (!restoreState(state, prefix))
+            return;
+
+        int cnt = (int) prefix.size();
+        // если префикс уже является полной комбинацией
+        if (cnt == patternSize) {
+            state.statistics.addMatches();
+            if (!consumer(worker, state.combination.data()))
+                stopped = true;
+            return;
+        }
+
+        findPatternStep(
+                state, cnt,
+                [&worker, &consumer, &stopped](int *c) {
+                    if (!consumer(worker, c))
+                        stopped = true;
+                    return !stopped.load(std::memory_order_relaxed);
+                },
+                [this, &pool, &worker, &stopped](const int *c, int cnt, int vertex) {
+                    // после остановки все ещё не начатые ветки пропускаются
+                    if (stopped.load(std::memory_order_relaxed))
+                        return true;
+                    // отдаём ветку другим потокам, только если они простаивают и под ней
+                    // есть хотя бы два уровня перебора
+                    if (cnt + 2 >= patternSize || !pool.isHungry())
+                        return false;
+                    pool.push(worker, getBranchPrefix(c, cnt, vertex));
+                    return true;
+                }
+        );
+    });
+
+    // объединяем статистику потоков
+    if (statistics) {
+        SearchStatistics searchStatistics;
+        for (const SearchState &state: states)
+            searchStatistics.merge(state.statistics);
+        collectStatistics(*statistics, searchStatistics, timer);
+    }
+
+    return !stopped.load();
+}
+
+/**
+ * Шаг подсчёта вхождений паттерна общим перебором
+ *
+ * @param state    состояние перебора
+ * @param cnt      кол-во обработанных элементов
+ * @param splitter лямбда выражение (const int *c, int cnt, int vertex)->bool, которое
+ *                 может забрать ветку с вершиной `vertex` на глубине `cnt` в отдельную задачу
+ * @return кол-во вхождений в поддереве перебора без забранных веток
+ */
+template<typename S>
+long long FastPatternSearch::genericCountPatternStep(SearchState &state, int cnt, const S &splitter) const {
+    // точка паттерна, которой сопоставляется вершина на этой глубине
+    int u = order[cnt];
+    const uint64_t *domain = getDomain(state, cnt, u);
+
+    // на последней глубине каждый кандидат из домена даёт ровно одно вхождение
+    if (cnt == patternSize - 1) {
+        long long res = countBits(domain, wordsCnt);
+        state.statistics.addNodes(cnt, res);
+        state.statistics.addMatches(res);
+        return res;
+    }
+
+    long long res = 0;
+    forEachBit(domain, wordsCnt, [this, &state, &cnt, &u, &splitter, &res](int vertex) {
+        // если ветку забрали в отдельную задачу, здесь её считать не нужно
+        if (splitter((const int *) state.combination.data(), cnt, vertex))
+            return;
+        state.combination[u] = vertex;
+        state.statistics.addNodes(cnt);
+        // если после сужения доменов ни один из них не опустел, считаем вхождения в ветке
+        if (forwardCheck(state, cnt, vertex))
+            res += genericCountPatternStep(state, cnt + 1, splitter);
+        else
+            state.statistics.addPrunes(SearchStatistics::EMPTY_DOMAIN);
+    });
+    return res;
+}
@@ -0,0 +1,399 @@
+#pragma once
+
+#include <vector>
+#include "misc/CombinatoricsData.h"
+#include "misc/DynamicGraph.h"
+#include "misc/IntSpan.h"
+#include "misc/Matrix.h"
+
+/**
+ * Отслеживание вхождений паттернов в изменяющемся дата-графе
+ *
+ * Паттерны регистрируются один раз, после чего каждое изменение элемента матрицы
+ * связности (добавление, удаление или изменение значения ребра, изменение петли)
+ * сообщает только появившиеся и исчезнувшие вхождения. Вхождение затрагивает
+ * изменённый элемент `(a, b)`, только если какие-то точки паттерна `u` и `w`
+ * сопоставлены вершинам `a` и `b`, причём из-за инъективности комбинации такая пара
+ * точек ровно одна. Поэтому для каждой пары точек, элемент паттерна между которыми
+ * равен новому (или прежнему) значению, ищутся вхождения с закреплёнными
+ * `c[u] = a` и `c[w] = b` - перебор идёт только по окрестности изменённого ребра,
+ * а не по всему графу
+ *
+ * Порядок сопоставления для каждой пары точек строится заранее при регистрации паттерна
+ */
+class IncrementalPatternMatcher {
+public:
+    /**
+     * Изменение множества вхождений паттерна
+     */
+    struct MatchDelta {
+        /**
+         * Номер паттерна
+         */
+        int patternId;
+        /**
+         * Флаг, появилось ли вхождение (`false` - исчезло)
+         */
+        bool gained;
+        /**
+         * Комбинация вхождения
+         */
+        CombinatoricsData combination;
+
+        /**
+         * Конструктор
+         *
+         * @param patternId номер паттерна
+         * @param gained    флаг, появилось ли вхождение
+         * @param c         комбинация вхождения
+         * @param sz        размер комбинации
+         */
+        MatchDelta(int patternId, bool gained, const int *c, int sz) :
+                patternId(patternId), gained(gained), combination(c, sz) {
+        }
+    };
+
+private:
+    /**
+     * Проверка рёбер между точкой на текущей глубине и точкой, выбранной раньше
+     */
+    struct Check {
+        /**
+         * Глубина, на которой выбрана точка
+         */
+        int depth;
+        /**
+         * Флаг, ограничено ли ребро из новой вершины в выбранную
+         */
+        bool hasToPrefix;
+        /**
+         * Требуемое значение ребра из новой вершины в выбранную (`0` - ребра быть не должно)
+         */
+        int toPrefix;
+        /**
+         * Флаг, ограничено ли ребро из выбранной вершины в новую
+         */
+        bool hasFromPrefix;
+        /**
+         * Требуемое значение ребра из выбранной вершины в новую (`0` - ребра быть не должно)
+         */
+        int fromPrefix;
+    };
+
+    /**
+     * План перебора вхождений, в которых изменённому элементу сопоставлена заданная пара точек
+     */
+    struct AnchorPlan {
+        /**
+         * Точка паттерна, сопоставленная строке изменённого элемента
+         */
+        int from;
+        /**
+         * Точка паттерна, сопоставленная столбцу изменённого элемента (для петли равна `from`)
+         */
+        int to;
+        /**
+         * Значение, которое должен иметь изменённый элемент
+         */
+        int required;
+        /**
+         * Порядок сопоставления: первыми идут закреплённые точки
+         */
+        std::vector<int> order;
+        /**
+         * Проверки рёбер с уже выбранными точками для каждой глубины
+         */
+        std::vector<std::vector<Check>> checks;
+    };
+
+    /**
+     * Зарегистрированный паттерн
+     */
+    struct Registration {
+        /**
+         * Размер стороны паттерна
+         */
+        int patternSize;
+        /**
+         * Флаги ограничений петель точек паттерна
+         */
+        std::vector<char> loopConstrained;
+        /**
+         * Требуемые значения петель точек паттерна
+         */
+        std::vector<int> loops;
+        /**
+         * Планы перебора для всех ограниченных элементов паттерна
+         */
+        std::vector<AnchorPlan> plans;
+    };
+
+    /**
+     * Дата-граф
+     */
+    DynamicGraph graph;
+    /**
+     * Зарегистрированные паттерны
+     */
+    std::vector<Registration> registrations;
+
+    /**
+     * Построить план перебора для пары точек паттерна
+     *
+     * @param constrained флаги ограничений на рёбра паттерна: элемент `[u * patternSize + w]`
+     * @param values      требуемые значения рёбер в том же порядке
+     * @param patternSize размер стороны паттерна
+     * @param from        точка, сопоставленная строке изменённого элемента
+     * @param to          точка, сопоставленная столбцу изменённого элемента
+     * @param required    значение, которое должен иметь изменённый элемент
+     * @return план перебора
+     */
+    static AnchorPlan createPlan(
+            const std::vector<char> &constrained, const std::vector<int> &values, int patternSize,
+            int from, int to, int required
+    );
+
+    /**
+     * Проверить, можно ли сопоставить вершину точке паттерна на заданной глубине
+     *
+     * @param registration паттерн
+     * @param plan         план перебора
+     * @param combination  текущая комбинация в индексах паттерна
+     * @param cnt          глубина
+     * @param vertex       вершина дата-графа
+     * @return флаг, совместима ли вершина со всеми выбранными точками
+     */
+    bool fits(
+            const Registration &registration, const AnchorPlan &plan, const std::vector<int> &combination,
+            int cnt, int vertex
+    ) const;
+
+    /**
+     * Шаг поиска вхождений с закреплёнными первыми точками
+     *
+     * @param registration паттерн
+     * @param plan         план перебора
+     * @param combination  текущая комбинация в индексах паттерна
+     * @param cnt          кол-во обработанных элементов
+     * @param consumer     лямбда выражение (int *c)->{}
+     */
+    template<typename F>
+    void findPatternStep(
+            const Registration &registration, const AnchorPlan &plan, std::vector<int> &combination, int cnt,
+            const F &consumer
+    ) const;
+
+    /**
+     * Перебрать вхождения, в которых изменённому элементу `(a, b)` сопоставлена пара точек плана
+     *
+     * @param registration паттерн
+     * @param plan         план перебора
+     * @param a            строка изменённого элемента
+     * @param b            столбец изменённого элемента
+     * @param consumer     лямбда выражение (int *c)->{}
+     */
+    template<typename F>
+    void runAnchored(const Registration &registration, const AnchorPlan &plan, int a, int b, const F &consumer) const;
+
+public:
+    /**
+     * Конструктор
+     *
+     * @param graph исходное состояние дата-графа
+     */
+    explicit IncrementalPatternMatcher(DynamicGraph graph);
+
+    /**
+     * Получить текущее состояние дата-графа
+     * @return дата-граф
+     */
+    const DynamicGraph &getGraph() const {
+        return graph;
+    }
+
+    /**
+     * Зарегистрировать паттерн
+     *
+     * @param pattern   паттерн
+     * @param hardCheck флаг, нужна ли жёсткая проверка
+     * @return номер паттерна, с которым сообщаются изменения его вхождений
+     */
+    int addPattern(const Matrix &pattern, bool hardCheck);
+
+    /**
+     * Задать значение элемента матрицы связности и сообщить об изменениях вхождений
+     * всех зарегистрированных паттернов
+     *
+     * Сначала сообщаются исчезнувшие вхождения (они ищутся в графе до изменения),
+     * затем появившиеся
+     *
+     * @param from    номер строки
+     * @param to      номер столбца
+     * @param value   новое значение; `0` - удалить ребро
+     * @param visitor обработчик изменения (int patternId, bool gained, IntSpan c)->{}
+     * @return кол-во изменений
+     */
+    template<typename V>
+    long long setEdge(int from, int to, int value, const V &visitor);
+
+    /**
+     * Задать значение элемента матрицы связности
+     *
+     * @param from  номер строки
+     * @param to    номер столбца
+     * @param value новое значение; `0` - удалить ребро
+     * @return изменения вхождений всех зарегистрированных паттернов
+     */
+    std::vector<MatchDelta> setEdge(int from, int to, int value);
+
+    /**
+     * Удалить ребро
+     *
+     * @param from номер строки
+     * @param to   номер столбца
+     * @return изменения вхождений всех зарегистрированных паттернов
+     */
+    std::vector<MatchDelta> removeEdge(int from, int to) {
+        return setEdge(from, to, 0);
+    }
+};
+
+/**
+ * Шаг поиска вхождений с закреплёнными первыми точками
+ *
+ * @param registration паттерн
+ * @param plan         план перебора
+ * @param combination  текущая комбинация в индексах паттерна
+ * @param cnt          кол-во обработанных элементов
+ * @param consumer     лямбда выражение (int *c)->{}
+ */
+template<typename F>
+void IncrementalPatternMatcher::findPatternStep(
+        const Registration &registration, const AnchorPlan &plan, std::vector<int> &combination, int cnt,
+        const F &consumer
+) const {
+    // если получено нужное кол-во элементов комбинации
+    if (cnt == registration.patternSize) {
+        consumer(combination.data());
+        return;
+    }
+
+    // точка паттерна, которой сопоставляется вершина на этой глубине
+    int u = plan.order[cnt];
+
+    // обработка одного кандидата
+    auto step = [this, &registration, &plan, &combination, &cnt, &u, &consumer](int vertex) {
+        if (!fits(registration, plan, combination, cnt, vertex))
+            return;
+        combination[u] = vertex;
+        findPatternStep(registration, plan, combination, cnt + 1, consumer);
+    };
+
+    // ищем самый короткий список соседей среди выбранных точек, связанных с текущей
+    const int *neighbours = nullptr;
+    const int *neighbourValues = nullptr;
+    int neighboursCnt = 0;
+    int required = 0;
+    for (const Check &check: plan.checks[cnt]) {
+        int prefixVertex = combination[plan.order[check.depth]];
+        if (check.hasFromPrefix && check.fromPrefix != 0 &&
+            (!neighbours || graph.getOutDegree(prefixVertex) < neighboursCnt)) {
+            neighbours = graph.getOutTargets(prefixVertex);
+            neighbourValues = graph.getOutValues(prefixVertex);
+            neighboursCnt = graph.getOutDegree(prefixVertex);
+            required = check.fromPrefix;
+        }
+        if (check.hasToPrefix && check.toPrefix != 0 &&
+            (!neighbours || graph.getInDegree(prefixVertex) < neighboursCnt)) {
+            neighbours = graph.getInSources(prefixVertex);
+            neighbourValues = graph.getInValues(prefixVertex);
+            neighboursCnt = graph.getInDegree(prefixVertex);
+            required = check.toPrefix;
+        }
+    }
+
+    // если точка не связана с выбранными, перебираем все вершины
+    if (!neighbours) {
+        for (int vertex = 0; vertex < graph.getSize(); vertex++)
+            step(vertex);
+        return;
+    }
+
+    for (int k = 0; k < neighboursCnt; k++)
+        if (neighbourValues[k] == required)
+            step(neighbours[k]);
+}
+
+/**
+ * Перебрать вхождения, в которых изменённому элементу `(a, b)` сопоставлена пара точек плана
+ *
+ * @param registration паттерн
+ * @param plan         план перебора
+ * @param a            строка изменённого элемента
+ * @param b            столбец изменённого элемента
+ * @param consumer     лямбда выражение (int *c)->{}
+ */
+template<typename F>
+void IncrementalPatternMatcher::runAnchored(
+        const Registration &registration, const AnchorPlan &plan, int a, int b, const F &consumer
+) const {
+    std::vector<int> combination(registration.patternSize, 0);
+    // закрепляем первую точку
+    if (!fits(registration, plan, combination, 0, a))
+        return;
+    combination[plan.from] = a;
+    // для петли закреплена одна точка, иначе закрепляем и вторую
+    if (plan.from == plan.to) {
+        findPatternStep(registration, plan, combination, 1, consumer);
+        return;
+    }
+    if (!fits(registration, plan, combination, 1, b))
+        return;
+    combination[plan.to] = b;
+    findPatternStep(registration, plan, combination, 2, consumer);
+}
+
+/**
+ * Задать значение элемента матрицы связности и сообщить об изменениях вхождений
+ * всех зарегистрированных паттернов
+ *
+ * @param from    номер строки
+ * @param to      номер столбца
+ * @param value   новое значение; `0` - удалить ребро
+ * @param visitor обработчик изменения (int patternId, bool gained, IntSpan c)->{}
+ * @return кол-во изменений
+ */
+template<typename V>
+long long IncrementalPatternMatcher::setEdge(int from, int to, int value, const V &visitor) {
+    if (from < 0 || from >= graph.getSize() || to < 0 || to >= graph.getSize())
+        throw std::invalid_argument(
+                "IncrementalPatternMatcher::setEdge() edge is out of range: " +
+                std::to_string(from) + " " + std::to_string(to)
+        );
+
+    int prev = graph.get(from, to);
+    if (prev == value)
+        return 0;
+
+    long long res = 0;
+    bool loop = from == to;
+
+    // вхождения, которым был нужен прежний элемент, ищем в графе до изменения,
+    // а вхождения, которым нужен новый, - после: значения различны, поэтому
+    // каждая пара точек даёт изменения только одного вида
+    for (int gained = 0; gained < 2; gained++) {
+        if (gained)
+            graph.set(from, to, value);
+        int required = gained ? value : prev;
+        for (int id = 0; id < (int) registrations.size(); id++) {
+            const Registration &registration = registrations[id];
+            for (const AnchorPlan &plan: registration.plans)
+                if ((plan.from == plan.to) == loop && plan.required == required)
+                    runAnchored(registration, plan, from, to, [&visitor, &res, &id, &gained, &registration](int *c) {
+                        visitor(id, gained != 0, IntSpan(c, registration.patternSize));
+                        res++;
+                    });
+        }
+    }
+    return res;
+}
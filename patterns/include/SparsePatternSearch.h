@@ -0,0 +1,247 @@
+#pragma once
+
+#include <vector>
+#include "misc/CsrGraph.h"
+#include "misc/Matrix.h"
+#include "misc/bits.h"
+
+/**
+ * Поиск паттерна в разреженном дата-графе
+ *
+ * Как и `FastPatternSearch`, сопоставляет точки паттерна в порядке, при котором
+ * каждая следующая точка по возможности связана ненулевым ребром с уже выбранными.
+ * Кандидаты для такой точки берутся не из всех вершин дата-графа, а из списка соседей
+ * уже выбранной вершины - того из связанных с точкой, у которого этот список короче.
+ * Остальные ограничения на рёбра проверяются двоичным поиском по спискам рёбер.
+ * Все вершины перебираются только для точек, не связанных ненулевыми рёбрами с
+ * выбранными: для первой точки и для точек другой компоненты связности паттерна
+ *
+ * Перед поиском для каждой точки паттерна строится битовая строка допустимых вершин:
+ * у них совпадает петля и хватает рёбер каждого вида, как в `FastPatternSearch`
+ *
+ * Найденные комбинации совпадают с комбинациями `fastGetAllPatterns` для той же
+ * плотной матрицы, но могут идти в другом порядке
+ */
+class SparsePatternSearch {
+    /**
+     * Проверка рёбер между точкой на текущей глубине и точкой, выбранной раньше
+     */
+    struct Check {
+        /**
+         * Глубина, на которой выбрана точка
+         */
+        int depth;
+        /**
+         * Флаг, ограничено ли ребро из новой вершины в выбранную
+         */
+        bool hasToPrefix;
+        /**
+         * Требуемое значение ребра из новой вершины в выбранную (`0` - ребра быть не должно)
+         */
+        int toPrefix;
+        /**
+         * Флаг, ограничено ли ребро из выбранной вершины в новую
+         */
+        bool hasFromPrefix;
+        /**
+         * Требуемое значение ребра из выбранной вершины в новую (`0` - ребра быть не должно)
+         */
+        int fromPrefix;
+    };
+
+    /**
+     * Дата-граф; должен существовать, пока существует объект поиска
+     */
+    const CsrGraph &graph;
+    /**
+     * Кол-во вершин дата-графа
+     */
+    int sourceSize;
+    /**
+     * Размер стороны паттерна
+     */
+    int patternSize;
+    /**
+     * Кол-во 64-битных слов в битовой строке вершин дата-графа
+     */
+    int wordsCnt;
+    /**
+     * Флаги ограничений на рёбра: элемент `[u * patternSize + w]` равен `1`, если элемент
+     * дата-графа, соответствующий элементу паттерна `pattern[u][w]`, должен быть равен ему
+     * (при нежёсткой проверке нулевые элементы паттерна ничего не ограничивают)
+     */
+    std::vector<char> constrained;
+    /**
+     * Элементы паттерна
+     */
+    std::vector<int> values;
+    /**
+     * Допустимые вершины точек паттерна: по битовой строке на каждую точку
+     */
+    std::vector<uint64_t> candidates;
+    /**
+     * Порядок сопоставления: `order[cnt]` - точка паттерна, выбираемая на глубине `cnt`
+     */
+    std::vector<int> order;
+    /**
+     * Проверки рёбер с уже выбранными точками для каждой глубины
+     */
+    std::vector<std::vector<Check>> checks;
+
+    /**
+     * Заполнить допустимые вершины точек паттерна
+     *
+     * @param pattern   искомый паттерн
+     * @param hardCheck флаг, нужна ли жёсткая проверка
+     */
+    void initCandidates(const Matrix &pattern, bool hardCheck);
+
+    /**
+     * Построить порядок сопоставления точек паттерна и проверки рёбер для каждой глубины
+     */
+    void initOrder();
+
+    /**
+     * Проверить, должен ли элемент дата-графа, соответствующий элементу паттерна,
+     * быть ненулевым
+     *
+     * @param u строка паттерна
+     * @param w столбец паттерна
+     * @return флаг, соответствует ли элементу паттерна ненулевое ребро
+     */
+    bool isLink(int u, int w) const {
+        return constrained[u * patternSize + w] && values[u * patternSize + w] != 0;
+    }
+
+    /**
+     * Проверить, можно ли сопоставить вершину точке паттерна на заданной глубине
+     *
+     * @param combination текущая комбинация в индексах паттерна
+     * @param cnt         глубина
+     * @param vertex      вершина дата-графа
+     * @return флаг, совместима ли вершина со всеми выбранными точками
+     */
+    bool fits(const std::vector<int> &combination, int cnt, int vertex) const;
+
+    /**
+     * Шаг поиска паттерна
+     *
+     * @param combination текущая комбинация в индексах паттерна
+     * @param cnt         кол-во обработанных элементов
+     * @param consumer    лямбда выражение (int *c)->bool; возвращает `false`, если поиск нужно остановить
+     * @return флаг, был ли перебор доведён до конца, а не остановлен обработчиком
+     */
+    template<typename F>
+    bool findPatternStep(std::vector<int> &combination, int cnt, const F &consumer) const;
+
+public:
+    /**
+     * Конструктор
+     *
+     * @param source    дата-граф; должен существовать, пока существует объект поиска
+     * @param pattern   искомый паттерн
+     * @param hardCheck флаг, нужна ли жёсткая проверка
+     */
+    SparsePatternSearch(const CsrGraph &source, const Matrix &pattern, bool hardCheck);
+
+    /**
+     * Получить размер стороны паттерна
+     * @return размер стороны паттерна
+     */
+    int getPatternSize() const {
+        return patternSize;
+    }
+
+    /**
+     * Получить порядок сопоставления точек паттерна
+     * @return порядок сопоставления: точки паттерна по глубинам рекурсии
+     */
+    const std::vector<int> &getOrder() const {
+        return order;
+    }
+
+    /**
+     * Запустить поиск всех вхождений паттерна
+     *
+     * @param consumer обработчик найденной комбинации (int *c)->bool; возвращает `false`,
+     *                 если поиск нужно остановить
+     * @return флаг, был ли перебор доведён до конца, а не остановлен обработчиком
+     */
+    template<typename F>
+    bool run(const F &consumer) const {
+        std::vector<int> combination(patternSize, 0);
+        // пустой паттерн входит в любой дата-граф ровно один раз
+        if (patternSize == 0)
+            return consumer(combination.data());
+        return findPatternStep(combination, 0, consumer);
+    }
+};
+
+/**
+ * Шаг поиска паттерна
+ *
+ * Если точка на этой глубине связана ненулевым ребром с выбранной точкой, кандидаты
+ * берутся из самого короткого из соответствующих списков соседей, иначе - из её
+ * допустимых вершин
+ *
+ * @param combination текущая комбинация в индексах паттерна
+ * @param cnt         кол-во обработанных элементов
+ * @param consumer    лямбда выражение (int *c)->bool; возвращает `false`, если поиск нужно остановить
+ * @return флаг, был ли перебор доведён до конца, а не остановлен обработчиком
+ */
+template<typename F>
+bool SparsePatternSearch::findPatternStep(std::vector<int> &combination, int cnt, const F &consumer) const {
+    // точка паттерна, которой сопоставляется вершина на этой глубине
+    int u = order[cnt];
+
+    // обработка одного кандидата
+    auto step = [this, &combination, &cnt, &u, &consumer](int vertex) {
+        if (!fits(combination, cnt, vertex))
+            return true;
+        // добавляем индекс точки в комбинацию
+        combination[u] = vertex;
+        // если получено нужное кол-во элементов комбинации, обрабатываем её,
+        // иначе вызываем следующий шаг рекурсии
+        if (cnt == patternSize - 1)
+            return (bool) consumer(combination.data());
+        return findPatternStep(combination, cnt + 1, consumer);
+    };
+
+    // ищем самый короткий список соседей среди выбранных точек, связанных с текущей
+    const int *neighbours = nullptr;
+    const int *neighbourValues = nullptr;
+    int neighboursCnt = 0;
+    int required = 0;
+    for (const Check &check: checks[cnt]) {
+        int prefixVertex = combination[order[check.depth]];
+        if (check.hasFromPrefix && check.fromPrefix != 0) {
+            // ребро из выбранной вершины в новую: кандидаты - её исходящие соседи
+            int degree = graph.getOutDegree(prefixVertex);
+            if (!neighbours || degree < neighboursCnt) {
+                neighbours = graph.getOutTargets(prefixVertex);
+                neighbourValues = graph.getOutValues(prefixVertex);
+                neighboursCnt = degree;
+                required = check.fromPrefix;
+            }
+        }
+        if (check.hasToPrefix && check.toPrefix != 0) {
+            // ребро из новой вершины в выбранную: кандидаты - её входящие соседи
+            int degree = graph.getInDegree(prefixVertex);
+            if (!neighbours || degree < neighboursCnt) {
+                neighbours = graph.getInSources(prefixVertex);
+                neighbourValues = graph.getInValues(prefixVertex);
+                neighboursCnt = degree;
+                required = check.toPrefix;
+            }
+        }
+    }
+
+    // если точка не связана с выбранными, перебираем все её допустимые вершины
+    if (!neighbours)
+        return forEachBitWhile(candidates.data() + (long long) u * wordsCnt, wordsCnt, step);
+
+    for (int k = 0; k < neighboursCnt; k++)
+        if (neighbourValues[k] == required && !step(neighbours[k]))
+            return false;
+    return true;
+}
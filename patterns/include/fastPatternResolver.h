@@ -2,7 +2,13 @@
 
 
 #include "misc/CombinatoricsData.h"
+#include "misc/IntSpan.h"
+#include "misc/MatchSet.h"
+#include "misc/MatchWriter.h"
 #include "patternResolver.h"
+#include "patternSymmetry.h"
+#include "FastPatternSearch.h"
+#include "BatchPatternSearch.h"
 #include <vector>
 
 /**
@@ -21,4 +27,355 @@
  * были изоморфны заданному паттерну
  */
 std::vector<CombinatoricsData>
-fastGetAllPatterns(int **source, int sourceSize, int **pattern, int patternSize, bool hardCheck);
\ No newline at end of file
+fastGetAllPatterns(int **source, int sourceSize, int **pattern, int patternSize, bool hardCheck);
+
+/**
+ * Быстрый поиск изоморфных подграфов
+ *
+ * @param source    дата-граф
+ * @param pattern   искомый паттерн
+ * @param hardCheck флаг, нужна ли жёсткая проверка; если `hardCheck` равен `false`, то нулевому элементу паттерна
+ *                  может соответствовать произвольное значение в переставленной подматрице, а если
+ *                  `true`, то все элементы паттерна и переставленной подматрицы должны
+ *                  совпадать с точностью до перестановки.
+ * @return список таких комбинаций точек из источника, чтобы при составлении
+ * соответствующих переставленных подматриц, подграфы, построенные по ним,
+ * были изоморфны заданному паттерну
+ */
+std::vector<CombinatoricsData>
+fastGetAllPatterns(const Matrix &source, const Matrix &pattern, bool hardCheck);
+
+/**
+ * Быстрый поиск изоморфных подграфов с записью комбинаций в множество
+ *
+ * Комбинации записываются подряд в один буфер множества, поэтому на каждое
+ * вхождение не выделяется отдельная память
+ *
+ * @param source    дата-граф
+ * @param pattern   искомый паттерн
+ * @param hardCheck флаг, нужна ли жёсткая проверка
+ * @param res       множество, в конец которого добавляются найденные комбинации
+ *                  в порядке `fastGetAllPatterns`; размер его комбинаций должен совпадать с размером паттерна
+ */
+void fastGetAllPatterns(const Matrix &source, const Matrix &pattern, bool hardCheck, MatchSet &res);
+
+/**
+ * Быстрый поиск изоморфных подграфов с записью комбинаций в множество и сбором статистики перебора
+ *
+ * Статистика ведётся, только если библиотека собрана с опцией `PATTERNS_SEARCH_STATISTICS`
+ *
+ * @param source     дата-граф
+ * @param pattern    искомый паттерн
+ * @param hardCheck  флаг, нужна ли жёсткая проверка
+ * @param res        множество, в конец которого добавляются найденные комбинации
+ *                   в порядке `fastGetAllPatterns`; размер его комбинаций должен совпадать с размером паттерна
+ * @param statistics статистика, к которой добавляются счётчики построения и перебора
+ */
+void fastGetAllPatterns(
+        const Matrix &source, const Matrix &pattern, bool hardCheck, MatchSet &res, SearchStatistics &statistics
+);
+
+/**
+ * Быстрый поиск изоморфных подграфов в несколько потоков
+ *
+ * Перебор делится на задачи по вершинам, сопоставленным первым точкам паттерна;
+ * простаивающие потоки забирают ещё не начатые ветки у занятых
+ *
+ * @param source        дата-граф
+ * @param pattern       искомый паттерн
+ * @param hardCheck     флаг, нужна ли жёсткая проверка
+ * @param threadCount   кол-во потоков
+ * @param deterministic флаг, нужно ли возвращать комбинации в том же порядке, что и однопоточный поиск;
+ *                      если `false`, порядок зависит от распределения работы между потоками
+ * @return список таких комбинаций точек из источника, чтобы при составлении
+ * соответствующих переставленных подматриц, подграфы, построенные по ним,
+ * были изоморфны заданному паттерну
+ */
+std::vector<CombinatoricsData>
+fastGetAllPatterns(const Matrix &source, const Matrix &pattern, bool hardCheck, int threadCount, bool deterministic);
+
+/**
+ * Быстрый подсчёт изоморфных подграфов
+ *
+ * Комбинации не создаются: на последней глубине перебора вместо обхода кандидатов
+ * считается кол-во единичных битов в домене последней точки
+ *
+ * @param source    дата-граф
+ * @param pattern   искомый паттерн
+ * @param hardCheck флаг, нужна ли жёсткая проверка
+ * @return кол-во комбинаций, которые вернул бы `fastGetAllPatterns`
+ */
+long long fastCountAllPatterns(const Matrix &source, const Matrix &pattern, bool hardCheck);
+
+/**
+ * Быстрый подсчёт изоморфных подграфов со сбором статистики перебора
+ *
+ * Статистика ведётся, только если библиотека собрана с опцией `PATTERNS_SEARCH_STATISTICS`
+ *
+ * @param source     дата-граф
+ * @param pattern    искомый паттерн
+ * @param hardCheck  флаг, нужна ли жёсткая проверка
+ * @param statistics статистика, к которой добавляются счётчики построения и перебора
+ * @return кол-во комбинаций, которые вернул бы `fastGetAllPatterns`
+ */
+long long fastCountAllPatterns(
+        const Matrix &source, const Matrix &pattern, bool hardCheck, SearchStatistics &statistics
+);
+
+/**
+ * Быстрый подсчёт изоморфных подграфов в несколько потоков
+ *
+ * @param source      дата-граф
+ * @param pattern     искомый паттерн
+ * @param hardCheck   флаг, нужна ли жёсткая проверка
+ * @param threadCount кол-во потоков
+ * @return кол-во комбинаций, которые вернул бы `fastGetAllPatterns`
+ */
+long long fastCountAllPatterns(const Matrix &source, const Matrix &pattern, bool hardCheck, int threadCount);
+
+/**
+ * Быстрый поиск изоморфных подграфов в несколько потоков с асинхронной записью найденных комбинаций
+ *
+ * Каждый поток поиска - отдельный производитель `writer`, поэтому комбинации не накапливаются
+ * в памяти, а поиск ждёт, только если запись не успевает за ним. Запись не закрывается:
+ * в неё можно записать результаты нескольких поисков, после чего вызвать `writer.close()`
+ *
+ * @param source      дата-граф
+ * @param pattern     искомый паттерн
+ * @param hardCheck   флаг, нужна ли жёсткая проверка
+ * @param threadCount кол-во потоков; производителей у `writer` должно быть не меньше
+ * @param writer      запись комбинаций размера паттерна
+ * @return флаг, был ли перебор доведён до конца, а не остановлен ошибкой записи
+ */
+bool fastWriteAllPatterns(
+        const Matrix &source, const Matrix &pattern, bool hardCheck, int threadCount, MatchWriter &writer
+);
+
+/**
+ * Быстрый поиск изоморфных подграфов, начинающийся с позиций самого редкого значения ребра паттерна
+ *
+ * Индекс строится один раз для дата-графа и может использоваться многими запросами;
+ * выгоднее всего он при жёсткой проверке паттернов со взвешенными рёбрами, значения
+ * которых редко встречаются в дата-графе
+ *
+ * @param source    дата-граф
+ * @param pattern   искомый паттерн
+ * @param hardCheck флаг, нужна ли жёсткая проверка
+ * @param index     индекс значений рёбер дата-графа
+ * @return список комбинаций, совпадающий как множество с результатом `fastGetAllPatterns`
+ */
+std::vector<CombinatoricsData>
+fastGetAllPatterns(const Matrix &source, const Matrix &pattern, bool hardCheck, const EdgeValueIndex &index);
+
+/**
+ * Быстрый подсчёт изоморфных подграфов, начинающийся с позиций самого редкого значения ребра паттерна
+ *
+ * @param source    дата-граф
+ * @param pattern   искомый паттерн
+ * @param hardCheck флаг, нужна ли жёсткая проверка
+ * @param index     индекс значений рёбер дата-графа
+ * @return кол-во комбинаций, которые вернул бы `fastGetAllPatterns`
+ */
+long long fastCountAllPatterns(
+        const Matrix &source, const Matrix &pattern, bool hardCheck, const EdgeValueIndex &index
+);
+
+/**
+ * Проверить, входит ли паттерн в дата-граф хотя бы один раз
+ *
+ * Перебор останавливается на первом же вхождении, а вершины первой точки паттерна
+ * перебираются в порядке `FastPatternSearch::getPromisingRoots()`, поэтому при
+ * положительном ответе время работы близко ко времени поиска первого вхождения
+ *
+ * @param source    дата-граф
+ * @param pattern   искомый паттерн
+ * @param hardCheck флаг, нужна ли жёсткая проверка
+ * @return флаг, найдено ли хотя бы одно вхождение
+ */
+bool fastContainsPattern(const Matrix &source, const Matrix &pattern, bool hardCheck);
+
+/**
+ * Найти первые `k` вхождений паттерна
+ *
+ * Перебор останавливается, как только найдено `k` вхождений. Вершины первой точки
+ * паттерна перебираются в порядке `FastPatternSearch::getPromisingRoots()`, поэтому
+ * найденные комбинации - это не обязательно первые `k` комбинаций `fastGetAllPatterns`
+ *
+ * @param source    дата-граф
+ * @param pattern   искомый паттерн
+ * @param hardCheck флаг, нужна ли жёсткая проверка
+ * @param k         максимальное кол-во вхождений
+ * @return не более `k` комбинаций; меньше, только если других вхождений нет
+ */
+std::vector<CombinatoricsData>
+fastFindFirstPatterns(const Matrix &source, const Matrix &pattern, bool hardCheck, long long k);
+
+/**
+ * Быстрый поиск изоморфных подграфов без повторов из-за симметрий паттерна
+ *
+ * Если у паттерна есть нетождественные автоморфизмы, `fastGetAllPatterns` возвращает
+ * каждый найденный подграф столько раз, сколько у паттерна автоморфизмов. Здесь
+ * перебор ограничен условиями `getSymmetryBreakingConstraints`, поэтому от каждого
+ * подграфа возвращается ровно одна комбинация, а сам перебор во столько же раз короче.
+ * При жёсткой проверке это одна комбинация на каждое множество вершин; при нежёсткой
+ * одно множество вершин может дать несколько комбинаций, если паттерн вкладывается в
+ * него по-разному, а не только с точностью до автоморфизма. Все отображения паттерна
+ * восстанавливаются по представителю методом `forEachAutomorphicMapping`
+ *
+ * @param source    дата-граф
+ * @param pattern   искомый паттерн
+ * @param hardCheck флаг, нужна ли жёсткая проверка
+ * @return по одной комбинации на каждый найденный подграф
+ */
+std::vector<CombinatoricsData>
+fastGetAllUniquePatterns(const Matrix &source, const Matrix &pattern, bool hardCheck);
+
+/**
+ * Быстрый подсчёт изоморфных подграфов без повторов из-за симметрий паттерна
+ *
+ * @param source    дата-граф
+ * @param pattern   искомый паттерн
+ * @param hardCheck флаг, нужна ли жёсткая проверка
+ * @return кол-во комбинаций, которые вернул бы `fastGetAllUniquePatterns`
+ */
+long long fastCountAllUniquePatterns(const Matrix &source, const Matrix &pattern, bool hardCheck);
+
+/**
+ * Быстрый поиск изоморфных подграфов в одной части перебора
+ *
+ * Поддеревья перебора, начинающиеся с вершин первой точки паттерна, делятся на
+ * `shardCount` частей с примерно равной оценкой стоимости; объединение результатов
+ * всех частей совпадает с результатом `fastGetAllPatterns`, и части не пересекаются.
+ * Так один запрос можно разделить между несколькими независимыми процессами
+ *
+ * @param source     дата-граф
+ * @param pattern    искомый паттерн
+ * @param hardCheck  флаг, нужна ли жёсткая проверка
+ * @param shardIndex номер части, от `0` до `shardCount - 1`
+ * @param shardCount кол-во частей
+ * @return список комбинаций, найденных в этой части перебора
+ */
+std::vector<CombinatoricsData>
+fastGetAllPatternsShard(const Matrix &source, const Matrix &pattern, bool hardCheck, int shardIndex, int shardCount);
+
+/**
+ * Быстрый поиск изоморфных подграфов сразу для нескольких паттернов
+ *
+ * Паттерны с одинаковой ведущей подматрицей (первыми точками в порядке индексов)
+ * делят узлы перебора, поэтому общие частичные комбинации перебираются один раз,
+ * а битовое представление дата-графа строится один раз для всех паттернов
+ *
+ * @param source    дата-граф
+ * @param patterns  искомые паттерны
+ * @param hardCheck флаг, нужна ли жёсткая проверка
+ * @return для каждого паттерна - список комбинаций, совпадающий как множество
+ * с результатом `fastGetAllPatterns` для этого паттерна
+ */
+std::vector<std::vector<CombinatoricsData>>
+fastGetAllPatternsBatch(const Matrix &source, const std::vector<Matrix> &patterns, bool hardCheck);
+
+/**
+ * Быстрый поиск изоморфных подграфов с передачей каждой найденной комбинации обработчику
+ *
+ * В отличие от `fastGetAllPatterns`, комбинации не накапливаются: обработчик получает
+ * представление комбинации только для чтения, которое действительно лишь до возврата
+ * из обработчика. Поэтому поиск не выделяет память на каждое вхождение и работает
+ * в постоянном объёме памяти при любом кол-ве вхождений. Комбинации передаются
+ * в том же порядке, в каком их возвращает `fastGetAllPatterns`
+ *
+ * @param source    дата-граф
+ * @param pattern   искомый паттерн
+ * @param hardCheck флаг, нужна ли жёсткая проверка
+ * @param visitor   обработчик найденной комбинации (IntSpan c)->bool; возвращает `false`,
+ *                  если поиск нужно остановить
+ * @return флаг, был ли перебор доведён до конца, а не остановлен обработчиком
+ */
+template<typename V>
+bool fastForEachPattern(const Matrix &source, const Matrix &pattern, bool hardCheck, const V &visitor) {
+    int patternSize = pattern.getSize();
+    // подготавливаем поиск: битовые плоскости и домены точек паттерна
+    FastPatternSearch search(source, pattern, hardCheck);
+    // передаём каждую комбинацию обработчику без копирования
+    return search.run([&visitor, &patternSize](int *c) {
+        return (bool) visitor(IntSpan(c, patternSize));
+    });
+}
+
+/**
+ * Быстрый поиск изоморфных подграфов в несколько потоков с передачей каждой найденной
+ * комбинации обработчику
+ *
+ * Обработчик вызывается одновременно из разных потоков, поэтому вместе с комбинацией
+ * получает номер потока: по нему удобно вести отдельные для каждого потока счётчики
+ * и буферы. Порядок комбинаций зависит от распределения работы между потоками
+ *
+ * @param source      дата-граф
+ * @param pattern     искомый паттерн
+ * @param hardCheck   флаг, нужна ли жёсткая проверка
+ * @param threadCount кол-во потоков
+ * @param visitor     обработчик найденной комбинации (int worker, IntSpan c)->bool; возвращает `false`,
+ *                    если поиск нужно остановить
+ * @return флаг, был ли перебор доведён до конца, а не остановлен обработчиком
+ */
+template<typename V>
+bool fastForEachPattern(
+        const Matrix &source, const Matrix &pattern, bool hardCheck, int threadCount, const V &visitor
+) {
+    int patternSize = pattern.getSize();
+    // подготавливаем поиск: битовые плоскости и домены точек паттерна
+    FastPatternSearch search(source, pattern, hardCheck);
+    // передаём каждую комбинацию обработчику без копирования
+    return search.runParallel(threadCount, [&visitor, &patternSize](int worker, int *c) {
+        return (bool) visitor(worker, IntSpan(c, patternSize));
+    });
+}
+
+/**
+ * Быстрый поиск изоморфных подграфов без повторов из-за симметрий паттерна с передачей
+ * каждой найденной комбинации обработчику
+ *
+ * @param source    дата-граф
+ * @param pattern   искомый паттерн
+ * @param hardCheck флаг, нужна ли жёсткая проверка
+ * @param visitor   обработчик комбинации-представителя (IntSpan c)->bool; возвращает `false`,
+ *                  если поиск нужно остановить
+ * @return флаг, был ли перебор доведён до конца, а не остановлен обработчиком
+ */
+template<typename V>
+bool fastForEachUniquePattern(const Matrix &source, const Matrix &pattern, bool hardCheck, const V &visitor) {
+    int patternSize = pattern.getSize();
+    // подготавливаем поиск с ограничениями порядка, отсекающими симметричные комбинации
+    FastPatternSearch search(
+            source, pattern, hardCheck, getSymmetryBreakingConstraints(getAutomorphisms(pattern))
+    );
+    // передаём каждую комбинацию обработчику без копирования
+    return search.run([&visitor, &patternSize](int *c) {
+        return (bool) visitor(IntSpan(c, patternSize));
+    });
+}
+
+/**
+ * Быстрый поиск изоморфных подграфов сразу для нескольких паттернов с передачей
+ * каждой найденной комбинации обработчику
+ *
+ * Все паттерны ищутся за один обход префиксного дерева их ведущих подматриц;
+ * комбинация передаётся вместе с номером паттерна в списке `patterns`
+ *
+ * @param source    дата-граф
+ * @param patterns  искомые паттерны
+ * @param hardCheck флаг, нужна ли жёсткая проверка
+ * @param visitor   обработчик найденной комбинации (int patternId, IntSpan c)->bool; возвращает `false`,
+ *                  если поиск нужно остановить
+ * @return флаг, был ли перебор доведён до конца, а не остановлен обработчиком
+ */
+template<typename V>
+bool fastForEachPatternBatch(
+        const Matrix &source, const std::vector<Matrix> &patterns, bool hardCheck, const V &visitor
+) {
+    // строим префиксное дерево паттернов и битовые плоскости для всех их значений
+    BatchPatternSearch search(source, patterns, hardCheck);
+    // передаём каждую комбинацию обработчику без копирования
+    return search.run([&visitor](int patternId, IntSpan c) {
+        return (bool) visitor(patternId, c);
+    });
+}
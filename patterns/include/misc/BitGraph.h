@@ -0,0 +1,130 @@
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+#include "Matrix.h"
+#include "bits.h"
+
+/**
+ * Битовое представление дата-графа
+ *
+ * Для каждой вершины хранится битовая строка исходящих и входящих рёбер
+ * (единица - элемент матрицы ненулевой), а для каждого из заданных значений -
+ * битовая плоскость: строки, в которых единицы стоят только там, где элемент
+ * матрицы равен этому значению. Благодаря этому множество вершин, совместимых
+ * сразу со всеми уже выбранными точками комбинации, получается пословным
+ * пересечением строк, а не проверкой каждой вершины по отдельности
+ */
+class BitGraph {
+    /**
+     * Размер стороны матрицы
+     */
+    int sz;
+    /**
+     * Кол-во 64-битных слов в одной битовой строке
+     */
+    int wordsCnt;
+    /**
+     * Номера битовых плоскостей по значениям элементов
+     */
+    std::unordered_map<int, int> planes;
+    /**
+     * Битовые строки ненулевых исходящих рёбер
+     */
+    std::vector<uint64_t> nonZeroOut;
+    /**
+     * Битовые строки ненулевых входящих рёбер
+     */
+    std::vector<uint64_t> nonZeroIn;
+    /**
+     * Битовые плоскости исходящих рёбер по значениям
+     */
+    std::vector<std::vector<uint64_t>> valueOut;
+    /**
+     * Битовые плоскости входящих рёбер по значениям
+     */
+    std::vector<std::vector<uint64_t>> valueIn;
+
+public:
+    /**
+     * Конструктор
+     *
+     * @param source дата-граф
+     * @param values ненулевые значения, для которых нужно построить битовые плоскости
+     */
+    BitGraph(const Matrix &source, const std::vector<int> &values);
+
+    /**
+     * Получить размер стороны матрицы
+     * @return размер стороны матрицы
+     */
+    int getSize() const {
+        return sz;
+    }
+
+    /**
+     * Получить кол-во 64-битных слов в одной битовой строке
+     * @return кол-во слов
+     */
+    int getWordsCount() const {
+        return wordsCnt;
+    }
+
+    /**
+     * Получить номер битовой плоскости значения
+     *
+     * @param value значение
+     * @return номер плоскости или -1, если для значения плоскость не строилась
+     */
+    int getPlane(int value) const;
+
+    /**
+     * Получить кол-во битовых плоскостей
+     * @return кол-во битовых плоскостей
+     */
+    int getPlanesCount() const {
+        return (int) valueOut.size();
+    }
+
+    /**
+     * Получить битовую строку вершин, в которые из i-ой вершины идёт ненулевое ребро
+     *
+     * @param i номер вершины
+     * @return битовая строка
+     */
+    const uint64_t *getNonZeroOut(int i) const {
+        return nonZeroOut.data() + (long long) i * wordsCnt;
+    }
+
+    /**
+     * Получить битовую строку вершин, из которых в j-ую вершину идёт ненулевое ребро
+     *
+     * @param j номер вершины
+     * @return битовая строка
+     */
+    const uint64_t *getNonZeroIn(int j) const {
+        return nonZeroIn.data() + (long long) j * wordsCnt;
+    }
+
+    /**
+     * Получить битовую строку вершин, в которые из i-ой вершины идёт ребро с заданным значением
+     *
+     * @param plane номер битовой плоскости
+     * @param i     номер вершины
+     * @return битовая строка
+     */
+    const uint64_t *getValueOut(int plane, int i) const {
+        return valueOut[plane].data() + (long long) i * wordsCnt;
+    }
+
+    /**
+     * Получить битовую строку вершин, из которых в j-ую вершину идёт ребро с заданным значением
+     *
+     * @param plane номер битовой плоскости
+     * @param j     номер вершины
+     * @return битовая строка
+     */
+    const uint64_t *getValueIn(int plane, int j) const {
+        return valueIn[plane].data() + (long long) j * wordsCnt;
+    }
+};
@@ -6,7 +6,7 @@
 
 /**
  * Класс данных для работы с комбинаторикой;
- * Хранит последовательность неотрицательных чисел в массиве, также
+ * Хранит последовательность неотрицательных чисел в собственном массиве, также
  * переопределён оператор проверки на равенство и
  * добавлена структура HashFunction для хранения в хэш-множестве
  */
@@ -28,12 +28,45 @@ public:
      */
     CombinatoricsData(const int *data, int sz);
 
+    /**
+     * Конструктор копирования; копия всегда владеет своей памятью
+     *
+     * @param other исходная последовательность
+     */
+    CombinatoricsData(const CombinatoricsData &other);
+
+    /**
+     * Конструктор перемещения
+     *
+     * @param other исходная последовательность
+     */
+    CombinatoricsData(CombinatoricsData &&other) noexcept;
+
+    /**
+     * Оператор присваивания
+     *
+     * @param other исходная последовательность
+     * @return ссылка на эту последовательность
+     */
+    CombinatoricsData &operator=(CombinatoricsData other) noexcept;
+
+    /**
+     * Деструктор
+     */
+    ~CombinatoricsData();
+
     /**
      * Получить элементы последовательности
      * @return элементы последовательности
      */
     int *getData();
 
+    /**
+     * Получить элементы последовательности
+     * @return элементы последовательности
+     */
+    const int *getData() const;
+
     /**
      * Получить размер последовательности
      * @return размер последовательности
@@ -81,5 +114,18 @@ public:
         // возвращаем флаг, что последовательности совпадают
         return true;
     }
+
+    /**
+     * Лексикографическое сравнение последовательностей
+     * @param cd1 первая последовательность
+     * @param cd2 вторая последовательность
+     * @return флаг, идёт ли первая последовательность раньше второй
+     */
+    friend bool operator<(const CombinatoricsData &cd1, const CombinatoricsData &cd2) {
+        for (int i = 0; i < cd1.sz && i < cd2.sz; i++)
+            if (cd1.data[i] != cd2.data[i])
+                return cd1.data[i] < cd2.data[i];
+        return cd1.sz < cd2.sz;
+    }
 };
 
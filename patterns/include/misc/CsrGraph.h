@@ -0,0 +1,292 @@
+#pragma once
+
+#include <string>
+#include <stdexcept>
+#include <vector>
+#include "Matrix.h"
+
+/**
+ * Разреженное представление дата-графа в формате CSR
+ *
+ * Хранятся только ненулевые рёбра: для каждой вершины - отсортированные по номеру
+ * соседа списки исходящих и входящих рёбер вместе с их значениями. Смещения
+ * списков 64-битные, поэтому кол-во рёбер не ограничено размером `int`.
+ * Петли (диагональные элементы) хранятся отдельно и в списки рёбер не входят
+ *
+ * Памяти нужно `O(n + m)` вместо `O(n^2)` у плотной матрицы, поэтому так можно
+ * хранить графы с миллионами вершин
+ *
+ * Граф может как владеть своими массивами, так и быть представлением чужих
+ * (например, отображённого в память файла); копия представления - тоже представление
+ */
+class CsrGraph {
+public:
+    /**
+     * Ребро дата-графа
+     */
+    struct Edge {
+        /**
+         * Вершина, из которой выходит ребро
+         */
+        int from;
+        /**
+         * Вершина, в которую входит ребро
+         */
+        int to;
+        /**
+         * Значение ребра
+         */
+        int value;
+    };
+
+private:
+    /**
+     * Кол-во вершин
+     */
+    int sz;
+    /**
+     * Кол-во рёбер без учёта петель
+     */
+    long long edgesCnt;
+    /**
+     * Значения петель вершин (`0`, если петли нет)
+     */
+    const int *loops;
+    /**
+     * Начала списков исходящих рёбер: рёбра вершины `i` лежат в `[outOffsets[i], outOffsets[i + 1])`
+     */
+    const long long *outOffsets;
+    /**
+     * Вершины, в которые идут исходящие рёбра
+     */
+    const int *outTargets;
+    /**
+     * Значения исходящих рёбер
+     */
+    const int *outValues;
+    /**
+     * Начала списков входящих рёбер: рёбра вершины `j` лежат в `[inOffsets[j], inOffsets[j + 1])`
+     */
+    const long long *inOffsets;
+    /**
+     * Вершины, из которых идут входящие рёбра
+     */
+    const int *inSources;
+    /**
+     * Значения входящих рёбер
+     */
+    const int *inValues;
+    /**
+     * Флаг, владеет ли граф своими массивами
+     */
+    bool owner;
+
+    /**
+     * Собственные массивы графа, на которые указывают `loops`, `outOffsets`, ...;
+     * у представления пустые
+     */
+    std::vector<int> ownLoops;
+    std::vector<long long> ownOutOffsets;
+    std::vector<int> ownOutTargets;
+    std::vector<int> ownOutValues;
+    std::vector<long long> ownInOffsets;
+    std::vector<int> ownInSources;
+    std::vector<int> ownInValues;
+
+    /**
+     * Построить списки входящих рёбер по спискам исходящих
+     */
+    void buildIn();
+
+    /**
+     * Направить указатели на собственные массивы
+     */
+    void bind();
+
+public:
+    /**
+     * Конструктор пустого графа
+     */
+    CsrGraph();
+
+    /**
+     * Конструктор по списку рёбер
+     *
+     * Рёбра с нулевым значением пропускаются; одно и то же ребро не может встречаться дважды
+     *
+     * @param vertexCount кол-во вершин
+     * @param edges       рёбра в произвольном порядке
+     */
+    CsrGraph(int vertexCount, std::vector<Edge> edges);
+
+    /**
+     * Конструктор по плотной матрице связности
+     *
+     * @param source матрица связности
+     */
+    explicit CsrGraph(const Matrix &source);
+
+    /**
+     * Конструктор представления чужих массивов; граф не владеет памятью и не освобождает её
+     *
+     * @param vertexCount кол-во вершин
+     * @param edgeCount   кол-во рёбер без учёта петель
+     * @param loops       значения петель: `vertexCount` элементов
+     * @param outOffsets  начала списков исходящих рёбер: `vertexCount + 1` элементов
+     * @param outTargets  вершины, в которые идут исходящие рёбра: `edgeCount` элементов
+     * @param outValues   значения исходящих рёбер: `edgeCount` элементов
+     * @param inOffsets   начала списков входящих рёбер: `vertexCount + 1` элементов
+     * @param inSources   вершины, из которых идут входящие рёбра: `edgeCount` элементов
+     * @param inValues    значения входящих рёбер: `edgeCount` элементов
+     */
+    CsrGraph(int vertexCount, long long edgeCount, const int *loops,
+             const long long *outOffsets, const int *outTargets, const int *outValues,
+             const long long *inOffsets, const int *inSources, const int *inValues);
+
+    /**
+     * Конструктор копирования; копия представления остаётся представлением тех же массивов
+     *
+     * @param other исходный граф
+     */
+    CsrGraph(const CsrGraph &other);
+
+    /**
+     * Конструктор перемещения
+     *
+     * @param other исходный граф
+     */
+    CsrGraph(CsrGraph &&other) noexcept;
+
+    /**
+     * Оператор присваивания
+     *
+     * @param other исходный граф
+     * @return ссылка на этот граф
+     */
+    CsrGraph &operator=(CsrGraph other) noexcept;
+
+    /**
+     * Проверить, владеет ли граф своими массивами
+     * @return флаг, владеет ли граф массивами; `false` у представления
+     */
+    bool isOwner() const {
+        return owner;
+    }
+
+    /**
+     * Получить начала списков исходящих рёбер
+     * @return `getSize() + 1` смещений
+     */
+    const long long *getOutOffsets() const {
+        return outOffsets;
+    }
+
+    /**
+     * Получить начала списков входящих рёбер
+     * @return `getSize() + 1` смещений
+     */
+    const long long *getInOffsets() const {
+        return inOffsets;
+    }
+
+    /**
+     * Получить кол-во вершин
+     * @return кол-во вершин
+     */
+    int getSize() const {
+        return sz;
+    }
+
+    /**
+     * Получить кол-во ненулевых рёбер без учёта петель
+     * @return кол-во рёбер
+     */
+    long long getEdgeCount() const {
+        return edgesCnt;
+    }
+
+    /**
+     * Получить значение петли вершины
+     *
+     * @param i номер вершины
+     * @return значение петли или `0`, если петли нет
+     */
+    int getLoop(int i) const {
+        return loops[i];
+    }
+
+    /**
+     * Получить кол-во исходящих рёбер вершины без учёта петли
+     *
+     * @param i номер вершины
+     * @return кол-во рёбер
+     */
+    int getOutDegree(int i) const {
+        return (int) (outOffsets[i + 1] - outOffsets[i]);
+    }
+
+    /**
+     * Получить кол-во входящих рёбер вершины без учёта петли
+     *
+     * @param j номер вершины
+     * @return кол-во рёбер
+     */
+    int getInDegree(int j) const {
+        return (int) (inOffsets[j + 1] - inOffsets[j]);
+    }
+
+    /**
+     * Получить вершины, в которые идут исходящие рёбра, в порядке возрастания
+     *
+     * @param i номер вершины
+     * @return первая из `getOutDegree(i)` вершин
+     */
+    const int *getOutTargets(int i) const {
+        return outTargets + outOffsets[i];
+    }
+
+    /**
+     * Получить значения исходящих рёбер в том же порядке, что и `getOutTargets()`
+     *
+     * @param i номер вершины
+     * @return первое из `getOutDegree(i)` значений
+     */
+    const int *getOutValues(int i) const {
+        return outValues + outOffsets[i];
+    }
+
+    /**
+     * Получить вершины, из которых идут входящие рёбра, в порядке возрастания
+     *
+     * @param j номер вершины
+     * @return первая из `getInDegree(j)` вершин
+     */
+    const int *getInSources(int j) const {
+        return inSources + inOffsets[j];
+    }
+
+    /**
+     * Получить значения входящих рёбер в том же порядке, что и `getInSources()`
+     *
+     * @param j номер вершины
+     * @return первое из `getInDegree(j)` значений
+     */
+    const int *getInValues(int j) const {
+        return inValues + inOffsets[j];
+    }
+
+    /**
+     * Получить значение элемента матрицы связности двоичным поиском по списку рёбер
+     *
+     * @param i номер строки
+     * @param j номер столбца
+     * @return значение ребра из i-ой вершины в j-ую или `0`, если ребра нет
+     */
+    int get(int i, int j) const;
+
+    /**
+     * Получить плотную матрицу связности
+     * @return матрица связности
+     */
+    Matrix toMatrix() const;
+};
@@ -0,0 +1,193 @@
+#pragma once
+
+#include <string>
+#include <stdexcept>
+#include <vector>
+#include "CsrGraph.h"
+#include "Matrix.h"
+
+/**
+ * Изменяемое разреженное представление дата-графа
+ *
+ * Как и `CsrGraph`, хранит для каждой вершины отсортированные по номеру соседа списки
+ * исходящих и входящих ненулевых рёбер со значениями и отдельно петли, но каждый
+ * список лежит в своём массиве, поэтому ребро можно добавить, удалить или изменить
+ * за время, пропорциональное степени вершины, не перестраивая весь граф
+ */
+class DynamicGraph {
+    /**
+     * Список рёбер одной вершины
+     */
+    struct Adjacency {
+        /**
+         * Соседи в порядке возрастания
+         */
+        std::vector<int> vertices;
+        /**
+         * Значения рёбер в том же порядке
+         */
+        std::vector<int> values;
+
+        /**
+         * Задать значение ребра с соседом
+         *
+         * @param vertex сосед
+         * @param value  новое значение; `0` - удалить ребро
+         */
+        void set(int vertex, int value);
+    };
+
+    /**
+     * Кол-во вершин
+     */
+    int sz;
+    /**
+     * Кол-во ненулевых рёбер без учёта петель
+     */
+    long long edgesCnt;
+    /**
+     * Значения петель вершин (`0`, если петли нет)
+     */
+    std::vector<int> loops;
+    /**
+     * Списки исходящих рёбер
+     */
+    std::vector<Adjacency> out;
+    /**
+     * Списки входящих рёбер
+     */
+    std::vector<Adjacency> in;
+
+public:
+    /**
+     * Конструктор графа без рёбер
+     *
+     * @param vertexCount кол-во вершин
+     */
+    explicit DynamicGraph(int vertexCount);
+
+    /**
+     * Конструктор по разреженному графу
+     *
+     * @param source разреженный граф
+     */
+    explicit DynamicGraph(const CsrGraph &source);
+
+    /**
+     * Конструктор по плотной матрице связности
+     *
+     * @param source матрица связности
+     */
+    explicit DynamicGraph(const Matrix &source);
+
+    /**
+     * Получить кол-во вершин
+     * @return кол-во вершин
+     */
+    int getSize() const {
+        return sz;
+    }
+
+    /**
+     * Получить кол-во ненулевых рёбер без учёта петель
+     * @return кол-во рёбер
+     */
+    long long getEdgeCount() const {
+        return edgesCnt;
+    }
+
+    /**
+     * Получить значение петли вершины
+     *
+     * @param i номер вершины
+     * @return значение петли или `0`, если петли нет
+     */
+    int getLoop(int i) const {
+        return loops[i];
+    }
+
+    /**
+     * Получить кол-во исходящих рёбер вершины без учёта петли
+     *
+     * @param i номер вершины
+     * @return кол-во рёбер
+     */
+    int getOutDegree(int i) const {
+        return (int) out[i].vertices.size();
+    }
+
+    /**
+     * Получить кол-во входящих рёбер вершины без учёта петли
+     *
+     * @param j номер вершины
+     * @return кол-во рёбер
+     */
+    int getInDegree(int j) const {
+        return (int) in[j].vertices.size();
+    }
+
+    /**
+     * Получить вершины, в которые идут исходящие рёбра, в порядке возрастания
+     *
+     * @param i номер вершины
+     * @return первая из `getOutDegree(i)` вершин
+     */
+    const int *getOutTargets(int i) const {
+        return out[i].vertices.data();
+    }
+
+    /**
+     * Получить значения исходящих рёбер в том же порядке, что и `getOutTargets()`
+     *
+     * @param i номер вершины
+     * @return первое из `getOutDegree(i)` значений
+     */
+    const int *getOutValues(int i) const {
+        return out[i].values.data();
+    }
+
+    /**
+     * Получить вершины, из которых идут входящие рёбра, в порядке возрастания
+     *
+     * @param j номер вершины
+     * @return первая из `getInDegree(j)` вершин
+     */
+    const int *getInSources(int j) const {
+        return in[j].vertices.data();
+    }
+
+    /**
+     * Получить значения входящих рёбер в том же порядке, что и `getInSources()`
+     *
+     * @param j номер вершины
+     * @return первое из `getInDegree(j)` значений
+     */
+    const int *getInValues(int j) const {
+        return in[j].values.data();
+    }
+
+    /**
+     * Получить значение элемента матрицы связности двоичным поиском по списку рёбер
+     *
+     * @param i номер строки
+     * @param j номер столбца
+     * @return значение ребра из i-ой вершины в j-ую или `0`, если ребра нет
+     */
+    int get(int i, int j) const;
+
+    /**
+     * Задать значение элемента матрицы связности
+     *
+     * @param i     номер строки
+     * @param j     номер столбца
+     * @param value новое значение; `0` - удалить ребро
+     * @return прежнее значение
+     */
+    int set(int i, int j, int value);
+
+    /**
+     * Получить плотную матрицу связности
+     * @return матрица связности
+     */
+    Matrix toMatrix() const;
+};
@@ -0,0 +1,98 @@
+#pragma once
+
+#include <vector>
+#include <unordered_map>
+#include "CsrGraph.h"
+#include "Matrix.h"
+
+/**
+ * Инвертированный индекс значений рёбер дата-графа
+ *
+ * Для каждого ненулевого значения хранит список позиций `(строка, столбец)` матрицы
+ * связности, в которых оно стоит; диагональные элементы (петли) в индекс не входят.
+ * Позиции всех значений лежат в одном массиве, сгруппированные по значениям,
+ * а внутри группы упорядочены по строке, затем по столбцу. Индекс строится один раз
+ * для дата-графа и может использоваться многими запросами
+ */
+class EdgeValueIndex {
+public:
+    /**
+     * Позиция элемента матрицы связности
+     */
+    struct Position {
+        /**
+         * Номер строки - вершина, из которой идёт ребро
+         */
+        int row;
+        /**
+         * Номер столбца - вершина, в которую идёт ребро
+         */
+        int col;
+    };
+
+private:
+    /**
+     * Номера групп по значениям
+     */
+    std::unordered_map<int, int> groups;
+    /**
+     * Начало каждой группы в массиве позиций; последний элемент - общее кол-во позиций
+     */
+    std::vector<long long> offsets;
+    /**
+     * Позиции всех значений, сгруппированные по значениям
+     */
+    std::vector<Position> positions;
+
+    /**
+     * Разложить рёбра по группам значений
+     *
+     * @param edges рёбра: значение и позиция
+     */
+    void build(const std::vector<std::pair<int, Position>> &edges);
+
+public:
+    /**
+     * Конструктор по плотной матрице связности
+     *
+     * @param source матрица связности
+     */
+    explicit EdgeValueIndex(const Matrix &source);
+
+    /**
+     * Конструктор по разреженному графу
+     *
+     * @param source разреженный граф
+     */
+    explicit EdgeValueIndex(const CsrGraph &source);
+
+    /**
+     * Получить кол-во различных значений в индексе
+     * @return кол-во значений
+     */
+    int getValuesCount() const {
+        return (int) groups.size();
+    }
+
+    /**
+     * Получить кол-во позиций со значением
+     *
+     * @param value значение
+     * @return кол-во недиагональных элементов матрицы, равных значению; `0` для нуля
+     */
+    long long getCount(int value) const {
+        auto it = groups.find(value);
+        return it == groups.end() ? 0 : offsets[it->second + 1] - offsets[it->second];
+    }
+
+    /**
+     * Получить позиции со значением
+     *
+     * @param value значение
+     * @return первая из `getCount(value)` позиций
+     */
+    const Position *getPositions(int value) const {
+        auto it = groups.find(value);
+        return it == groups.end() ? nullptr : positions.data() + offsets[it->second];
+    }
+};
@@ -0,0 +1,311 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+#include "CsrGraph.h"
+#include "Matrix.h"
+
+/**
+ * Генератор синтетических графов
+ *
+ * Каждый объект хранит своё зерно и не использует глобальное состояние `rand()`,
+ * поэтому разные объекты можно использовать из разных потоков одновременно (один
+ * объект - только из одного потока). Каждый вызов метода генерации получает свой
+ * поток случайных чисел, выведенный из зерна и номера вызова, а внутри вызова
+ * строки матрицы и части рёбер получают потоки по своим номерам: результат
+ * зависит только от зерна и последовательности вызовов, но не от кол-ва потоков
+ * заполнения. Два генератора с одинаковым зерном дают одинаковые графы, а плотная
+ * и разреженная формы одной модели при одинаковом зерне задают один и тот же граф
+ *
+ * Модели:
+ * - Эрдёша-Реньи: каждое недиагональное ребро присутствует независимо с вероятностью `p`;
+ *   рёбра строки выбираются пропусками геометрической длины, поэтому работа
+ *   пропорциональна кол-ву рёбер, а не квадрату кол-ва вершин
+ * - Барабаши-Альберт: каждая новая вершина проводит `m` рёбер к уже существующим вершинам
+ *   с вероятностью, пропорциональной их степени; степени распределены по степенному закону
+ * - R-MAT: каждое ребро спускается по квадрантам матрицы связности с вероятностями
+ *   `a`, `b`, `c`, `1 - a - b - c`; получаются графы с сообществами и тяжёлыми хвостами
+ *
+ * Значения рёбер моделей выбираются равномерно из `[1, valueRange]`, петель модели не создают
+ */
+class GraphGenerator {
+public:
+    /**
+     * Генератор псевдослучайных чисел SplitMix64
+     *
+     * В отличие от распределений стандартной библиотеки, последовательность
+     * не зависит от её реализации
+     */
+    class Random {
+        /**
+         * Состояние
+         */
+        uint64_t state;
+    public:
+        /**
+         * Конструктор
+         *
+         * @param seed зерно
+         */
+        explicit Random(uint64_t seed) : state(seed) {
+        }
+
+        /**
+         * Получить следующее случайное 64-битное число
+         * @return случайное число
+         */
+        uint64_t next() {
+            uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+            z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+            z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+            return z ^ (z >> 31);
+        }
+
+        /**
+         * Получить случайное число из `[0, bound)`
+         *
+         * @param bound верхняя граница; положительная
+         * @return случайное число
+         */
+        int nextInt(int bound) {
+            return (int) (((next() >> 32) * (uint64_t) bound) >> 32);
+        }
+
+        /**
+         * Получить случайное число из `[0, 1)`
+         * @return случайное число
+         */
+        double nextDouble() {
+            return (double) (next() >> 11) / 9007199254740992.0;
+        }
+    };
+
+private:
+    /**
+     * Зерно генератора
+     */
+    uint64_t seed;
+    /**
+     * Кол-во уже выданных потоков случайных чисел
+     */
+    uint64_t streams;
+    /**
+     * Кол-во потоков заполнения
+     */
+    int threadCount;
+
+    /**
+     * Смешать два числа в зерно потока случайных чисел
+     *
+     * @param a первое число
+     * @param b второе число
+     * @return зерно
+     */
+    static uint64_t mix(uint64_t a, uint64_t b) {
+        return Random(a ^ (b * 0xD1B54A32D192ED03ULL)).next();
+    }
+
+    /**
+     * Получить зерно очередного вызова
+     * @return зерно
+     */
+    uint64_t nextStream() {
+        return mix(seed, streams++);
+    }
+
+    /**
+     * Обойти диапазон `[0, cnt)` частями в несколько потоков
+     *
+     * @param cnt  кол-во элементов
+     * @param body лямбда выражение (long long from, long long to, int worker), обрабатывающее
+     *             часть `[from, to)`; части идут подряд, номер части равен номеру потока
+     * @return кол-во частей
+     */
+    template<typename F>
+    int parallelFor(long long cnt, const F &body) const;
+
+    /**
+     * Перебрать рёбра строки графа Эрдёша-Реньи
+     *
+     * @param stream     зерно вызова
+     * @param i          номер строки
+     * @param n          кол-во вершин
+     * @param p          вероятность ребра
+     * @param valueRange кол-во различных значений рёбер
+     * @param consumer   лямбда выражение (int j, int value), получающее рёбра по возрастанию столбца
+     */
+    template<typename F>
+    static void forEachErdosRenyiEdge(uint64_t stream, int i, int n, double p, int valueRange, const F &consumer);
+
+    /**
+     * Сгенерировать рёбра графа Барабаши-Альберт
+     *
+     * @param n          кол-во вершин
+     * @param m          кол-во рёбер каждой новой вершины
+     * @param valueRange кол-во различных значений рёбер
+     * @return рёбра
+     */
+    std::vector<CsrGraph::Edge> barabasiAlbertEdges(int n, int m, int valueRange);
+
+    /**
+     * Сгенерировать рёбра графа R-MAT
+     *
+     * @param n          кол-во вершин
+     * @param edgeCount  кол-во генерируемых рёбер
+     * @param a          вероятность левого верхнего квадранта
+     * @param b          вероятность правого верхнего квадранта
+     * @param c          вероятность левого нижнего квадранта
+     * @param valueRange кол-во различных значений рёбер
+     * @return рёбра без повторов и петель
+     */
+    std::vector<CsrGraph::Edge> rmatEdges(int n, long long edgeCount, double a, double b, double c, int valueRange);
+
+public:
+    /**
+     * Конструктор
+     *
+     * @param seed        зерно
+     * @param threadCount кол-во потоков заполнения
+     */
+    explicit GraphGenerator(uint64_t seed, int threadCount = 1);
+
+    /**
+     * Получить кол-во потоков заполнения
+     * @return кол-во потоков
+     */
+    int getThreadCount() const {
+        return threadCount;
+    }
+
+    /**
+     * Получить случайную перестановку перетасовкой Фишера-Йетса за `O(n)`
+     *
+     * @param n размер перестановки
+     * @return перестановка чисел `[0, n)`
+     */
+    std::vector<int> permutation(int n);
+
+    /**
+     * Получить случайную комбинацию выборочным отбором за `O(n)` без дополнительной памяти
+     *
+     * @param n кол-во элементов множества
+     * @param k размер комбинации
+     * @return `k` различных чисел из `[0, n)` по возрастанию
+     */
+    std::vector<int> combination(int n, int k);
+
+    /**
+     * Получить случайную матрицу: каждый элемент, включая диагональ, ненулевой с вероятностью
+     * `nonZeroPart` и тогда выбирается из `[minVal, maxVal)`, иначе равен нулю
+     *
+     * @param n           размер стороны матрицы
+     * @param minVal      минимальное значение элемента
+     * @param maxVal      максимальное значение элемента, не включая его
+     * @param nonZeroPart доля ненулевых элементов
+     * @return матрица
+     */
+    Matrix uniformMatrix(int n, int minVal, int maxVal, double nonZeroPart);
+
+    /**
+     * Получить граф Эрдёша-Реньи в плотной форме
+     *
+     * @param n          кол-во вершин
+     * @param p          вероятность каждого недиагонального ребра
+     * @param valueRange кол-во различных значений рёбер
+     * @return матрица связности
+     */
+    Matrix erdosRenyi(int n, double p, int valueRange);
+
+    /**
+     * Получить граф Эрдёша-Реньи в разреженной форме
+     *
+     * @param n          кол-во вершин
+     * @param p          вероятность каждого недиагонального ребра
+     * @param valueRange кол-во различных значений рёбер
+     * @return разреженный граф
+     */
+    CsrGraph erdosRenyiSparse(int n, double p, int valueRange);
+
+    /**
+     * Получить граф Барабаши-Альберт в плотной форме
+     *
+     * Первые `m` вершин не имеют исходящих рёбер, каждая следующая проводит ровно `m`
+     * рёбер к различным предыдущим вершинам
+     *
+     * @param n          кол-во вершин
+     * @param m          кол-во рёбер каждой новой вершины
+     * @param valueRange кол-во различных значений рёбер
+     * @return матрица связности
+     */
+    Matrix barabasiAlbert(int n, int m, int valueRange);
+
+    /**
+     * Получить граф Барабаши-Альберт в разреженной форме
+     *
+     * @param n          кол-во вершин
+     * @param m          кол-во рёбер каждой новой вершины
+     * @param valueRange кол-во различных значений рёбер
+     * @return разреженный граф
+     */
+    CsrGraph barabasiAlbertSparse(int n, int m, int valueRange);
+
+    /**
+     * Получить граф R-MAT в плотной форме
+     *
+     * Рёбра, попавшие за пределы `n` вершин или на диагональ, отбрасываются, а повторные
+     * объединяются с первым, поэтому рёбер может получиться меньше `edgeCount`
+     *
+     * @param n          кол-во вершин
+     * @param edgeCount  кол-во генерируемых рёбер
+     * @param a          вероятность левого верхнего квадранта
+     * @param b          вероятность правого верхнего квадранта
+     * @param c          вероятность левого нижнего квадранта
+     * @param valueRange кол-во различных значений рёбер
+     * @return матрица связности
+     */
+    Matrix rmat(int n, long long edgeCount, double a, double b, double c, int valueRange);
+
+    /**
+     * Получить граф R-MAT в разреженной форме
+     *
+     * @param n          кол-во вершин
+     * @param edgeCount  кол-во генерируемых рёбер
+     * @param a          вероятность левого верхнего квадранта
+     * @param b          вероятность правого верхнего квадранта
+     * @param c          вероятность левого нижнего квадранта
+     * @param valueRange кол-во различных значений рёбер
+     * @return разреженный граф
+     */
+    CsrGraph rmatSparse(int n, long long edgeCount, double a, double b, double c, int valueRange);
+};
+
+/**
+ * Обойти диапазон `[0, cnt)` частями в несколько потоков
+ *
+ * @param cnt  кол-во элементов
+ * @param body лямбда выражение (long long from, long long to, int worker), обрабатывающее
+ *             часть `[from, to)`; части идут подряд, номер части равен номеру потока
+ * @return кол-во частей
+ */
+template<typename F>
+int GraphGenerator::parallelFor(long long cnt, const F &body) const {
+    int parts = (int) std::max(1LL, std::min((long long) threadCount, cnt));
+    // в один поток работаем без создания потоков
+    if (parts == 1) {
+        body(0LL, cnt, 0);
+        return 1;
+    }
+
+    std::vector<std::thread> threads;
+    for (int worker = 0; worker < parts; worker++)
+        threads.emplace_back([&body, &cnt, &parts, worker]() {
+            body(cnt * worker / parts, cnt * (worker + 1) / parts, worker);
+        });
+    for (std::thread &thread: threads)
+        thread.join();
+    return parts;
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+/**
+ * Представление непрерывного участка массива целых чисел только для чтения
+ *
+ * Не владеет данными: действует, пока жив массив, на который указывает
+ */
+class IntSpan {
+    /**
+     * Первый элемент
+     */
+    const int *ptr;
+    /**
+     * Кол-во элементов
+     */
+    int sz;
+
+public:
+    /**
+     * Конструктор
+     *
+     * @param ptr первый элемент
+     * @param sz  кол-во элементов
+     */
+    IntSpan(const int *ptr, int sz) : ptr(ptr), sz(sz) {
+    }
+
+    /**
+     * Получить элементы
+     * @return указатель на первый элемент
+     */
+    const int *data() const {
+        return ptr;
+    }
+
+    /**
+     * Получить кол-во элементов
+     * @return кол-во элементов
+     */
+    int size() const {
+        return sz;
+    }
+
+    /**
+     * Получить элемент
+     *
+     * @param i номер элемента
+     * @return элемент
+     */
+    int operator[](int i) const {
+        return ptr[i];
+    }
+
+    /**
+     * Начало участка для цикла по диапазону
+     * @return указатель на первый элемент
+     */
+    const int *begin() const {
+        return ptr;
+    }
+
+    /**
+     * Конец участка для цикла по диапазону
+     * @return указатель на элемент за последним
+     */
+    const int *end() const {
+        return ptr + sz;
+    }
+};
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <stdexcept>
+#include <vector>
+#include "IntSpan.h"
+#include "MatchSet.h"
+#include "MatchWriter.h"
+
+/**
+ * Потоковое чтение файла комбинаций, записанного `MatchWriter`
+ *
+ * Формат определяется по сигнатуре файла. Двоичные файлы читаются по блокам,
+ * поэтому в памяти находится только один блок, а не весь файл
+ */
+class MatchReader {
+    /**
+     * Поток ввода
+     */
+    std::ifstream in;
+    /**
+     * Путь к файлу для сообщений об ошибках
+     */
+    std::string path;
+    /**
+     * Формат файла
+     */
+    MatchFormat format;
+    /**
+     * Размер одной комбинации
+     */
+    int width;
+    /**
+     * Кол-во комбинаций по заголовку; `-1`, если оно неизвестно
+     */
+    long long count;
+    /**
+     * Текущая комбинация
+     */
+    std::vector<int> combination;
+    /**
+     * Данные текущего блока
+     */
+    std::string block;
+    /**
+     * Позиция чтения в данных текущего блока
+     */
+    std::size_t position;
+    /**
+     * Кол-во ещё не прочитанных комбинаций текущего блока
+     */
+    uint32_t left;
+    /**
+     * Первая строка текстового файла: по ней определяется размер комбинации
+     */
+    std::string firstLine;
+    /**
+     * Флаг, что первая строка текстового файла ещё не разобрана
+     */
+    bool hasFirstLine;
+
+    /**
+     * Прочитать следующий блок двоичного файла
+     * @return флаг, что блок прочитан, а не достигнут конец файла
+     */
+    bool readBlock();
+
+    /**
+     * Разобрать строку текстового файла
+     *
+     * @param line  строка
+     * @param items элементы строки
+     */
+    void parseLine(const std::string &line, std::vector<int> &items) const;
+
+public:
+    /**
+     * Конструктор; открывает файл и читает его заголовок
+     *
+     * @param path путь к файлу
+     */
+    explicit MatchReader(const std::string &path);
+
+    /**
+     * Получить формат файла
+     * @return формат файла
+     */
+    MatchFormat getFormat() const {
+        return format;
+    }
+
+    /**
+     * Получить размер одной комбинации
+     * @return размер комбинации; `0` у пустого текстового файла
+     */
+    int getWidth() const {
+        return width;
+    }
+
+    /**
+     * Получить кол-во комбинаций по заголовку файла
+     * @return кол-во комбинаций; `-1` у текстового и у не закрытого при записи файла
+     */
+    long long getCount() const {
+        return count;
+    }
+
+    /**
+     * Перейти к следующей комбинации
+     * @return флаг, что комбинация прочитана, а не достигнут конец файла
+     */
+    bool next();
+
+    /**
+     * Получить текущую комбинацию
+     * @return представление комбинации; действительно до следующего вызова `next()`
+     */
+    IntSpan get() const {
+        return IntSpan(combination.data(), width);
+    }
+
+    /**
+     * Дочитать все оставшиеся комбинации
+     *
+     * @param res множество, в которое добавляются комбинации; размер его комбинаций
+     *            должен совпадать с `getWidth()`
+     * @return кол-во прочитанных комбинаций
+     */
+    long long readAll(MatchSet &res);
+};
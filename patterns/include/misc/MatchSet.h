@@ -0,0 +1,224 @@
+#pragma once
+
+#include <vector>
+#include <string>
+#include <stdexcept>
+#include "CombinatoricsData.h"
+#include "IntSpan.h"
+
+/**
+ * Множество найденных комбинаций одного паттерна
+ *
+ * Все комбинации лежат подряд в одном буфере: `i`-ая комбинация занимает элементы
+ * с `i * width` по `(i + 1) * width - 1`. Поэтому миллионы вхождений требуют
+ * лишь нескольких выделений памяти, а не отдельного массива на каждое вхождение.
+ * Комбинации отдаются представлениями только для чтения, которые действительны,
+ * пока множество не изменено. Множество можно перемещать, но не копировать
+ */
+class MatchSet {
+    /**
+     * Размер одной комбинации
+     */
+    int width;
+    /**
+     * Кол-во комбинаций; хранится отдельно, т.к. комбинации нулевого размера не занимают буфер
+     */
+    long long cnt;
+    /**
+     * Элементы всех комбинаций подряд
+     */
+    std::vector<int> buffer;
+
+public:
+    /**
+     * Итератор по комбинациям
+     */
+    class Iterator {
+        /**
+         * Первый элемент текущей комбинации
+         */
+        const int *ptr;
+        /**
+         * Номер текущей комбинации
+         */
+        long long index;
+        /**
+         * Размер одной комбинации
+         */
+        int width;
+
+    public:
+        /**
+         * Конструктор
+         *
+         * @param ptr   первый элемент текущей комбинации
+         * @param index номер текущей комбинации
+         * @param width размер одной комбинации
+         */
+        Iterator(const int *ptr, long long index, int width) : ptr(ptr), index(index), width(width) {
+        }
+
+        /**
+         * Получить текущую комбинацию
+         * @return представление комбинации
+         */
+        IntSpan operator*() const {
+            return IntSpan(ptr, width);
+        }
+
+        /**
+         * Перейти к следующей комбинации
+         * @return ссылка на этот итератор
+         */
+        Iterator &operator++() {
+            ptr += width;
+            index++;
+            return *this;
+        }
+
+        /**
+         * Проверить, указывают ли итераторы на разные комбинации
+         *
+         * @param other другой итератор
+         * @return флаг, различаются ли итераторы
+         */
+        bool operator!=(const Iterator &other) const {
+            return index != other.index;
+        }
+    };
+
+    /**
+     * Конструктор
+     *
+     * @param width размер одной комбинации
+     */
+    explicit MatchSet(int width);
+
+    MatchSet(const MatchSet &other) = delete;
+
+    MatchSet &operator=(const MatchSet &other) = delete;
+
+    /**
+     * Конструктор перемещения
+     *
+     * @param other исходное множество
+     */
+    MatchSet(MatchSet &&other) noexcept;
+
+    /**
+     * Оператор присваивания перемещением
+     *
+     * @param other исходное множество
+     * @return ссылка на это множество
+     */
+    MatchSet &operator=(MatchSet &&other) noexcept;
+
+    /**
+     * Получить размер одной комбинации
+     * @return размер комбинации
+     */
+    int getWidth() const {
+        return width;
+    }
+
+    /**
+     * Получить кол-во комбинаций
+     * @return кол-во комбинаций
+     */
+    long long getSize() const {
+        return cnt;
+    }
+
+    /**
+     * Проверить, пусто ли множество
+     * @return флаг, нет ли в множестве комбинаций
+     */
+    bool isEmpty() const {
+        return cnt == 0;
+    }
+
+    /**
+     * Получить элементы всех комбинаций подряд
+     * @return первый из `getSize() * getWidth()` элементов
+     */
+    const int *getData() const {
+        return buffer.data();
+    }
+
+    /**
+     * Получить комбинацию
+     *
+     * @param i номер комбинации
+     * @return представление комбинации
+     */
+    IntSpan operator[](long long i) const {
+        return IntSpan(buffer.data() + i * width, width);
+    }
+
+    /**
+     * Добавить комбинацию
+     *
+     * @param c элементы комбинации; их должно быть `getWidth()`
+     */
+    void add(const int *c) {
+        buffer.insert(buffer.end(), c, c + width);
+        cnt++;
+    }
+
+    /**
+     * Добавить комбинацию
+     *
+     * @param c комбинация
+     */
+    void add(IntSpan c) {
+        if (c.size() != width)
+            throw std::invalid_argument(
+                    "MatchSet::add() combination size is not acceptable: " + std::to_string(c.size())
+            );
+        add(c.data());
+    }
+
+    /**
+     * Добавить все комбинации другого множества того же размера
+     *
+     * @param other другое множество
+     */
+    void append(const MatchSet &other);
+
+    /**
+     * Зарезервировать память под комбинации
+     *
+     * @param count кол-во комбинаций, которые множество должно вместить без новых выделений памяти
+     */
+    void reserve(long long count);
+
+    /**
+     * Удалить все комбинации, сохранив выделенную память
+     */
+    void clear() {
+        buffer.clear();
+        cnt = 0;
+    }
+
+    /**
+     * Начало множества для цикла по диапазону
+     * @return итератор на первую комбинацию
+     */
+    Iterator begin() const {
+        return Iterator(buffer.data(), 0, width);
+    }
+
+    /**
+     * Конец множества для цикла по диапазону
+     * @return итератор за последней комбинацией
+     */
+    Iterator end() const {
+        return Iterator(nullptr, cnt, width);
+    }
+
+    /**
+     * Получить комбинации в виде списка последовательностей
+     * @return список комбинаций в том же порядке
+     */
+    std::vector<CombinatoricsData> toCombinations() const;
+};
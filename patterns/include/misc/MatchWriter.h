@@ -0,0 +1,282 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <exception>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+#include "IntSpan.h"
+#include "MatchSet.h"
+
+/**
+ * Формат файла найденных комбинаций
+ */
+enum MatchFormat {
+    /**
+     * Текст: по одной комбинации на строку, элементы через пробел (как у `writeCombinations`)
+     */
+    MATCH_TEXT = 0,
+    /**
+     * Двоичный: элементы 32-битными числами
+     */
+    MATCH_BINARY = 1,
+    /**
+     * Двоичный сжатый: каждый элемент - разность с тем же элементом предыдущей
+     * комбинации блока в зигзаг-кодировке переменной длины (varint)
+     */
+    MATCH_DELTA = 2
+};
+
+/**
+ * Сигнатура двоичного файла комбинаций
+ */
+extern const char MATCH_MAGIC[8];
+
+/**
+ * Заголовок двоичного файла комбинаций
+ *
+ * За заголовком идут блоки: кол-во комбинаций блока и кол-во байт его данных
+ * (два 32-битных числа), затем данные. Разности сжатого формата считаются
+ * внутри блока, поэтому блоки декодируются независимо
+ */
+struct MatchFileHeader {
+    /**
+     * Текущая версия формата
+     */
+    static const uint32_t VERSION = 1;
+    /**
+     * Кол-во комбинаций незакрытого файла
+     */
+    static const uint64_t UNKNOWN_COUNT = ~0ULL;
+
+    /**
+     * Сигнатура файла
+     */
+    char magic[8];
+    /**
+     * Версия формата
+     */
+    uint32_t version;
+    /**
+     * Формат: `MATCH_BINARY` или `MATCH_DELTA`
+     */
+    uint32_t format;
+    /**
+     * Размер одной комбинации
+     */
+    uint32_t width;
+    /**
+     * Не используется; выравнивает следующее поле
+     */
+    uint32_t reserved;
+    /**
+     * Кол-во комбинаций; записывается при закрытии файла
+     */
+    uint64_t count;
+};
+
+/**
+ * Асинхронная запись найденных комбинаций в файл
+ *
+ * Потоки поиска (производители) складывают комбинации каждый в свой буфер без
+ * блокировок. Заполненный буфер передаётся в очередь отдельному потоку записи,
+ * который кодирует и записывает его, а затем возвращает пустой буфер производителям.
+ * Буферов ограниченное число, поэтому память не растёт с кол-вом комбинаций:
+ * если запись не успевает за поиском, производитель ждёт освобождения буфера.
+ *
+ * Комбинации одного производителя записываются в порядке добавления, комбинации
+ * разных производителей перемежаются блоками
+ */
+class MatchWriter {
+    /**
+     * Размер одной комбинации
+     */
+    int width;
+    /**
+     * Формат файла
+     */
+    MatchFormat format;
+    /**
+     * Кол-во комбинаций в буфере, после которого он передаётся на запись
+     */
+    int bufferCapacity;
+    /**
+     * Поток вывода; после запуска им пользуется только поток записи
+     */
+    std::ofstream out;
+    /**
+     * Путь к файлу для сообщений об ошибках
+     */
+    std::string path;
+
+    /**
+     * Все буферы
+     */
+    std::vector<std::unique_ptr<MatchSet>> storage;
+    /**
+     * Текущие буферы производителей
+     */
+    std::vector<MatchSet *> current;
+    /**
+     * Заполненные буферы в порядке передачи на запись
+     */
+    std::deque<MatchSet *> fullBuffers;
+    /**
+     * Свободные буферы
+     */
+    std::vector<MatchSet *> freeBuffers;
+    /**
+     * Мьютекс очередей буферов
+     */
+    std::mutex mutex;
+    /**
+     * Сигнал потоку записи, что появился заполненный буфер или запись завершается
+     */
+    std::condition_variable hasFull;
+    /**
+     * Сигнал производителям, что появился свободный буфер
+     */
+    std::condition_variable hasFree;
+    /**
+     * Флаг, что новых буферов не будет
+     */
+    bool closing;
+    /**
+     * Флаг, что запись уже завершена; после этого добавлять комбинации нельзя
+     */
+    std::atomic<bool> closed;
+    /**
+     * Флаг, что запись завершилась ошибкой; дальнейшие комбинации отбрасываются
+     */
+    std::atomic<bool> failed;
+    /**
+     * Ошибка потока записи
+     */
+    std::exception_ptr error;
+    /**
+     * Кол-во записанных комбинаций
+     */
+    long long written;
+    /**
+     * Поток записи
+     */
+    std::thread writer;
+
+    /**
+     * Передать буфер на запись
+     *
+     * @param buffer заполненный буфер
+     * @param wait   флаг, нужно ли дождаться и вернуть свободный буфер
+     * @return свободный буфер или `nullptr`, если `wait == false`
+     */
+    MatchSet *submit(MatchSet *buffer, bool wait);
+
+    /**
+     * Основной цикл потока записи
+     */
+    void drain();
+
+    /**
+     * Закодировать и записать буфер
+     *
+     * @param buffer     буфер
+     * @param bytes      байты закодированного блока; память переиспользуется между вызовами
+     */
+    void writeBlock(const MatchSet &buffer, std::string &bytes);
+
+public:
+    /**
+     * Конструктор; открывает файл и запускает поток записи
+     *
+     * @param path           путь к файлу
+     * @param width          размер одной комбинации
+     * @param producerCount  кол-во производителей
+     * @param format         формат файла
+     * @param bufferCapacity кол-во комбинаций в одном буфере
+     * @param queueLength    кол-во заполненных буферов, которые могут ждать записи; вместе с
+     *                       буферами производителей ограничивает память записи
+     */
+    MatchWriter(const std::string &path, int width, int producerCount, MatchFormat format = MATCH_DELTA,
+                int bufferCapacity = 4096, int queueLength = 4);
+
+    MatchWriter(const MatchWriter &other) = delete;
+
+    MatchWriter &operator=(const MatchWriter &other) = delete;
+
+    /**
+     * Деструктор; завершает запись, если `close()` не был вызван, и игнорирует её ошибки
+     */
+    ~MatchWriter();
+
+    /**
+     * Получить размер одной комбинации
+     * @return размер комбинации
+     */
+    int getWidth() const {
+        return width;
+    }
+
+    /**
+     * Получить кол-во производителей
+     * @return кол-во производителей
+     */
+    int getProducerCount() const {
+        return (int) current.size();
+    }
+
+    /**
+     * Добавить комбинацию
+     *
+     * Один номер производителя нельзя использовать одновременно из разных потоков
+     *
+     * @param producer номер производителя
+     * @param c        элементы комбинации; их должно быть `getWidth()`
+     * @return флаг, что запись идёт без ошибок; `false` означает, что поиск можно останавливать
+     */
+    bool add(int producer, const int *c) {
+        if (producer < 0 || producer >= (int) current.size())
+            throw std::invalid_argument(
+                    "MatchWriter::add() producer is not acceptable: " + std::to_string(producer)
+            );
+        // после закрытия поток записи завершён, и заполненный буфер ждал бы его вечно
+        if (closed.load(std::memory_order_relaxed))
+            throw std::invalid_argument("MatchWriter::add() writer is closed: " + path);
+        MatchSet *buffer = current[producer];
+        buffer->add(c);
+        if (buffer->getSize() >= bufferCapacity)
+            current[producer] = submit(buffer, true);
+        return !failed.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * Добавить комбинацию
+     *
+     * @param producer номер производителя
+     * @param c        комбинация
+     * @return флаг, что запись идёт без ошибок; `false` означает, что поиск можно останавливать
+     */
+    bool add(int producer, IntSpan c) {
+        if (c.size() != width)
+            throw std::invalid_argument(
+                    "MatchWriter::add() combination size is not acceptable: " + std::to_string(c.size())
+            );
+        return add(producer, c.data());
+    }
+
+    /**
+     * Записать остатки буферов, дождаться потока записи и закрыть файл
+     *
+     * Вызывается, когда все производители закончили работу. Ошибка записи
+     * выбрасывается отсюда
+     *
+     * @return кол-во записанных комбинаций
+     */
+    long long close();
+};
@@ -0,0 +1,186 @@
+#pragma once
+
+#include <string>
+#include <stdexcept>
+
+/**
+ * Квадратная матрица, хранящая все элементы одним непрерывным блоком памяти;
+ * Строки расположены друг за другом с шагом `stride`, начало каждой строки
+ * выровнено по границе кэш-линии (если включено дополнение строк), поэтому
+ * обращение к элементу - это одно умножение и одно сложение вместо двух
+ * разыменований указателей, как у `int **`
+ *
+ * Матрица может как владеть своей памятью, так и быть представлением
+ * чужого буфера (например, отображённого в память файла)
+ */
+class Matrix {
+    /**
+     * Выравнивание начала строк в байтах
+     */
+    static const int ALIGNMENT = 64;
+    /**
+     * Выделенный блок памяти; `nullptr`, если матрица не владеет данными
+     */
+    int *buffer;
+    /**
+     * Выровненное начало первой строки
+     */
+    int *data;
+    /**
+     * Размер стороны матрицы
+     */
+    int sz;
+    /**
+     * Расстояние между началами соседних строк в элементах
+     */
+    int stride;
+
+    /**
+     * Выделить память под матрицу и заполнить её нулями
+     *
+     * @param sz      размер стороны матрицы
+     * @param padding флаг, нужно ли дополнять строки до размера, кратного кэш-линии
+     */
+    void allocate(int sz, bool padding);
+
+public:
+    /**
+     * Конструктор пустой матрицы
+     */
+    Matrix();
+
+    /**
+     * Конструктор нулевой матрицы
+     *
+     * @param sz      размер стороны матрицы
+     * @param padding флаг, нужно ли дополнять строки до размера, кратного кэш-линии
+     */
+    explicit Matrix(int sz, bool padding = true);
+
+    /**
+     * Конструктор копии матрицы в формате `int **`
+     *
+     * @param source  исходная матрица
+     * @param sz      размер стороны матрицы
+     * @param padding флаг, нужно ли дополнять строки до размера, кратного кэш-линии
+     */
+    Matrix(int **source, int sz, bool padding = true);
+
+    /**
+     * Конструктор представления чужого буфера; матрица не владеет памятью
+     * и не освобождает её
+     *
+     * @param data   начало первой строки
+     * @param sz     размер стороны матрицы
+     * @param stride расстояние между началами соседних строк в элементах
+     */
+    Matrix(int *data, int sz, int stride);
+
+    /**
+     * Конструктор копирования; копия всегда владеет своей памятью
+     *
+     * @param other исходная матрица
+     */
+    Matrix(const Matrix &other);
+
+    /**
+     * Конструктор перемещения
+     *
+     * @param other исходная матрица
+     */
+    Matrix(Matrix &&other) noexcept;
+
+    /**
+     * Оператор присваивания
+     *
+     * @param other исходная матрица
+     * @return ссылка на эту матрицу
+     */
+    Matrix &operator=(Matrix other) noexcept;
+
+    /**
+     * Деструктор
+     */
+    ~Matrix();
+
+    /**
+     * Получить размер стороны матрицы
+     * @return размер стороны матрицы
+     */
+    int getSize() const {
+        return sz;
+    }
+
+    /**
+     * Получить расстояние между началами соседних строк
+     * @return расстояние между началами соседних строк в элементах
+     */
+    int getStride() const {
+        return stride;
+    }
+
+    /**
+     * Получить начало первой строки
+     * @return начало первой строки
+     */
+    int *getData() {
+        return data;
+    }
+
+    /**
+     * Получить начало первой строки
+     * @return начало первой строки
+     */
+    const int *getData() const {
+        return data;
+    }
+
+    /**
+     * Получить строку матрицы
+     *
+     * @param i номер строки
+     * @return указатель на начало строки
+     */
+    int *getRow(int i) {
+        return data + (long long) i * stride;
+    }
+
+    /**
+     * Получить строку матрицы
+     *
+     * @param i номер строки
+     * @return указатель на начало строки
+     */
+    const int *getRow(int i) const {
+        return data + (long long) i * stride;
+    }
+
+    /**
+     * Получить элемент матрицы
+     *
+     * @param i номер строки
+     * @param j номер столбца
+     * @return элемент матрицы
+     */
+    int get(int i, int j) const {
+        return data[(long long) i * stride + j];
+    }
+
+    /**
+     * Задать элемент матрицы
+     *
+     * @param i     номер строки
+     * @param j     номер столбца
+     * @param value новое значение
+     */
+    void set(int i, int j, int value) {
+        data[(long long) i * stride + j] = value;
+    }
+
+    /**
+     * Получить копию матрицы в формате `int **`
+     *
+     * @return копия матрицы
+     */
+    int **toArray() const;
+};
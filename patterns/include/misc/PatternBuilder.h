@@ -1,18 +1,32 @@
 #pragma once
 
 #include <stdexcept>
+#include <vector>
 #include "CombinatoricsData.h"
+#include "GraphGenerator.h"
+#include "MatchSet.h"
+#include "Matrix.h"
 
 /**
  * Построитель паттернов
+ *
+ * Занятость ячеек хранится разреженно: для каждой строки - список занятых столбцов,
+ * поэтому память пропорциональна кол-ву ячеек, занятых паттернами, а не квадрату
+ * размера матрицы. Паттерн, добавленный в комбинацию вершин, меняет только ячейки
+ * на пересечении строк и столбцов этих вершин, поэтому паттерны с непересекающимися
+ * множествами вершин можно добавлять одновременно из разных потоков
  */
 class PatternBuilder {
     /**
-     * матрица флагов, не занята ли точка каким-то паттерном
-     * каждое добавления паттерна соответствующие ячейки заполняются
-     * значениями `true`
+     * Занятые паттернами ячейки: для каждой строки - номера занятых столбцов по возрастанию;
+     * при каждом добавлении паттерна в списки попадают соответствующие ячейки
      */
-    bool **isModified;
+    std::vector<std::vector<int>> occupied;
+    /**
+     * Указатели на строки матрицы-результата, если построитель создан по `Matrix`;
+     * иначе пустой, и строки принадлежат вызывающему коду
+     */
+    std::vector<int *> rows;
     /**
      * Текущая матрица связности
      */
@@ -21,6 +35,21 @@ class PatternBuilder {
      * Размер стороны матрицы
      */
     int sz;
+
+    /**
+     * Добавить паттерн, если он не противоречит уже добавленным
+     *
+     * Читает и меняет только строки с номерами из комбинации, поэтому вызовы
+     * с непересекающимися комбинациями можно выполнять одновременно
+     *
+     * @param pattern     строки паттерна
+     * @param size        размер стороны паттерна
+     * @param combination вершины результирующей матрицы, в которые нужно добавить паттерн;
+     *                    `i`-ая вершина паттерна переходит в `combination[i]`
+     * @return флаг, получилось ли добавить
+     */
+    bool tryPut(const int *const *pattern, int size, const int *combination);
+
 public:
     /**
      * Конструктор
@@ -30,11 +59,42 @@ public:
      */
     PatternBuilder(int **data, int sz);
 
+    /**
+     * Конструктор; паттерны добавляются прямо в переданную матрицу
+     *
+     * @param data матрица-результат
+     */
+    explicit PatternBuilder(Matrix &data);
+
+    /**
+     * Конструктор копирования; копия строится по той же матрице-результату
+     *
+     * @param other построитель
+     */
+    PatternBuilder(const PatternBuilder &other);
+
+    /**
+     * Оператор присваивания
+     *
+     * @param other построитель
+     * @return ссылка на этот построитель
+     */
+    PatternBuilder &operator=(PatternBuilder other) noexcept;
+
     /**
      * Получить матрицу связности
      */
     int **getData();
 
+    /**
+     * Проверить, занята ли ячейка каким-то паттерном
+     *
+     * @param i номер строки
+     * @param j номер столбца
+     * @return флаг, занята ли ячейка
+     */
+    bool isOccupied(int i, int j) const;
+
     /**
      * Добавить паттерн
      *
@@ -44,5 +104,25 @@ public:
      * @return флаг, получилось ли добавить
      */
     bool putPattern(int **pattern, int size, CombinatoricsData combinatoricsData);
-};
 
+    /**
+     * Добавить много копий паттерна в случайные комбинации вершин
+     *
+     * Добавление идёт раундами: в каждом раунде случайная перестановка вершин режется
+     * на непересекающиеся комбинации размера паттерна, которые добавляются параллельно;
+     * комбинации, противоречащие паттернам прошлых раундов, отбрасываются. Т.к. внутри
+     * раунда комбинации не пересекаются, результат зависит только от генератора, но не
+     * от кол-ва потоков
+     *
+     * @param pattern     паттерн
+     * @param count       кол-во копий паттерна
+     * @param generator   генератор случайных перестановок
+     * @param threadCount кол-во потоков
+     * @param maxRounds   максимальное кол-во раундов; ограничивает работу, если плотно
+     *                    занятая матрица не принимает новых копий
+     * @return добавленные комбинации: `i`-ая вершина паттерна переходит в `i`-ый элемент
+     *         комбинации; комбинаций может оказаться меньше `count`, если не хватило раундов
+     */
+    MatchSet plantPatterns(const Matrix &pattern, int count, GraphGenerator &generator, int threadCount = 1,
+                           int maxRounds = 100);
+};
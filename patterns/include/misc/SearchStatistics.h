@@ -0,0 +1,246 @@
+#pragma once
+
+#include <chrono>
+#include <vector>
+
+/**
+ * Статистика перебора быстрого поиска
+ *
+ * Считает узлы дерева перебора по глубинам, отсечения по причинам, найденные вхождения
+ * и время построения поиска и самого перебора. Счётчики ведутся, только если библиотека
+ * собрана с опцией `PATTERNS_SEARCH_STATISTICS`: иначе методы записи пустые, вызовы
+ * в горячих циклах перебора исчезают при компиляции, а все счётчики остаются нулевыми
+ *
+ * Объект не потокобезопасен: при многопоточном переборе каждый поток ведёт свою
+ * статистику, а в конце они объединяются методом `merge()`
+ */
+class SearchStatistics {
+public:
+    /**
+     * Причина отсечения
+     */
+    enum PruneReason {
+        /**
+         * Вершина не попала в начальный домен точки: не совпал диагональный элемент
+         */
+        DIAGONAL,
+        /**
+         * Вершина не попала в начальный домен точки: у неё меньше рёбер какого-то вида, чем у точки
+         */
+        DEGREE,
+        /**
+         * После выбора вершины прямая проверка опустошила домен одной из следующих точек
+         */
+        EMPTY_DOMAIN,
+        /**
+         * Заданный префикс комбинации (начальная задача, позиция ребра) не совместим с паттерном
+         */
+        PREFIX,
+        /**
+         * Кол-во причин
+         */
+        REASONS_COUNT
+    };
+
+    /**
+     * Замер времени одной фазы; при выключенной статистике часы не опрашиваются
+     */
+    class Timer {
+#ifdef PATTERNS_SEARCH_STATISTICS
+        /**
+         * Момент начала замера
+         */
+        std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+#endif
+    public:
+        /**
+         * Получить время с начала замера
+         * @return время в микросекундах
+         */
+        double getElapsed() const {
+#ifdef PATTERNS_SEARCH_STATISTICS
+            return (double) std::chrono::duration_cast<std::chrono::nanoseconds>(
+                    std::chrono::steady_clock::now() - start
+            ).count() / 1000.0;
+#else
+            return 0;
+#endif
+        }
+    };
+
+private:
+    /**
+     * Кол-во узлов дерева перебора на каждой глубине: вершин, сопоставленных точке на этой глубине
+     */
+    std::vector<long long> nodes;
+    /**
+     * Кол-во отсечений по каждой причине
+     */
+    long long prunes[REASONS_COUNT] = {};
+    /**
+     * Кол-во найденных вхождений
+     */
+    long long matches = 0;
+    /**
+     * Время построения поиска в микросекундах
+     */
+    double buildTime = 0;
+    /**
+     * Время перебора в микросекундах
+     */
+    double searchTime = 0;
+
+public:
+    /**
+     * Проверить, ведётся ли статистика в этой сборке
+     * @return флаг, собрана ли библиотека с опцией `PATTERNS_SEARCH_STATISTICS`
+     */
+    static bool isEnabled() {
+#ifdef PATTERNS_SEARCH_STATISTICS
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    /**
+     * Учесть узлы дерева перебора
+     *
+     * @param depth глубина
+     * @param cnt   кол-во узлов
+     */
+    void addNodes(int depth, long long cnt = 1) {
+#ifdef PATTERNS_SEARCH_STATISTICS
+        if (depth >= (int) nodes.size())
+            nodes.resize(depth + 1, 0);
+        nodes[depth] += cnt;
+#else
+        (void) depth;
+        (void) cnt;
+#endif
+    }
+
+    /**
+     * Учесть отсечения
+     *
+     * @param reason причина отсечения
+     * @param cnt    кол-во отсечений
+     */
+    void addPrunes(PruneReason reason, long long cnt = 1) {
+#ifdef PATTERNS_SEARCH_STATISTICS
+        prunes[reason] += cnt;
+#else
+        (void) reason;
+        (void) cnt;
+#endif
+    }
+
+    /**
+     * Учесть найденные вхождения
+     *
+     * @param cnt кол-во вхождений
+     */
+    void addMatches(long long cnt = 1) {
+#ifdef PATTERNS_SEARCH_STATISTICS
+        matches += cnt;
+#else
+        (void) cnt;
+#endif
+    }
+
+    /**
+     * Учесть время построения поиска
+     *
+     * @param time время в микросекундах
+     */
+    void addBuildTime(double time) {
+#ifdef PATTERNS_SEARCH_STATISTICS
+        buildTime += time;
+#else
+        (void) time;
+#endif
+    }
+
+    /**
+     * Учесть время перебора
+     *
+     * @param time время в микросекундах
+     */
+    void addSearchTime(double time) {
+#ifdef PATTERNS_SEARCH_STATISTICS
+        searchTime += time;
+#else
+        (void) time;
+#endif
+    }
+
+    /**
+     * Получить кол-во глубин, на которых были узлы
+     * @return кол-во глубин
+     */
+    int getDepthsCount() const {
+        return (int) nodes.size();
+    }
+
+    /**
+     * Получить кол-во узлов дерева перебора на глубине
+     *
+     * @param depth глубина
+     * @return кол-во узлов; `0` для глубин, на которых узлов не было
+     */
+    long long getNodes(int depth) const {
+        return depth >= 0 && depth < (int) nodes.size() ? nodes[depth] : 0;
+    }
+
+    /**
+     * Получить кол-во узлов дерева перебора на всех глубинах
+     * @return кол-во узлов
+     */
+    long long getTotalNodes() const;
+
+    /**
+     * Получить кол-во отсечений по причине
+     *
+     * @param reason причина отсечения
+     * @return кол-во отсечений
+     */
+    long long getPrunes(PruneReason reason) const {
+        return prunes[reason];
+    }
+
+    /**
+     * Получить кол-во найденных вхождений
+     * @return кол-во вхождений
+     */
+    long long getMatches() const {
+        return matches;
+    }
+
+    /**
+     * Получить время построения поиска
+     * @return время в микросекундах
+     */
+    double getBuildTime() const {
+        return buildTime;
+    }
+
+    /**
+     * Получить время перебора
+     * @return время в микросекундах
+     */
+    double getSearchTime() const {
+        return searchTime;
+    }
+
+    /**
+     * Добавить к статистике счётчики другой статистики
+     *
+     * @param other другая статистика
+     */
+    void merge(const SearchStatistics &other);
+
+    /**
+     * Обнулить все счётчики
+     */
+    void clear();
+};
@@ -0,0 +1,219 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Пул задач с перехватом работы
+ *
+ * У каждого потока своя очередь задач: новые задачи поток кладёт в конец своей
+ * очереди и сам берёт их оттуда же (так он продолжает обход в глубину), а
+ * простаивающий поток забирает задачи из начала чужих очередей - там лежат самые
+ * старые и, как правило, самые крупные задачи. Поток, которому не нашлось задачи,
+ * засыпает до появления новой. Пул завершает работу, когда не осталось ни задач
+ * в очередях, ни задач в обработке, или когда обработчик выбросил исключение
+ *
+ * @tparam T тип задачи
+ */
+template<typename T>
+class TaskPool {
+    /**
+     * Очередь задач одного потока
+     */
+    struct Queue {
+        /**
+         * Задачи
+         */
+        std::deque<T> tasks;
+        /**
+         * Блокировка очереди
+         */
+        std::mutex mutex;
+    };
+
+    /**
+     * Очереди задач потоков
+     */
+    std::vector<Queue> queues;
+    /**
+     * Кол-во задач, которые добавлены, но ещё не обработаны
+     */
+    std::atomic<long long> pending;
+    /**
+     * Кол-во задач, лежащих в очередях
+     */
+    std::atomic<long long> queued;
+    /**
+     * Кол-во потоков, которые сейчас ищут задачу
+     */
+    std::atomic<int> idle;
+    /**
+     * Флаг, что обработчик выбросил исключение и оставшиеся задачи обрабатывать не нужно
+     */
+    std::atomic<bool> failed;
+    /**
+     * Первое исключение обработчика
+     */
+    std::exception_ptr error;
+    /**
+     * Мьютекс ожидания задач
+     */
+    std::mutex waitMutex;
+    /**
+     * Сигнал простаивающим потокам: появилась задача, работа закончилась или прервана
+     */
+    std::condition_variable hasWork;
+
+    /**
+     * Разбудить простаивающие потоки
+     *
+     * Условие ожидания проверяется под `waitMutex`, поэтому сигнал отправляется после
+     * захвата мьютекса: поток, который уже проверил условие, к этому моменту ждёт сигнала
+     *
+     * @param all флаг, нужно ли разбудить все потоки, а не один
+     */
+    void notify(bool all) {
+        std::lock_guard<std::mutex> lock(waitMutex);
+        if (all)
+            hasWork.notify_all();
+        else
+            hasWork.notify_one();
+    }
+
+    /**
+     * Дождаться задачи
+     *
+     * @param worker номер потока
+     * @param task   взятая задача
+     * @return флаг, удалось ли взять задачу; `false`, если работа закончилась или прервана
+     */
+    bool waitTask(int worker, T &task) {
+        idle++;
+        bool found = false;
+        while (!found) {
+            {
+                std::unique_lock<std::mutex> lock(waitMutex);
+                hasWork.wait(lock, [this]() {
+                    return queued.load() > 0 || pending.load() == 0 || failed.load();
+                });
+                if (pending.load() == 0 || failed.load())
+                    break;
+            }
+            // задачу мог забрать другой поток, тогда ждём следующую
+            found = tryTake(worker, task);
+        }
+        idle--;
+        return found;
+    }
+
+    /**
+     * Попробовать взять задачу: сначала из конца своей очереди, затем из начала чужих
+     *
+     * @param worker номер потока
+     * @param task   взятая задача
+     * @return флаг, удалось ли взять задачу
+     */
+    bool tryTake(int worker, T &task) {
+        int cnt = (int) queues.size();
+        for (int i = 0; i < cnt; i++) {
+            Queue &queue = queues[(worker + i) % cnt];
+            std::lock_guard<std::mutex> lock(queue.mutex);
+            if (queue.tasks.empty())
+                continue;
+            if (i == 0) {
+                task = std::move(queue.tasks.back());
+                queue.tasks.pop_back();
+            } else {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+            }
+            queued--;
+            return true;
+        }
+        return false;
+    }
+
+public:
+    /**
+     * Конструктор
+     *
+     * @param threadCount кол-во потоков
+     */
+    explicit TaskPool(int threadCount) : queues(threadCount), pending(0), queued(0), idle(0), failed(false) {
+    }
+
+    /**
+     * Добавить задачу в очередь потока
+     *
+     * @param worker номер потока
+     * @param task   задача
+     */
+    void push(int worker, T task) {
+        pending++;
+        {
+            std::lock_guard<std::mutex> lock(queues[worker].mutex);
+            queues[worker].tasks.push_back(std::move(task));
+        }
+        queued++;
+        notify(false);
+    }
+
+    /**
+     * Проверить, есть ли потоки, которым не хватает задач; в этом случае
+     * выгодно отдать часть своей работы в очередь
+     *
+     * @return флаг, есть ли простаивающие потоки
+     */
+    bool isHungry() const {
+        return idle.load(std::memory_order_relaxed) > 0;
+    }
+
+    /**
+     * Запустить обработку задач
+     *
+     * Если обработчик выбросил исключение, задачи, которые ещё не начаты, пропускаются,
+     * а первое исключение выбрасывается отсюда после завершения всех потоков
+     *
+     * @param processor обработчик задачи (int worker, T &task)->{}; может добавлять новые задачи
+     */
+    template<typename F>
+    void run(const F &processor) {
+        auto work = [this, &processor](int worker) {
+            T task;
+            while (!failed.load()) {
+                // задач нет: ждём, пока они появятся или закончится работа
+                if (!tryTake(worker, task) && !waitTask(worker, task))
+                    return;
+                try {
+                    processor(worker, task);
+                } catch (...) {
+                    {
+                        std::lock_guard<std::mutex> lock(waitMutex);
+                        if (!error)
+                            error = std::current_exception();
+                    }
+                    failed = true;
+                    notify(true);
+                    return;
+                }
+                // последняя задача обработана: будим потоки, чтобы они завершились
+                if (--pending == 0)
+                    notify(true);
+            }
+        };
+
+        std::vector<std::thread> threads;
+        for (int i = 1; i < (int) queues.size(); i++)
+            threads.emplace_back(work, i);
+        work(0);
+        for (std::thread &thread: threads)
+            thread.join();
+        if (error)
+            std::rethrow_exception(error);
+    }
+};
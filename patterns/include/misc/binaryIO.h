@@ -0,0 +1,292 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <stdexcept>
+#include "CsrGraph.h"
+#include "Matrix.h"
+
+/**
+ * Заголовок двоичного файла графа
+ *
+ * За заголовком идут секции данных, начало каждой выровнено по 64 байтам:
+ * - плотная матрица (`DENSE`): `vertexCount` строк по `stride` элементов, хвосты строк нулевые;
+ * - разреженный граф (`CSR`): петли (`vertexCount` элементов), смещения исходящих рёбер
+ *   (`vertexCount + 1` 64-битных чисел), их концы и значения (по `edgeCount` элементов),
+ *   затем так же смещения, начала и значения входящих рёбер;
+ * - степени (если выставлен флаг `DEGREES`): кол-во ненулевых исходящих, затем входящих
+ *   рёбер каждой вершины без учёта петель
+ *
+ * Числа записываются в порядке байт машины, записавшей файл; файл с другим порядком
+ * байт отвергается при открытии
+ */
+struct BinaryGraphHeader {
+    /**
+     * Раскладка данных
+     */
+    enum Layout : uint32_t {
+        /**
+         * Плотная матрица связности
+         */
+        DENSE = 0,
+        /**
+         * Списки рёбер в формате CSR
+         */
+        CSR = 1
+    };
+
+    /**
+     * Тип элементов
+     */
+    enum ElementType : uint32_t {
+        /**
+         * 32-битные целые со знаком
+         */
+        INT32 = 0
+    };
+
+    /**
+     * Флаги
+     */
+    enum Flags : uint32_t {
+        /**
+         * Матрица связности симметрична
+         */
+        SYMMETRIC = 1,
+        /**
+         * В файле есть секция степеней вершин
+         */
+        DEGREES = 2
+    };
+
+    /**
+     * Текущая версия формата
+     */
+    static const uint32_t VERSION = 1;
+    /**
+     * Выравнивание секций в байтах
+     */
+    static const uint64_t ALIGNMENT = 64;
+
+    /**
+     * Сигнатура файла
+     */
+    char magic[8];
+    /**
+     * Версия формата
+     */
+    uint32_t version;
+    /**
+     * Метка порядка байт: `0x01020304` в порядке байт записавшей машины
+     */
+    uint32_t byteOrder;
+    /**
+     * Раскладка данных
+     */
+    uint32_t layout;
+    /**
+     * Тип элементов
+     */
+    uint32_t elementType;
+    /**
+     * Флаги
+     */
+    uint32_t flags;
+    /**
+     * Не используется; выравнивает следующие поля
+     */
+    uint32_t reserved;
+    /**
+     * Кол-во вершин
+     */
+    int64_t vertexCount;
+    /**
+     * Расстояние между началами соседних строк плотной матрицы в элементах
+     */
+    int64_t stride;
+    /**
+     * Кол-во ненулевых рёбер без учёта петель
+     */
+    int64_t edgeCount;
+    /**
+     * Смещение секции данных от начала файла
+     */
+    uint64_t payloadOffset;
+    /**
+     * Смещение секции степеней от начала файла; `0`, если её нет
+     */
+    uint64_t degreesOffset;
+    /**
+     * Размер файла в байтах
+     */
+    uint64_t fileSize;
+    /**
+     * Запас под поля следующих версий; дополняет заголовок до 128 байт
+     */
+    uint64_t padding[6];
+};
+
+/**
+ * Граф, открытый из двоичного файла отображением в память
+ *
+ * Данные не читаются и не копируются: матрица и разреженный граф - это
+ * представления отображённой памяти, страницы которой подгружаются
+ * операционной системой при первом обращении, поэтому открытие файла любого
+ * размера занимает время проверки заголовка. Отображение частное: изменения
+ * элементов через `getMatrix()` видны только этому объекту и не попадают в файл.
+ * Представления действительны, пока объект не уничтожен
+ */
+class MappedGraph {
+    /**
+     * Начало отображённой памяти
+     */
+    void *address;
+    /**
+     * Размер отображённой памяти в байтах
+     */
+    std::size_t length;
+    /**
+     * Заголовок файла
+     */
+    BinaryGraphHeader header;
+    /**
+     * Представление плотной матрицы; пустое у разреженного графа
+     */
+    Matrix matrix;
+    /**
+     * Представление разреженного графа; пустое у плотной матрицы
+     */
+    CsrGraph graph;
+    /**
+     * Кол-во ненулевых исходящих рёбер вершин; `nullptr`, если степеней в файле нет
+     */
+    const int *outDegrees;
+    /**
+     * Кол-во ненулевых входящих рёбер вершин; `nullptr`, если степеней в файле нет
+     */
+    const int *inDegrees;
+
+    /**
+     * Получить указатель на данные секции файла
+     *
+     * @param offset смещение от начала файла в байтах
+     * @return указатель на данные
+     */
+    char *at(uint64_t offset) const {
+        return static_cast<char *>(address) + offset;
+    }
+
+public:
+    /**
+     * Конструктор; отображает файл в память и проверяет заголовок
+     *
+     * @param path путь к файлу
+     */
+    explicit MappedGraph(const std::string &path);
+
+    MappedGraph(const MappedGraph &other) = delete;
+
+    MappedGraph &operator=(const MappedGraph &other) = delete;
+
+    /**
+     * Деструктор; снимает отображение
+     */
+    ~MappedGraph();
+
+    /**
+     * Получить кол-во вершин
+     * @return кол-во вершин
+     */
+    int getSize() const {
+        return (int) header.vertexCount;
+    }
+
+    /**
+     * Получить кол-во ненулевых рёбер без учёта петель
+     * @return кол-во рёбер
+     */
+    long long getEdgeCount() const {
+        return header.edgeCount;
+    }
+
+    /**
+     * Проверить, хранится ли граф плотной матрицей
+     * @return флаг, плотная ли раскладка
+     */
+    bool isDense() const {
+        return header.layout == BinaryGraphHeader::DENSE;
+    }
+
+    /**
+     * Проверить, симметрична ли матрица связности
+     * @return флаг симметричности
+     */
+    bool isSymmetric() const {
+        return (header.flags & BinaryGraphHeader::SYMMETRIC) != 0;
+    }
+
+    /**
+     * Проверить, есть ли в файле степени вершин
+     * @return флаг, есть ли степени
+     */
+    bool hasDegrees() const {
+        return outDegrees != nullptr;
+    }
+
+    /**
+     * Получить плотную матрицу
+     * @return представление отображённой матрицы
+     */
+    Matrix &getMatrix();
+
+    /**
+     * Получить плотную матрицу
+     * @return представление отображённой матрицы
+     */
+    const Matrix &getMatrix() const;
+
+    /**
+     * Получить разреженный граф
+     * @return представление отображённого графа
+     */
+    const CsrGraph &getGraph() const;
+
+    /**
+     * Получить кол-во ненулевых исходящих рёбер вершин без учёта петель
+     * @return `getSize()` степеней
+     */
+    const int *getOutDegrees() const;
+
+    /**
+     * Получить кол-во ненулевых входящих рёбер вершин без учёта петель
+     * @return `getSize()` степеней
+     */
+    const int *getInDegrees() const;
+};
+
+/**
+ * Проверить, начинается ли файл с сигнатуры двоичного формата графа
+ *
+ * @param path путь к файлу
+ * @return флаг, двоичный ли файл; `false`, если файл не удалось открыть
+ */
+bool isBinaryGraphFile(const std::string &path);
+
+/**
+ * Записать плотную матрицу в двоичном формате
+ *
+ * @param path    путь к файлу
+ * @param matrix  матрица
+ * @param degrees флаг, нужно ли записать степени вершин
+ */
+void writeBinaryMatrix(const std::string &path, const Matrix &matrix, bool degrees = true);
+
+/**
+ * Записать разреженный граф в двоичном формате
+ *
+ * @param path    путь к файлу
+ * @param graph   граф
+ * @param degrees флаг, нужно ли записать степени вершин
+ */
+void writeBinaryGraph(const std::string &path, const CsrGraph &graph, bool degrees = true);
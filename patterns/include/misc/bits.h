@@ -0,0 +1,189 @@
+#pragma once
+
+#include <cstdint>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif
+
+/**
+ * Получить кол-во 64-битных слов, нужных для хранения заданного кол-ва битов
+ *
+ * @param n кол-во битов
+ * @return кол-во слов
+ */
+inline int wordsCount(int n) {
+    return (n + 63) / 64;
+}
+
+/**
+ * Получить кол-во единичных битов в слове
+ *
+ * @param word слово
+ * @return кол-во единичных битов
+ */
+inline int popCount(uint64_t word) {
+#ifdef _MSC_VER
+    return (int) __popcnt64(word);
+#else
+    return __builtin_popcountll(word);
+#endif
+}
+
+/**
+ * Получить номер младшего единичного бита в ненулевом слове
+ *
+ * @param word слово
+ * @return номер младшего единичного бита
+ */
+inline int lowestBit(uint64_t word) {
+#ifdef _MSC_VER
+    unsigned long index;
+    _BitScanForward64(&index, word);
+    return (int) index;
+#else
+    return __builtin_ctzll(word);
+#endif
+}
+
+/**
+ * Получить кол-во единичных битов в битовом массиве
+ *
+ * @param words битовый массив
+ * @param cnt   кол-во слов в массиве
+ * @return кол-во единичных битов
+ */
+inline int countBits(const uint64_t *words, int cnt) {
+    int res = 0;
+    for (int w = 0; w < cnt; w++)
+        res += popCount(words[w]);
+    return res;
+}
+
+/**
+ * Проверить, установлен ли бит
+ *
+ * @param words битовый массив
+ * @param i     номер бита
+ * @return флаг, установлен ли бит
+ */
+inline bool testBit(const uint64_t *words, int i) {
+    return (words[i >> 6] >> (i & 63)) & 1;
+}
+
+/**
+ * Установить бит
+ *
+ * @param words битовый массив
+ * @param i     номер бита
+ */
+inline void setBit(uint64_t *words, int i) {
+    words[i >> 6] |= (uint64_t) 1 << (i & 63);
+}
+
+/**
+ * Сбросить бит
+ *
+ * @param words битовый массив
+ * @param i     номер бита
+ */
+inline void clearBit(uint64_t *words, int i) {
+    words[i >> 6] &= ~((uint64_t) 1 << (i & 63));
+}
+
+/**
+ * Сбросить все биты с номерами от нуля до заданного включительно
+ *
+ * @param words битовый массив
+ * @param i     номер последнего сбрасываемого бита
+ */
+inline void clearBitsUpTo(uint64_t *words, int i) {
+    int w = i >> 6;
+    for (int k = 0; k < w; k++)
+        words[k] = 0;
+    // в слове с i-ым битом оставляем только биты старше него
+    words[w] &= (i & 63) == 63 ? 0 : ~(((uint64_t) 2 << (i & 63)) - 1);
+}
+
+/**
+ * Сбросить все биты начиная с заданного
+ *
+ * @param words битовый массив
+ * @param cnt   кол-во слов в массиве
+ * @param i     номер первого сбрасываемого бита
+ */
+inline void clearBitsFrom(uint64_t *words, int cnt, int i) {
+    int w = i >> 6;
+    // в слове с i-ым битом оставляем только биты младше него
+    words[w] &= ((uint64_t) 1 << (i & 63)) - 1;
+    for (int k = w + 1; k < cnt; k++)
+        words[k] = 0;
+}
+
+/**
+ * Перебрать все установленные биты в порядке возрастания их номеров
+ *
+ * @param words    битовый массив
+ * @param cnt      кол-во слов в массиве
+ * @param consumer обработчик номера каждого установленного бита (int i)->{}
+ */
+template<typename F>
+void forEachBit(const uint64_t *words, int cnt, const F &consumer) {
+    for (int w = 0; w < cnt; w++) {
+        uint64_t word = words[w];
+        // пока в слове остались единичные биты
+        while (word) {
+            // обрабатываем младший из них
+            consumer((w << 6) + lowestBit(word));
+            // и сбрасываем его
+            word &= word - 1;
+        }
+    }
+}
+
+/**
+ * Перебрать установленные биты в порядке возрастания их номеров, пока обработчик
+ * не попросит остановиться
+ *
+ * @param words    битовый массив
+ * @param cnt      кол-во слов в массиве
+ * @param consumer обработчик номера каждого установленного бита (int i)->bool;
+ *                 возвращает `false`, если перебор нужно остановить
+ * @return флаг, были ли перебраны все биты
+ */
+template<typename F>
+bool forEachBitWhile(const uint64_t *words, int cnt, const F &consumer) {
+    for (int w = 0; w < cnt; w++) {
+        uint64_t word = words[w];
+        while (word) {
+            if (!consumer((w << 6) + lowestBit(word)))
+                return false;
+            word &= word - 1;
+        }
+    }
+    return true;
+}
+
+/**
+ * Пересечь битовый массив с другим битовым массивом
+ *
+ * @param words битовый массив, в который записывается результат
+ * @param other второй битовый массив
+ * @param cnt   кол-во слов в массивах
+ */
+inline void andWords(uint64_t *words, const uint64_t *other, int cnt) {
+    for (int w = 0; w < cnt; w++)
+        words[w] &= other[w];
+}
+
+/**
+ * Пересечь битовый массив с дополнением другого битового массива
+ *
+ * @param words битовый массив, в который записывается результат
+ * @param other второй битовый массив
+ * @param cnt   кол-во слов в массивах
+ */
+inline void andNotWords(uint64_t *words, const uint64_t *other, int cnt) {
+    for (int w = 0; w < cnt; w++)
+        words[w] &= ~other[w];
+}
@@ -4,7 +4,9 @@
 #include <unordered_set>
 #include <random>
 #include <algorithm>
+#include <vector>
 #include "CombinatoricsData.h"
+#include "Matrix.h"
 
 /**
  * Шаг перебора комбинаций
@@ -32,8 +34,82 @@ void combine(int n, int k, const F &consumer) {
         throw std::invalid_argument(
                 "combine() arr size: " + std::to_string(n) + " elements count " + std::to_string(k)
         );
+    // буфер комбинации освобождается после перебора
+    std::vector<int> combination(k);
     // запускаем первый шаг перебора комбинаций
-    combineStep(new int[k], k, 0, n - 1, 0, consumer);
+    combineStep(combination.data(), k, 0, n - 1, 0, consumer);
+}
+
+/**
+ * Получить биномиальный коэффициент - кол-во комбинаций из `n` элементов по `k`
+ *
+ * @param n общее число элементов
+ * @param k размер комбинации
+ * @return кол-во комбинаций; `0`, если `k < 0` или `k > n`
+ * @throws std::overflow_error если кол-во не помещается в `long long`
+ */
+long long binomial(int n, int k);
+
+/**
+ * Получить номер возрастающей комбинации в порядке перебора `combine()` (лексикографическом)
+ *
+ * @param c возрастающая комбинация
+ * @param n общее число элементов
+ * @param k размер комбинации
+ * @return номер комбинации, от `0` до `binomial(n, k) - 1`
+ */
+long long rankCombination(const int *c, int n, int k);
+
+/**
+ * Получить возрастающую комбинацию по её номеру в порядке перебора `combine()`
+ *
+ * @param rank номер комбинации, от `0` до `binomial(n, k) - 1`
+ * @param n    общее число элементов
+ * @param k    размер комбинации
+ * @param c    массив из `k` элементов, в который записывается комбинация
+ */
+void unrankCombination(long long rank, int n, int k, int *c);
+
+/**
+ * Перейти к следующей возрастающей комбинации в порядке перебора `combine()`
+ *
+ * @param c возрастающая комбинация; заменяется следующей
+ * @param n общее число элементов
+ * @param k размер комбинации
+ * @return флаг, есть ли следующая комбинация; если нет, `c` не меняется
+ */
+bool nextCombination(int *c, int n, int k);
+
+/**
+ * Запустить перебор части комбинаций: с номера `fromRank` включительно до `toRank` не включительно
+ *
+ * Номера комбинаций те же, что и у `rankCombination`, поэтому перебор можно разбить
+ * на части равного размера между потоками или процессами и продолжить с известного номера
+ *
+ * @param n        общее число элементов
+ * @param k        размер комбинации
+ * @param fromRank номер первой комбинации
+ * @param toRank   номер комбинации за последней
+ * @param consumer обработчик для каждой найденной комбинации (const int *c)->{}
+ */
+template<typename F>
+void combineRange(int n, int k, long long fromRank, long long toRank, const F &consumer) {
+    long long total = binomial(n, k);
+    if (k < 0 || k > n || fromRank < 0 || fromRank > toRank || toRank > total)
+        throw std::invalid_argument(
+                "combineRange() range is not acceptable: n " + std::to_string(n) + " k " + std::to_string(k) +
+                " from " + std::to_string(fromRank) + " to " + std::to_string(toRank)
+        );
+    if (fromRank == toRank)
+        return;
+
+    std::vector<int> combination(k);
+    unrankCombination(fromRank, n, k, combination.data());
+    // от первой комбинации двигаемся по порядку перебора
+    for (long long rank = fromRank; rank < toRank; rank++) {
+        consumer(combination.data());
+        nextCombination(combination.data(), n, k);
+    }
 }
 
 /**
@@ -83,6 +159,98 @@ void generatePermutations(int size, const F &consumer) {
     generatePermutationsStep(size, startP, 0, consumer);
 }
 
+/**
+ * Итеративный генератор перестановок с отсечением по префиксу
+ *
+ * Перестановки строятся по одному элементу слева направо в лексикографическом порядке;
+ * после выбора каждого элемента вызывается проверка префикса, и если она не пройдена,
+ * все перестановки с этим префиксом пропускаются. Поэтому время работы пропорционально
+ * кол-ву допустимых префиксов, а не `size!`. Буферы заводятся один раз в конструкторе,
+ * так что один генератор можно запускать многократно без выделения памяти
+ */
+class PermutationGenerator {
+    /**
+     * Текущая перестановка
+     */
+    std::vector<int> p;
+    /**
+     * Для каждой позиции - следующий элемент, который на ней нужно попробовать
+     */
+    std::vector<int> next;
+    /**
+     * Флаги, занят ли элемент в текущем префиксе
+     */
+    std::vector<char> used;
+
+public:
+    /**
+     * Конструктор
+     *
+     * @param size количество элементов перестановки
+     */
+    explicit PermutationGenerator(int size) : p(size), next(size), used(size) {
+    }
+
+    /**
+     * Запустить генерацию перестановок
+     *
+     * Как и у `generatePermutations`, при нулевом размере перестановок нет
+     *
+     * @param isValidPrefix проверка префикса (const int *p, int pos)->bool: элементы `p[0..pos-1]`
+     *                      уже проверены, нужно проверить только `p[pos]` вместе с ними
+     * @param consumer      обработчик перестановки, все префиксы которой допустимы (int *p)->{}
+     */
+    template<typename V, typename F>
+    void run(const V &isValidPrefix, const F &consumer) {
+        int size = (int) p.size();
+        if (size == 0)
+            return;
+        for (int i = 0; i < size; i++)
+            used[i] = false;
+
+        int pos = 0;
+        next[0] = 0;
+        while (pos >= 0) {
+            // ищем на текущей позиции следующий свободный элемент с допустимым префиксом
+            bool placed = false;
+            for (; next[pos] < size && !placed; next[pos]++) {
+                if (used[next[pos]])
+                    continue;
+                p[pos] = next[pos];
+                placed = isValidPrefix((const int *) p.data(), pos);
+            }
+
+            if (!placed) {
+                // все элементы на этой позиции перебраны, возвращаемся на шаг назад
+                pos--;
+                if (pos >= 0)
+                    used[p[pos]] = false;
+            } else if (pos == size - 1) {
+                // перестановка составлена; продолжаем перебор последней позиции
+                consumer(p.data());
+            } else {
+                // переходим к следующей позиции
+                used[p[pos]] = true;
+                pos++;
+                next[pos] = 0;
+            }
+        }
+    }
+};
+
+/**
+ * функция-генератор перестановок с отсечением по префиксу
+ *
+ * @param size          количество элементов перестановки
+ * @param isValidPrefix проверка префикса (const int *p, int pos)->bool
+ * @param consumer      обработчик перестановки, все префиксы которой допустимы (int *p)->{}
+ */
+template<typename V, typename F>
+void generatePermutations(int size, const V &isValidPrefix, const F &consumer) {
+    PermutationGenerator generator(size);
+    generator.run(isValidPrefix, consumer);
+}
+
 /**
  * Шаг перебора комбинаций
  *
@@ -141,6 +309,15 @@ int *makePermute(const int *source, int sz, const int *p);
  */
 int **makePermute(int **source, int sz, const int *p);
 
+/**
+ * Применить перестановку к матрице
+ *
+ * @param source источник
+ * @param p      перестановка
+ * @return переставленная матрица
+ */
+Matrix makePermute(const Matrix &source, const int *p);
+
 /**
  * Получить случайную комбинацию
  *
@@ -168,6 +345,16 @@ int *getRandomPermutation(int size);
  */
 int **getSubMatrix(int **source, const int *select, int selectSize);
 
+/**
+ * Получить подматрицу по массиву используемых индексов
+ *
+ * @param source     источник
+ * @param select     массив используемых индексов
+ * @param selectSize размер массива используемых индексов
+ * @return подматрица
+ */
+Matrix getSubMatrix(const Matrix &source, const int *select, int selectSize);
+
 
 /**
  * Проверка на равенство двух матриц
@@ -178,6 +365,15 @@ int **getSubMatrix(int **source, const int *select, int selectSize);
  */
 bool areEqual(int **a, int **b, int sz);
 
+/**
+ * Проверка на равенство двух матриц
+ *
+ * @param a первая матрица
+ * @param b вторая матрица
+ * @return флаг, равны ли матрицы
+ */
+bool areEqual(const Matrix &a, const Matrix &b);
+
 /**
  * Получить случайную матрицу
  *
@@ -186,7 +382,7 @@ bool areEqual(int **a, int **b, int sz);
  * @param minVal      максимальное значение матрицы по модулю
  * @param maxVal      максимальное значение матрицы по модулю
  * @param nonZeroPart доля ненулевых элементов
- * @return случайная матрица
+ * @return случайная матрица; элементы, не выбранные ненулевыми, равны нулю
  */
 int **randomMatrix(int n, int minVal, int maxVal, double nonZeroPart);
 
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <iostream>
+#include <vector>
+#include "CombinatoricsData.h"
+#include "Matrix.h"
+
+/**
+ * Прочитать матрицу в текстовом формате: сначала размер стороны,
+ * затем все элементы построчно через пробельные символы
+ *
+ * @param in поток ввода
+ * @return матрица
+ */
+Matrix readMatrix(std::istream &in);
+
+/**
+ * Записать матрицу в текстовом формате: в первой строке размер стороны,
+ * затем по строке матрицы на каждой строке файла
+ *
+ * @param out    поток вывода
+ * @param matrix матрица
+ */
+void writeMatrix(std::ostream &out, const Matrix &matrix);
+
+/**
+ * Прочитать список комбинаций: по одной комбинации на строку,
+ * элементы через пробел; пустые строки пропускаются
+ *
+ * @param in поток ввода
+ * @return список комбинаций
+ */
+std::vector<CombinatoricsData> readCombinations(std::istream &in);
+
+/**
+ * Записать список комбинаций: по одной комбинации на строку, элементы через пробел
+ *
+ * @param out          поток вывода
+ * @param combinations список комбинаций
+ */
+void writeCombinations(std::ostream &out, const std::vector<CombinatoricsData> &combinations);
@@ -2,6 +2,7 @@
 
 #include "misc/CombinatoricsData.h"
 #include "misc/combinatorics.h"
+#include "misc/MatchSet.h"
 
 
 /**
@@ -25,6 +26,46 @@ bool arePermutatedEquals(
         int sz, bool hardCheck
 );
 
+/**
+ * Проверка переставленной подматрицы на равенство целевой матрице;
+ * Этот метод проверяет, что каждому ненулевому элементу образца
+ * должен соответствовать ненулевой элемент в переставленной матрице.
+ * В случае жёсткой проверки каждому нулевому элементу целевой матрицы должен
+ * соответствовать нулевой элемент переставленной матрицы
+ *
+ * @param p          перестановка
+ * @param source     матрица-источник
+ * @param target     матрица-цель
+ * @param sourceSum  степени вершин у графа-источника
+ * @param targetSum  степени вершин у графа-цели
+ * @param hardCheck  флаг, нужна ли жёсткая проверка
+ * @return - флаг, является ли одна матрица перестановкой другой
+ */
+bool arePermutatedEquals(
+        const int *p, const Matrix &source, const Matrix &target, const int *sourceSum, const int *targetSum,
+        bool hardCheck
+);
+
+/**
+ * Проверка префикса перестановки: сравнивает с целевой матрицей только элементы
+ * переставленной матрицы между последней точкой префикса и всеми точками префикса,
+ * по тем же правилам, что и `arePermutatedEquals`. Перестановка, у которой допустимы
+ * все префиксы, удовлетворяет и `arePermutatedEquals`
+ *
+ * @param p          префикс перестановки
+ * @param pos        номер последней точки префикса
+ * @param source     матрица-источник
+ * @param target     матрица-цель
+ * @param sourceSum  степени вершин у графа-источника
+ * @param targetSum  степени вершин у графа-цели
+ * @param hardCheck  флаг, нужна ли жёсткая проверка
+ * @return флаг, может ли префикс быть началом подходящей перестановки
+ */
+bool isPermutatedPrefixValid(
+        const int *p, int pos, const Matrix &source, const Matrix &target, const int *sourceSum,
+        const int *targetSum, bool hardCheck
+);
+
 /**
  * Получить массив степеней вершин
  *
@@ -34,6 +75,14 @@ bool arePermutatedEquals(
  */
 int *getPowers(int **connectivityMatrix, int sz);
 
+/**
+ * Получить массив степеней вершин
+ *
+ * @param connectivityMatrix матрица связности
+ * @return массив степеней вершин
+ */
+int *getPowers(const Matrix &connectivityMatrix);
+
 /**
  * Поиск всех перестановок исходной матрицы таких, что переставленная матрица совпадает
  * с целевой. Перестановка - это просто последовательность индексов всех вершин,
@@ -52,6 +101,19 @@ int *getPowers(int **connectivityMatrix, int sz);
 std::unordered_set<CombinatoricsData, CombinatoricsData::HashFunction>
 getAllIsomorphicPermutations(int **source, int **target, int sz, bool hardCheck);
 
+/**
+ * Поиск всех перестановок исходной матрицы таких, что переставленная матрица совпадает
+ * с целевой
+ *
+ * @param source    матрица-источник
+ * @param target    целевая матрица
+ * @param hardCheck флаг, нужна ли жёсткая проверка
+ * @return список всех перестановок исходной матрицы таких, что переставленная матрица совпадает
+ * с целевой
+ */
+std::unordered_set<CombinatoricsData, CombinatoricsData::HashFunction>
+getAllIsomorphicPermutations(const Matrix &source, const Matrix &target, bool hardCheck);
+
 /**
  * Поиск изоморфных подграфов полным перебором
  *
@@ -70,5 +132,66 @@ getAllIsomorphicPermutations(int **source, int **target, int sz, bool hardCheck)
 std::vector<CombinatoricsData>
 getAllPatterns(int **source, int sourceSize, int **pattern, int patternSize, bool hardCheck);
 
+/**
+ * Поиск изоморфных подграфов полным перебором
+ *
+ * @param source    матрица-источник
+ * @param pattern   искомый паттерн
+ * @param hardCheck флаг, нужна ли жёсткая проверка
+ * @return список таких комбинаций точек из источника, чтобы при составлении
+ * соответствующих переставленных подматриц, подграфы, построенные по ним,
+ * были изоморфны заданному паттерну
+ */
+std::vector<CombinatoricsData>
+getAllPatterns(const Matrix &source, const Matrix &pattern, bool hardCheck);
 
+/**
+ * Поиск изоморфных подграфов полным перебором с записью комбинаций в множество
+ *
+ * @param source    матрица-источник
+ * @param pattern   искомый паттерн
+ * @param hardCheck флаг, нужна ли жёсткая проверка
+ * @param res       множество, в конец которого добавляются найденные комбинации;
+ *                  размер его комбинаций должен совпадать с размером паттерна
+ */
+void getAllPatterns(const Matrix &source, const Matrix &pattern, bool hardCheck, MatchSet &res);
+
+/**
+ * Поиск изоморфных подграфов полным перебором в несколько потоков
+ *
+ * Перебор не выделяет память на каждую комбинацию: подматрица, степени вершин
+ * и переставленная комбинация лежат в буферах потока
+ *
+ * @param source      матрица-источник
+ * @param pattern     искомый паттерн
+ * @param hardCheck   флаг, нужна ли жёсткая проверка
+ * @param threadCount кол-во потоков
+ * @return список комбинаций в том же порядке, что и у однопоточного `getAllPatterns`
+ */
+std::vector<CombinatoricsData>
+getAllPatterns(const Matrix &source, const Matrix &pattern, bool hardCheck, int threadCount);
 
+/**
+ * Поиск изоморфных подграфов полным перебором в несколько потоков с записью комбинаций в множество
+ *
+ * @param source      матрица-источник
+ * @param pattern     искомый паттерн
+ * @param hardCheck   флаг, нужна ли жёсткая проверка
+ * @param threadCount кол-во потоков
+ * @param res         множество, в конец которого добавляются найденные комбинации в порядке
+ *                    однопоточного `getAllPatterns`; размер его комбинаций должен совпадать с размером паттерна
+ */
+void getAllPatterns(const Matrix &source, const Matrix &pattern, bool hardCheck, int threadCount, MatchSet &res);
+
+/**
+ * Подсчёт изоморфных подграфов полным перебором
+ *
+ * Перебор тот же, что и в `getAllPatterns`, но найденные комбинации не создаются,
+ * а только считаются
+ *
+ * @param source    матрица-источник
+ * @param pattern   искомый паттерн
+ * @param hardCheck флаг, нужна ли жёсткая проверка
+ * @return кол-во комбинаций, которые вернул бы `getAllPatterns`
+ */
+long long countAllPatterns(const Matrix &source, const Matrix &pattern, bool hardCheck);
@@ -0,0 +1,63 @@
+#pragma once
+
+#include <utility>
+#include <vector>
+#include "misc/CombinatoricsData.h"
+#include "misc/IntSpan.h"
+#include "misc/Matrix.h"
+
+/**
+ * Получить группу автоморфизмов паттерна
+ *
+ * Автоморфизм - это перестановка `p` точек паттерна, при которой паттерн не меняется:
+ * `pattern[p[i]][p[j]] == pattern[i][j]` для всех `i` и `j`. Если комбинация `c` - вхождение
+ * паттерна, то и комбинация `c[p[0]], c[p[1]], ...` - вхождение того же подграфа, поэтому
+ * симметричный паттерн находится в каждом подграфе столько раз, сколько у него автоморфизмов
+ *
+ * Группа строится полным перебором перестановок, поэтому подходит только для небольших паттернов
+ *
+ * @param pattern паттерн
+ * @return автоморфизмы в лексикографическом порядке; первый из них - тождественная перестановка
+ */
+std::vector<CombinatoricsData> getAutomorphisms(const Matrix &pattern);
+
+/**
+ * Получить ограничения порядка, отсекающие симметричные комбинации
+ *
+ * Пока в группе есть нетождественные перестановки, выбирается точка `v` с наименьшим
+ * номером, которую они сдвигают; для каждой точки `w` из её орбиты добавляется
+ * ограничение `c[v] < c[w]`, а группа заменяется стабилизатором точки `v`. Из каждого
+ * набора комбинаций, переходящих друг в друга при автоморфизмах, ограничениям
+ * удовлетворяет ровно одна
+ *
+ * @param automorphisms группа автоморфизмов паттерна
+ * @return пары `(a, b)`: вершина точки `a` должна быть меньше вершины точки `b`
+ */
+std::vector<std::pair<int, int>> getSymmetryBreakingConstraints(const std::vector<CombinatoricsData> &automorphisms);
+
+/**
+ * Перебрать все комбинации, получающиеся из найденной комбинации автоморфизмами паттерна
+ *
+ * Комбинации строятся по одной в общем буфере, поэтому все отображения паттерна
+ * можно восстановить по одному представителю, не храня их
+ *
+ * @param representative найденная комбинация
+ * @param automorphisms  группа автоморфизмов паттерна
+ * @param visitor        обработчик комбинации (IntSpan c)->bool; возвращает `false`,
+ *                       если перебор нужно остановить
+ * @return флаг, были ли перебраны все комбинации
+ */
+template<typename V>
+bool forEachAutomorphicMapping(
+        IntSpan representative, const std::vector<CombinatoricsData> &automorphisms, const V &visitor
+) {
+    std::vector<int> mapping(representative.size());
+    for (const CombinatoricsData &p: automorphisms) {
+        // i-ой точке сопоставляется вершина, которая в представителе сопоставлена точке p[i]
+        for (int i = 0; i < representative.size(); i++)
+            mapping[i] = representative[p.getData()[i]];
+        if (!visitor(IntSpan(mapping.data(), (int) mapping.size())))
+            return false;
+    }
+    return true;
+}
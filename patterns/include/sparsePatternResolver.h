@@ -0,0 +1,59 @@
+#pragma once
+
+#include <vector>
+#include "misc/CombinatoricsData.h"
+#include "misc/CsrGraph.h"
+#include "misc/IntSpan.h"
+#include "misc/Matrix.h"
+#include "SparsePatternSearch.h"
+
+/**
+ * Поиск изоморфных подграфов в разреженном дата-графе
+ *
+ * Дата-граф хранится в формате CSR, поэтому его размер ограничен кол-вом рёбер,
+ * а не квадратом кол-ва вершин; вхождения паттерна достраиваются только через
+ * соседей уже выбранных вершин
+ *
+ * @param source    дата-граф
+ * @param pattern   искомый паттерн
+ * @param hardCheck флаг, нужна ли жёсткая проверка; если `hardCheck` равен `false`, то нулевому элементу паттерна
+ *                  может соответствовать произвольное значение в переставленной подматрице, а если
+ *                  `true`, то все элементы паттерна и переставленной подматрицы должны
+ *                  совпадать с точностью до перестановки.
+ * @return те же комбинации, что и `fastGetAllPatterns` для плотной матрицы того же графа,
+ * но, возможно, в другом порядке
+ */
+std::vector<CombinatoricsData>
+sparseGetAllPatterns(const CsrGraph &source, const Matrix &pattern, bool hardCheck);
+
+/**
+ * Подсчёт изоморфных подграфов в разреженном дата-графе
+ *
+ * @param source    дата-граф
+ * @param pattern   искомый паттерн
+ * @param hardCheck флаг, нужна ли жёсткая проверка
+ * @return кол-во комбинаций, которые вернул бы `sparseGetAllPatterns`
+ */
+long long sparseCountAllPatterns(const CsrGraph &source, const Matrix &pattern, bool hardCheck);
+
+/**
+ * Поиск изоморфных подграфов в разреженном дата-графе с передачей каждой найденной
+ * комбинации обработчику
+ *
+ * @param source    дата-граф
+ * @param pattern   искомый паттерн
+ * @param hardCheck флаг, нужна ли жёсткая проверка
+ * @param visitor   обработчик найденной комбинации (IntSpan c)->bool; возвращает `false`,
+ *                  если поиск нужно остановить
+ * @return флаг, был ли перебор доведён до конца, а не остановлен обработчиком
+ */
+template<typename V>
+bool sparseForEachPattern(const CsrGraph &source, const Matrix &pattern, bool hardCheck, const V &visitor) {
+    int patternSize = pattern.getSize();
+    // подготавливаем поиск: допустимые вершины и порядок сопоставления точек паттерна
+    SparsePatternSearch search(source, pattern, hardCheck);
+    // передаём каждую комбинацию обработчику без копирования
+    return search.run([&visitor, &patternSize](int *c) {
+        return (bool) visitor(IntSpan(c, patternSize));
+    });
+}
@@ -0,0 +1,144 @@
+#include "BatchPatternSearch.h"
+#include <algorithm>
+
+const int BatchPatternSearch::NO_PLANE;
+const int BatchPatternSearch::ZERO_PLANE;
+
+/**
+ * Собрать все элементы всех паттернов
+ *
+ * @param patterns паттерны
+ * @return элементы паттернов
+ */
+static std::vector<int> collectValues(const std::vector<Matrix> &patterns) {
+    std::vector<int> values;
+    for (const Matrix &pattern: patterns)
+        values.insert(
+                values.end(), pattern.getData(),
+                pattern.getData() + (long long) pattern.getSize() * pattern.getStride()
+        );
+    return values;
+}
+
+/**
+ * Конструктор
+ *
+ * @param source    дата-граф
+ * @param patterns  искомые паттерны
+ * @param hardCheck флаг, нужна ли жёсткая проверка
+ */
+BatchPatternSearch::BatchPatternSearch(const Matrix &source, const std::vector<Matrix> &patterns, bool hardCheck) :
+// строим битовые плоскости сразу для всех значений, встречающихся в паттернах
+        graph(source, collectValues(patterns)) {
+    this->sourceSize = source.getSize();
+    this->wordsCnt = graph.getWordsCount();
+    this->maxPatternSize = 0;
+
+    loops.resize(sourceSize);
+    for (int i = 0; i < sourceSize; i++)
+        loops[i] = source.get(i, i);
+
+    // корень дерева
+    nodes.emplace_back();
+
+    for (int id = 0; id < (int) patterns.size(); id++) {
+        const Matrix &pattern = patterns[id];
+        int patternSize = pattern.getSize();
+        maxPatternSize = std::max(maxPatternSize, patternSize);
+
+        // спускаемся по дереву, добавляя по одной точке паттерна
+        int parent = 0;
+        for (int depth = 0; depth < patternSize; depth++) {
+            // новые элементы ведущей подматрицы: диагональный, строка и столбец точки `depth`
+            std::vector<int> key(1 + 2 * depth);
+            key[0] = pattern.get(depth, depth);
+            for (int j = 0; j < depth; j++) {
+                key[1 + j] = pattern.get(depth, j);
+                key[1 + depth + j] = pattern.get(j, depth);
+            }
+
+            // ищем дочерний узел с такой же ведущей подматрицей
+            int next = -1;
+            for (int child: nodes[parent].children)
+                if (nodes[child].key == key) {
+                    next = child;
+                    break;
+                }
+
+            // если его нет, создаём новый
+            if (next < 0) {
+                Node node;
+                node.loopConstrained = hardCheck || key[0] != 0;
+                node.loop = key[0];
+                node.fromPrefix.resize(depth);
+                node.toPrefix.resize(depth);
+                for (int j = 0; j < depth; j++) {
+                    node.toPrefix[j] = getConstraintPlane(key[1 + j], hardCheck);
+                    node.fromPrefix[j] = getConstraintPlane(key[1 + depth + j], hardCheck);
+                }
+                node.key = std::move(key);
+
+                next = (int) nodes.size();
+                nodes.push_back(std::move(node));
+                nodes[parent].children.push_back(next);
+            }
+            parent = next;
+        }
+        nodes[parent].patternIds.push_back(id);
+    }
+}
+
+/**
+ * Получить номер битовой плоскости, которой должен принадлежать элемент дата-графа,
+ * соответствующий элементу паттерна
+ *
+ * @param value     элемент паттерна
+ * @param hardCheck флаг, нужна ли жёсткая проверка
+ * @return номер битовой плоскости, `NO_PLANE` или `ZERO_PLANE`
+ */
+int BatchPatternSearch::getConstraintPlane(int value, bool hardCheck) const {
+    // ненулевому элементу паттерна должен соответствовать равный ему элемент
+    if (value != 0)
+        return graph.getPlane(value);
+    // нулевому элементу при жёсткой проверке должен соответствовать нулевой,
+    // а при нежёсткой - любой
+    return hardCheck ? ZERO_PLANE : NO_PLANE;
+}
+
+/**
+ * Заполнить кандидатов для точки узла: свободные вершины, совместимые со всеми выбранными
+ *
+ * @param node        узел
+ * @param depth       глубина узла
+ * @param combination выбранные вершины
+ * @param used        битовая строка занятых вершин
+ * @param candidates  битовая строка, в которую записываются кандидаты
+ */
+void BatchPatternSearch::fillCandidates(
+        const Node &node, int depth, const std::vector<int> &combination, const uint64_t *used,
+        uint64_t *candidates
+) const {
+    // все свободные вершины
+    for (int k = 0; k < wordsCnt; k++)
+        candidates[k] = ~used[k];
+    if (sourceSize < wordsCnt * 64)
+        clearBitsFrom(candidates, wordsCnt, sourceSize);
+
+    for (int j = 0; j < depth; j++) {
+        int vertex = combination[j];
+
+        // элемент дата-графа из строки выбранной вершины
+        int plane = node.fromPrefix[j];
+        if (plane == ZERO_PLANE)
+            andNotWords(candidates, graph.getNonZeroOut(vertex), wordsCnt);
+        else if (plane != NO_PLANE)
+            andWords(candidates, graph.getValueOut(plane, vertex), wordsCnt);
+
+        // элемент дата-графа из столбца выбранной вершины
+        plane = node.toPrefix[j];
+        if (plane == ZERO_PLANE)
+            andNotWords(candidates, graph.getNonZeroIn(vertex), wordsCnt);
+        else if (plane != NO_PLANE)
+            andWords(candidates, graph.getValueIn(plane, vertex), wordsCnt);
+    }
+}
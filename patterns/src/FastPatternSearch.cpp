@@ -0,0 +1,615 @@
+#include "FastPatternSearch.h"
+#include <algorithm>
+
+const int FastPatternSearch::NO_PLANE;
+const int FastPatternSearch::ZERO_PLANE;
+
+/**
+ * Конструктор
+ *
+ * @param source          дата-граф
+ * @param pattern         искомый паттерн
+ * @param hardCheck       флаг, нужна ли жёсткая проверка
+ * @param lessConstraints ограничения порядка: для каждой пары `(a, b)` вершина, сопоставленная
+ *                        точке `a`, должна быть меньше вершины, сопоставленной точке `b`
+ */
+FastPatternSearch::FastPatternSearch(
+        const Matrix &source, const Matrix &pattern, bool hardCheck,
+        const std::vector<std::pair<int, int>> &lessConstraints
+) :
+// строим битовые плоскости для всех значений, встречающихся в паттерне
+        graph(source, std::vector<int>(
+                pattern.getData(), pattern.getData() + (long long) pattern.getSize() * pattern.getStride()
+        )) {
+    this->sourceSize = source.getSize();
+    this->patternSize = pattern.getSize();
+    this->wordsCnt = graph.getWordsCount();
+    this->seeded = false;
+    this->specialized = true;
+
+    // для каждой пары различных точек паттерна запоминаем битовую плоскость,
+    // которой ограничивается соответствующий элемент дата-графа
+    planes.assign(patternSize * patternSize, NO_PLANE);
+    for (int u = 0; u < patternSize; u++)
+        for (int w = 0; w < patternSize; w++)
+            if (u != w)
+                planes[u * patternSize + w] = getConstraintPlane(pattern.get(u, w), hardCheck);
+
+    // запоминаем ограничения порядка в обе стороны
+    if (!lessConstraints.empty()) {
+        symmetry.assign(patternSize * patternSize, 0);
+        for (const std::pair<int, int> &constraint: lessConstraints) {
+            int a = constraint.first;
+            int b = constraint.second;
+            if (a < 0 || a >= patternSize || b < 0 || b >= patternSize || a == b)
+                throw std::invalid_argument(
+                        "FastPatternSearch() less constraint is not acceptable: " +
+                        std::to_string(a) + " " + std::to_string(b)
+                );
+            symmetry[a * patternSize + b] = 1;
+            symmetry[b * patternSize + a] = -1;
+        }
+    }
+
+    initDomains(source, pattern, hardCheck);
+    initOrder();
+    statistics.addBuildTime(buildTimer.getElapsed());
+}
+
+/**
+ * Конструктор поиска, начинающегося с позиций самого редкого значения ребра паттерна
+ *
+ * @param source          дата-граф
+ * @param pattern         искомый паттерн
+ * @param hardCheck       флаг, нужна ли жёсткая проверка
+ * @param index           индекс значений рёбер дата-графа; нужен только на время конструктора
+ * @param lessConstraints ограничения порядка: для каждой пары `(a, b)` вершина, сопоставленная
+ *                        точке `a`, должна быть меньше вершины, сопоставленной точке `b`
+ */
+FastPatternSearch::FastPatternSearch(
+        const Matrix &source, const Matrix &pattern, bool hardCheck, const EdgeValueIndex &index,
+        const std::vector<std::pair<int, int>> &lessConstraints
+) : FastPatternSearch(source, pattern, hardCheck, lessConstraints) {
+    SearchStatistics::Timer timer;
+    initSeeds(pattern, index);
+    statistics.addBuildTime(timer.getElapsed());
+}
+
+/**
+ * Создать пустое состояние перебора
+ * @return состояние перебора
+ */
+FastPatternSearch::SearchState FastPatternSearch::createState() const {
+    SearchState state;
+    state.domains.assign((long long) std::max(patternSize - 1, 0) * patternSize * wordsCnt, 0);
+    state.combination.assign(patternSize, 0);
+    return state;
+}
+
+/**
+ * Восстановить состояние перебора по префиксу комбинации
+ *
+ * @param state  состояние перебора
+ * @param prefix вершины дата-графа, сопоставленные первым точкам в порядке сопоставления
+ * @return флаг, совместим ли префикс с паттерном
+ */
+bool FastPatternSearch::restoreState(SearchState &state, const std::vector<int> &prefix) const {
+    for (int cnt = 0; cnt < (int) prefix.size(); cnt++) {
+        // вершина должна лежать в домене своей точки на этой глубине
+        if (!testBit(getDomain(state, cnt, order[cnt]), prefix[cnt])) {
+            state.statistics.addPrunes(SearchStatistics::PREFIX);
+            return false;
+        }
+        state.combination[order[cnt]] = prefix[cnt];
+        // узлом считается только последняя вершина префикса: остальные уже учтены
+        // при переборе, от которого отделилась задача
+        if (cnt == (int) prefix.size() - 1)
+            state.statistics.addNodes(cnt);
+        // сужаем домены следующих точек, если они есть
+        if (cnt < patternSize - 1 && !forwardCheck(state, cnt, prefix[cnt])) {
+            state.statistics.addPrunes(SearchStatistics::EMPTY_DOMAIN);
+            return false;
+        }
+    }
+    return true;
+}
+
+/**
+ * Получить номер битовой плоскости, которой должен принадлежать элемент дата-графа,
+ * соответствующий элементу паттерна
+ *
+ * @param value     элемент паттерна
+ * @param hardCheck флаг, нужна ли жёсткая проверка
+ * @return номер битовой плоскости, `NO_PLANE` или `ZERO_PLANE`
+ */
+int FastPatternSearch::getConstraintPlane(int value, bool hardCheck) const {
+    // ненулевому элементу паттерна должен соответствовать равный ему элемент
+    if (value != 0)
+        return graph.getPlane(value);
+    // нулевому элементу при жёсткой проверке должен соответствовать нулевой,
+    // а при нежёсткой - любой
+    return hardCheck ? ZERO_PLANE : NO_PLANE;
+}
+
+/**
+ * Заполнить начальные домены точек паттерна
+ *
+ * Вершина дата-графа попадает в домен точки паттерна, если у неё совпадает
+ * диагональный элемент, и для каждого ограничения на рёбра (ненулевое,
+ * равное значению плоскости, а при жёсткой проверке и нулевое) у неё
+ * не меньше исходящих и входящих рёбер такого вида, чем у точки паттерна:
+ * рёбра точки паттерна переходят в различные рёбра вершины дата-графа
+ *
+ * @param source    дата-граф
+ * @param pattern   искомый паттерн
+ * @param hardCheck флаг, нужна ли жёсткая проверка
+ */
+void FastPatternSearch::initDomains(const Matrix &source, const Matrix &pattern, bool hardCheck) {
+    domains.assign((long long) patternSize * wordsCnt, 0);
+
+    // виды ограничений на рёбра: битовые плоскости и нулевые рёбра (последний вид)
+    int kindsCnt = graph.getPlanesCount() + 1;
+    int zeroKind = kindsCnt - 1;
+
+    // для каждой точки паттерна считаем кол-во исходящих и входящих рёбер каждого вида
+    std::vector<int> patternOut(patternSize * kindsCnt, 0), patternIn(patternSize * kindsCnt, 0);
+    for (int u = 0; u < patternSize; u++)
+        for (int w = 0; w < patternSize; w++) {
+            int plane = planes[u * patternSize + w];
+            if (plane != NO_PLANE) {
+                patternOut[u * kindsCnt + (plane == ZERO_PLANE ? zeroKind : plane)]++;
+                patternIn[w * kindsCnt + (plane == ZERO_PLANE ? zeroKind : plane)]++;
+            }
+        }
+
+    // то же самое для текущей вершины дата-графа
+    std::vector<int> sourceOut(kindsCnt), sourceIn(kindsCnt);
+    for (int vertex = 0; vertex < sourceSize; vertex++) {
+        int diagonal = source.get(vertex, vertex);
+        // плоскость, к которой относится петля вершины (её не нужно учитывать)
+        int diagonalPlane = diagonal == 0 ? NO_PLANE : graph.getPlane(diagonal);
+
+        // кол-во ненулевых рёбер вершины без учёта петли
+        int nonZeroOut = 0, nonZeroIn = 0;
+        for (int w = 0; w < wordsCnt; w++) {
+            nonZeroOut += popCount(graph.getNonZeroOut(vertex)[w]);
+            nonZeroIn += popCount(graph.getNonZeroIn(vertex)[w]);
+        }
+        if (diagonal != 0) {
+            nonZeroOut--;
+            nonZeroIn--;
+        }
+        sourceOut[zeroKind] = sourceSize - 1 - nonZeroOut;
+        sourceIn[zeroKind] = sourceSize - 1 - nonZeroIn;
+
+        // кол-во рёбер вершины с каждым значением без учёта петли
+        for (int plane = 0; plane < zeroKind; plane++) {
+            sourceOut[plane] = plane == diagonalPlane ? -1 : 0;
+            sourceIn[plane] = plane == diagonalPlane ? -1 : 0;
+            for (int w = 0; w < wordsCnt; w++) {
+                sourceOut[plane] += popCount(graph.getValueOut(plane, vertex)[w]);
+                sourceIn[plane] += popCount(graph.getValueIn(plane, vertex)[w]);
+            }
+        }
+
+        for (int u = 0; u < patternSize; u++) {
+            // диагональный элемент должен совпадать, если он ненулевой или проверка жёсткая
+            if ((hardCheck || pattern.get(u, u) != 0) && diagonal != pattern.get(u, u)) {
+                statistics.addPrunes(SearchStatistics::DIAGONAL);
+                continue;
+            }
+
+            // рёбра точки паттерна переходят в различные рёбра вершины дата-графа,
+            // поэтому рёбер каждого вида у вершины должно быть не меньше
+            bool fits = true;
+            for (int kind = 0; kind < kindsCnt && fits; kind++)
+                if (sourceOut[kind] < patternOut[u * kindsCnt + kind] ||
+                    sourceIn[kind] < patternIn[u * kindsCnt + kind])
+                    fits = false;
+
+            if (fits)
+                setBit(domains.data() + (long long) u * wordsCnt, vertex);
+            else
+                statistics.addPrunes(SearchStatistics::DEGREE);
+        }
+    }
+}
+
+/**
+ * Построить порядок сопоставления точек паттерна
+ *
+ * Первой выбирается точка с самым маленьким начальным доменом (при равенстве - с
+ * наибольшим кол-вом ограничений на рёбра), а каждой следующей - точка, у которой
+ * больше всего ненулевых рёбер с уже упорядоченными точками, затем меньше домен
+ * и больше ограничений. Так каждая новая точка сразу сужается выбранными
+ * и дерево перебора не разрастается на точках, не связанных с префиксом
+ *
+ * @param start точки, с которых порядок должен начинаться
+ */
+void FastPatternSearch::initOrder(const std::vector<int> &start) {
+    // размеры начальных доменов и кол-во ограничений на рёбра каждой точки
+    std::vector<int> domainSizes(patternSize, 0), degrees(patternSize, 0);
+    for (int u = 0; u < patternSize; u++) {
+        for (int k = 0; k < wordsCnt; k++)
+            domainSizes[u] += popCount(domains[(long long) u * wordsCnt + k]);
+        for (int w = 0; w < patternSize; w++)
+            degrees[u] += (planes[u * patternSize + w] != NO_PLANE) + (planes[w * patternSize + u] != NO_PLANE);
+    }
+
+    // кол-во ненулевых рёбер между точкой и уже упорядоченными точками
+    std::vector<int> links(patternSize, 0);
+    std::vector<bool> ordered(patternSize, false);
+    order.clear();
+
+    while ((int) order.size() < patternSize) {
+        int best = -1;
+        // заданные начальные точки идут первыми
+        if (order.size() < start.size())
+            best = start[order.size()];
+        for (int u = 0; u < patternSize && order.size() >= start.size(); u++) {
+            if (ordered[u])
+                continue;
+            if (best < 0 ||
+                links[u] > links[best] ||
+                (links[u] == links[best] && domainSizes[u] < domainSizes[best]) ||
+                (links[u] == links[best] && domainSizes[u] == domainSizes[best] && degrees[u] > degrees[best]))
+                best = u;
+        }
+
+        order.push_back(best);
+        ordered[best] = true;
+
+        // учитываем рёбра новой точки с остальными
+        for (int w = 0; w < patternSize; w++)
+            links[w] += (planes[best * patternSize + w] >= 0) + (planes[w * patternSize + best] >= 0);
+    }
+}
+
+/**
+ * Выбрать самое редкое значение ребра паттерна и запомнить его позиции
+ *
+ * Среди ненулевых недиагональных элементов паттерна выбирается тот, значение которого
+ * реже всего встречается в дата-графе; его точки становятся первыми в порядке
+ * сопоставления, а позиции значения - начальными парами вершин перебора
+ *
+ * @param pattern искомый паттерн
+ * @param index   индекс значений рёбер дата-графа
+ */
+void FastPatternSearch::initSeeds(const Matrix &pattern, const EdgeValueIndex &index) {
+    int from = -1, to = -1;
+    long long bestCount = 0;
+    for (int u = 0; u < patternSize; u++)
+        for (int w = 0; w < patternSize; w++) {
+            int value = pattern.get(u, w);
+            if (u == w || value == 0)
+                continue;
+            long long count = index.getCount(value);
+            if (from < 0 || count < bestCount) {
+                from = u;
+                to = w;
+                bestCount = count;
+            }
+        }
+    // у паттерна нет рёбер, от которых можно начать
+    if (from < 0)
+        return;
+
+    seeded = true;
+    initOrder({from, to});
+
+    // оставляем только позиции, совместимые с начальными доменами обеих точек
+    const EdgeValueIndex::Position *positions = index.getPositions(pattern.get(from, to));
+    for (long long k = 0; k < bestCount; k++) {
+        const EdgeValueIndex::Position &position = positions[k];
+        if (position.row >= sourceSize || position.col >= sourceSize)
+            throw std::invalid_argument(
+                    "FastPatternSearch() edge value index does not match the source: " +
+                    std::to_string(position.row) + " " + std::to_string(position.col)
+            );
+        if (testBit(domains.data() + (long long) from * wordsCnt, position.row) &&
+            testBit(domains.data() + (long long) to * wordsCnt, position.col)) {
+            seeds.push_back(position.row);
+            seeds.push_back(position.col);
+        } else
+            statistics.addPrunes(SearchStatistics::PREFIX);
+    }
+}
+
+/**
+ * Разложить начальные задачи параллельного перебора по очередям потоков
+ *
+ * @param pool        пул задач
+ * @param threadCount кол-во потоков
+ */
+void FastPatternSearch::pushRoots(TaskPool<std::vector<int>> &pool, int threadCount) const {
+    int worker = 0;
+    // при переборе с позиций ребра задача - пара вершин первых двух точек
+    if (seeded) {
+        for (long long k = 0; k < (long long) seeds.size(); k += 2) {
+            pool.push(worker, std::vector<int>{seeds[k], seeds[k + 1]});
+            worker = (worker + 1) % threadCount;
+        }
+        return;
+    }
+    // иначе - вершина из домена первой точки
+    forEachBit(domains.data() + (long long) order[0] * wordsCnt, wordsCnt, [&pool, &worker, &threadCount](int vertex) {
+        pool.push(worker, std::vector<int>{vertex});
+        worker = (worker + 1) % threadCount;
+    });
+}
+
+/**
+ * Записать статистику построения и перебора
+ *
+ * @param res              статистика, к которой добавляются счётчики
+ * @param searchStatistics статистика перебора
+ * @param timer            замер времени, начатый перед перебором
+ */
+void FastPatternSearch::collectStatistics(
+        SearchStatistics &res, const SearchStatistics &searchStatistics, const SearchStatistics::Timer &timer
+) const {
+    res.merge(statistics);
+    res.merge(searchStatistics);
+    res.addSearchTime(timer.getElapsed());
+}
+
+/**
+ * Прямая проверка: сузить домены ещё не выбранных точек паттерна после того,
+ * как точке паттерна на глубине `cnt` сопоставлена вершина дата-графа
+ *
+ * @param state  состояние перебора
+ * @param cnt    кол-во уже выбранных точек до текущей
+ * @param vertex вершина дата-графа, сопоставленная точке на глубине `cnt`
+ * @return флаг, остались ли все домены непустыми
+ */
+bool FastPatternSearch::forwardCheck(SearchState &state, int cnt, int vertex) const {
+    // точка паттерна, которой сопоставлена вершина
+    int u = order[cnt];
+    for (int next = cnt + 1; next < patternSize; next++) {
+        // ещё не выбранная точка паттерна
+        int w = order[next];
+        uint64_t *domain = state.domains.data() + ((long long) cnt * patternSize + w) * wordsCnt;
+        const uint64_t *prev = getDomain(state, cnt, w);
+        for (int k = 0; k < wordsCnt; k++)
+            domain[k] = prev[k];
+        // выбранная вершина уже занята
+        clearBit(domain, vertex);
+
+        // элемент дата-графа из строки выбранной вершины
+        int plane = planes[u * patternSize + w];
+        if (plane == ZERO_PLANE)
+            andNotWords(domain, graph.getNonZeroOut(vertex), wordsCnt);
+        else if (plane != NO_PLANE)
+            andWords(domain, graph.getValueOut(plane, vertex), wordsCnt);
+
+        // элемент дата-графа из столбца выбранной вершины
+        plane = planes[w * patternSize + u];
+        if (plane == ZERO_PLANE)
+            andNotWords(domain, graph.getNonZeroIn(vertex), wordsCnt);
+        else if (plane != NO_PLANE)
+            andWords(domain, graph.getValueIn(plane, vertex), wordsCnt);
+
+        // ограничение порядка между выбранной и ещё не выбранной точкой
+        if (!symmetry.empty()) {
+            int relation = symmetry[u * patternSize + w];
+            if (relation > 0)
+                clearBitsUpTo(domain, vertex);
+            else if (relation < 0)
+                clearBitsFrom(domain, wordsCnt, vertex);
+        }
+
+        // если домен опустел, ветку можно отбросить
+        uint64_t any = 0;
+        for (int k = 0; k < wordsCnt; k++)
+            any |= domain[k];
+        if (!any)
+            return false;
+    }
+    return true;
+}
+
+/**
+ * Оценить стоимость перебора поддеревьев для каждой вершины из домена первой точки
+ *
+ * @return пары (вершина, оценка стоимости) в порядке возрастания вершин
+ */
+std::vector<std::pair<int, double>> FastPatternSearch::estimateRootCosts() const {
+    std::vector<std::pair<int, double>> costs;
+    if (patternSize == 0)
+        return costs;
+
+    SearchState state = createState();
+    forEachBit(domains.data() + (long long) order[0] * wordsCnt, wordsCnt, [this, &state, &costs](int vertex) {
+        double cost = 1;
+        // если после прямой проверки какой-то домен пуст, поддерево пустое
+        if (patternSize > 1 && !forwardCheck(state, 0, vertex))
+            cost = 0;
+        else
+            for (int cnt = 1; cnt < patternSize; cnt++)
+                cost *= countBits(getDomain(state, 1, order[cnt]), wordsCnt);
+        costs.emplace_back(vertex, cost);
+    });
+    return costs;
+}
+
+/**
+ * Получить вершины первой точки в порядке, в котором вхождение паттерна вероятнее
+ * найти быстрее
+ *
+ * @return вершины первой точки
+ */
+std::vector<int> FastPatternSearch::getPromisingRoots() const {
+    std::vector<std::pair<int, double>> costs = estimateRootCosts();
+    // сначала самые дорогие поддеревья, при равенстве - по возрастанию вершин
+    std::stable_sort(costs.begin(), costs.end(), [](const std::pair<int, double> &a,
+                                                    const std::pair<int, double> &b) {
+        return a.second > b.second;
+    });
+
+    std::vector<int> roots;
+    for (const std::pair<int, double> &cost: costs)
+        // пустые поддеревья перебирать не нужно
+        if (cost.second > 0)
+            roots.push_back(cost.first);
+    return roots;
+}
+
+/**
+ * Получить вершины первой точки, поддеревья которых относятся к заданной части перебора
+ *
+ * @param shardIndex номер части
+ * @param shardCount кол-во частей
+ * @return вершины первой точки в порядке возрастания
+ */
+std::vector<int> FastPatternSearch::getShardRoots(int shardIndex, int shardCount) const {
+    if (shardCount < 1 || shardIndex < 0 || shardIndex >= shardCount)
+        throw std::invalid_argument(
+                "FastPatternSearch::getShardRoots() shard: " + std::to_string(shardIndex) +
+                " of " + std::to_string(shardCount)
+        );
+
+    std::vector<std::pair<int, double>> costs = estimateRootCosts();
+    // сортируем поддеревья по убыванию стоимости, при равенстве - по возрастанию вершины
+    std::stable_sort(costs.begin(), costs.end(), [](const std::pair<int, double> &a,
+                                                    const std::pair<int, double> &b) {
+        return a.second > b.second;
+    });
+
+    // текущая загрузка каждой части
+    std::vector<double> loads(shardCount, 0);
+    std::vector<int> roots;
+    for (auto &cost: costs) {
+        // находим наименее загруженную часть (при равенстве - с меньшим номером)
+        int best = 0;
+        for (int i = 1; i < shardCount; i++)
+            if (loads[i] < loads[best])
+                best = i;
+        // пустые поддеревья не влияют на загрузку, поэтому раскладываем их по кругу
+        if (cost.second == 0)
+            best = cost.first % shardCount;
+        loads[best] += cost.second;
+        if (best == shardIndex)
+            roots.push_back(cost.first);
+    }
+
+    std::sort(roots.begin(), roots.end());
+    return roots;
+}
+
+/**
+ * Посчитать все вхождения паттерна с начальных веток
+ *
+ * @param state состояние перебора
+ * @return кол-во вхождений паттерна
+ */
+long long FastPatternSearch::countRoots(SearchState &state) const {
+    // пустой паттерн входит в любой дата-граф ровно один раз
+    if (patternSize == 0) {
+        state.statistics.addMatches();
+        return 1;
+    }
+    if (!seeded)
+        return countPatternStep(state, 0, [](const int *, int, int) { return false; });
+
+    // считаем вхождения в ветках, начинающихся с позиций самого редкого ребра
+    long long res = 0;
+    std::vector<int> prefix(2);
+    for (long long k = 0; k < (long long) seeds.size(); k += 2) {
+        prefix[0] = seeds[k];
+        prefix[1] = seeds[k + 1];
+        if (!restoreState(state, prefix))
+            continue;
+        if (patternSize == 2) {
+            state.statistics.addMatches();
+            res++;
+        } else
+            res += countPatternStep(state, 2, [](const int *, int, int) { return false; });
+    }
+    return res;
+}
+
+/**
+ * Посчитать все вхождения паттерна
+ *
+ * @param statistics статистика, к которой добавляются счётчики построения и перебора;
+ *                   `nullptr`, если она не нужна
+ * @return кол-во вхождений паттерна
+ */
+long long FastPatternSearch::count(SearchStatistics *statistics) const {
+    SearchStatistics::Timer timer;
+    SearchState state = createState();
+    long long res = countRoots(state);
+    if (statistics)
+        collectStatistics(*statistics, state.statistics, timer);
+    return res;
+}
+
+/**
+ * Посчитать все вхождения паттерна в несколько потоков
+ *
+ * @param threadCount кол-во потоков
+ * @param statistics  статистика, к которой добавляются счётчики построения и перебора
+ *                    всех потоков; `nullptr`, если она не нужна
+ * @return кол-во вхождений паттерна
+ */
+long long FastPatternSearch::countParallel(int threadCount, SearchStatistics *statistics) const {
+    if (threadCount < 1)
+        throw std::invalid_argument(
+                "FastPatternSearch::countParallel() thread count is not acceptable: " + std::to_string(threadCount)
+        );
+
+    // в один поток и для пустого паттерна считаем без пула задач
+    if (threadCount == 1 || patternSize == 0)
+        return count(statistics);
+
+    SearchStatistics::Timer timer;
+
+    // задача - префикс комбинации в порядке сопоставления
+    TaskPool<std::vector<int>> pool(threadCount);
+
+    // раскладываем начальные ветки по очередям потоков
+    pushRoots(pool, threadCount);
+
+    // состояния перебора и счётчики вхождений потоков
+    std::vector<SearchState> states;
+    for (int i = 0; i < threadCount; i++)
+        states.push_back(createState());
+    std::vector<long long> counts(threadCount, 0);
+
+    pool.run([this, &pool, &states, &counts](int worker, std::vector<int> &prefix) {
+        SearchState &state = states[worker];
+        // восстанавливаем состояние по префиксу задачи
+        if (!restoreState(state, prefix))
+            return;
+
+        int cnt = (int) prefix.size();
+        // если префикс уже является полной комбинацией
+        if (cnt == patternSize) {
+            state.statistics.addMatches();
+            counts[worker]++;
+            return;
+        }
+
+        counts[worker] += countPatternStep(state, cnt, [this, &pool, &worker](const int *c, int cnt, int vertex) {
+            // отдаём ветку другим потокам, только если они простаивают и под ней
+            // есть хотя бы два уровня перебора
+            if (cnt + 2 >= patternSize || !pool.isHungry())
+                return false;
+            pool.push(worker, getBranchPrefix(c, cnt, vertex));
+            return true;
+        });
+    });
+
+    // объединяем статистику потоков
+    if (statistics) {
+        SearchStatistics searchStatistics;
+        for (const SearchState &state: states)
+            searchStatistics.merge(state.statistics);
+        collectStatistics(*statistics, searchStatistics, timer);
+    }
+
+    long long res = 0;
+    for (long long c: counts)
+        res += c;
+    return res;
+}
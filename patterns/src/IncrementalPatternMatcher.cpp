@@ -0,0 +1,179 @@
+#include "IncrementalPatternMatcher.h"
+
+#include <utility>
+
+/**
+ * Конструктор
+ *
+ * @param graph исходное состояние дата-графа
+ */
+IncrementalPatternMatcher::IncrementalPatternMatcher(DynamicGraph graph) : graph(std::move(graph)) {
+}
+
+/**
+ * Построить план перебора для пары точек паттерна
+ *
+ * Первыми идут закреплённые точки, а каждой следующей - точка, у которой больше всего
+ * ненулевых рёбер с уже упорядоченными (при равенстве - больше ограничений на рёбра),
+ * поэтому кандидаты почти всех точек берутся из списков соседей
+ *
+ * @param constrained флаги ограничений на рёбра паттерна: элемент `[u * patternSize + w]`
+ * @param values      требуемые значения рёбер в том же порядке
+ * @param patternSize размер стороны паттерна
+ * @param from        точка, сопоставленная строке изменённого элемента
+ * @param to          точка, сопоставленная столбцу изменённого элемента
+ * @param required    значение, которое должен иметь изменённый элемент
+ * @return план перебора
+ */
+IncrementalPatternMatcher::AnchorPlan IncrementalPatternMatcher::createPlan(
+        const std::vector<char> &constrained, const std::vector<int> &values, int patternSize,
+        int from, int to, int required
+) {
+    AnchorPlan plan;
+    plan.from = from;
+    plan.to = to;
+    plan.required = required;
+
+    // кол-во ограничений на рёбра каждой точки
+    std::vector<int> degrees(patternSize, 0);
+    for (int u = 0; u < patternSize; u++)
+        for (int w = 0; w < patternSize; w++)
+            degrees[u] += constrained[u * patternSize + w] + constrained[w * patternSize + u];
+
+    // кол-во ненулевых рёбер между точкой и уже упорядоченными точками
+    std::vector<int> links(patternSize, 0);
+    std::vector<bool> ordered(patternSize, false);
+    plan.checks.assign(patternSize, std::vector<Check>());
+
+    while ((int) plan.order.size() < patternSize) {
+        int depth = (int) plan.order.size();
+        int best = -1;
+        // закреплённые точки идут первыми
+        if (depth == 0)
+            best = from;
+        else if (depth == 1 && from != to)
+            best = to;
+        else
+            for (int u = 0; u < patternSize; u++) {
+                if (ordered[u])
+                    continue;
+                if (best < 0 || links[u] > links[best] || (links[u] == links[best] && degrees[u] > degrees[best]))
+                    best = u;
+            }
+
+        // проверки рёбер новой точки с уже упорядоченными
+        for (int d = 0; d < depth; d++) {
+            int p = plan.order[d];
+            Check check{
+                    d,
+                    (bool) constrained[best * patternSize + p], values[best * patternSize + p],
+                    (bool) constrained[p * patternSize + best], values[p * patternSize + best]
+            };
+            if (check.hasToPrefix || check.hasFromPrefix)
+                plan.checks[depth].push_back(check);
+        }
+
+        plan.order.push_back(best);
+        ordered[best] = true;
+        for (int u = 0; u < patternSize; u++) {
+            if (constrained[u * patternSize + best] && values[u * patternSize + best] != 0)
+                links[u]++;
+            if (constrained[best * patternSize + u] && values[best * patternSize + u] != 0)
+                links[u]++;
+        }
+    }
+    return plan;
+}
+
+/**
+ * Зарегистрировать паттерн
+ *
+ * @param pattern   паттерн
+ * @param hardCheck флаг, нужна ли жёсткая проверка
+ * @return номер паттерна, с которым сообщаются изменения его вхождений
+ */
+int IncrementalPatternMatcher::addPattern(const Matrix &pattern, bool hardCheck) {
+    Registration registration;
+    int patternSize = pattern.getSize();
+    registration.patternSize = patternSize;
+
+    // элемент дата-графа ограничен, если элемент паттерна ненулевой или проверка жёсткая
+    std::vector<char> constrained(patternSize * patternSize, 0);
+    std::vector<int> values(patternSize * patternSize, 0);
+    for (int u = 0; u < patternSize; u++)
+        for (int w = 0; w < patternSize; w++)
+            if (u != w) {
+                values[u * patternSize + w] = pattern.get(u, w);
+                constrained[u * patternSize + w] = hardCheck || pattern.get(u, w) != 0;
+            }
+
+    registration.loopConstrained.assign(patternSize, 0);
+    registration.loops.assign(patternSize, 0);
+    for (int u = 0; u < patternSize; u++) {
+        registration.loopConstrained[u] = hardCheck || pattern.get(u, u) != 0;
+        registration.loops[u] = pattern.get(u, u);
+    }
+
+    // изменение элемента затрагивает только вхождения, в которых ему сопоставлен
+    // ограниченный элемент паттерна
+    for (int u = 0; u < patternSize; u++)
+        for (int w = 0; w < patternSize; w++)
+            if (u == w ? registration.loopConstrained[u] : constrained[u * patternSize + w]) {
+                int required = u == w ? registration.loops[u] : values[u * patternSize + w];
+                registration.plans.push_back(createPlan(constrained, values, patternSize, u, w, required));
+            }
+
+    registrations.push_back(std::move(registration));
+    return (int) registrations.size() - 1;
+}
+
+/**
+ * Проверить, можно ли сопоставить вершину точке паттерна на заданной глубине
+ *
+ * @param registration паттерн
+ * @param plan         план перебора
+ * @param combination  текущая комбинация в индексах паттерна
+ * @param cnt          глубина
+ * @param vertex       вершина дата-графа
+ * @return флаг, совместима ли вершина со всеми выбранными точками
+ */
+bool IncrementalPatternMatcher::fits(
+        const Registration &registration, const AnchorPlan &plan, const std::vector<int> &combination,
+        int cnt, int vertex
+) const {
+    int u = plan.order[cnt];
+    // петля должна совпадать, если она ограничена
+    if (registration.loopConstrained[u] && graph.getLoop(vertex) != registration.loops[u])
+        return false;
+
+    // вершина не должна быть занята
+    for (int d = 0; d < cnt; d++)
+        if (combination[plan.order[d]] == vertex)
+            return false;
+
+    // рёбра с выбранными вершинами должны совпадать с рёбрами паттерна
+    for (const Check &check: plan.checks[cnt]) {
+        int prefixVertex = combination[plan.order[check.depth]];
+        if (check.hasToPrefix && graph.get(vertex, prefixVertex) != check.toPrefix)
+            return false;
+        if (check.hasFromPrefix && graph.get(prefixVertex, vertex) != check.fromPrefix)
+            return false;
+    }
+    return true;
+}
+
+/**
+ * Задать значение элемента матрицы связности
+ *
+ * @param from  номер строки
+ * @param to    номер столбца
+ * @param value новое значение; `0` - удалить ребро
+ * @return изменения вхождений всех зарегистрированных паттернов
+ */
+std::vector<IncrementalPatternMatcher::MatchDelta> IncrementalPatternMatcher::setEdge(int from, int to, int value) {
+    std::vector<MatchDelta> res;
+    setEdge(from, to, value, [&res](int patternId, bool gained, IntSpan c) {
+        res.emplace_back(patternId, gained, c.data(), c.size());
+    });
+    return res;
+}
@@ -0,0 +1,191 @@
+#include "SparsePatternSearch.h"
+
+#include <unordered_map>
+
+/**
+ * Конструктор
+ *
+ * @param source    дата-граф; должен существовать, пока существует объект поиска
+ * @param pattern   искомый паттерн
+ * @param hardCheck флаг, нужна ли жёсткая проверка
+ */
+SparsePatternSearch::SparsePatternSearch(const CsrGraph &source, const Matrix &pattern, bool hardCheck) :
+        graph(source) {
+    this->sourceSize = source.getSize();
+    this->patternSize = pattern.getSize();
+    this->wordsCnt = wordsCount(sourceSize);
+
+    // для каждой пары различных точек паттерна запоминаем, ограничен ли соответствующий
+    // элемент дата-графа: ненулевой элемент паттерна - всегда, нулевой - только при жёсткой проверке
+    constrained.assign(patternSize * patternSize, 0);
+    values.assign(patternSize * patternSize, 0);
+    for (int u = 0; u < patternSize; u++)
+        for (int w = 0; w < patternSize; w++)
+            if (u != w) {
+                values[u * patternSize + w] = pattern.get(u, w);
+                constrained[u * patternSize + w] = hardCheck || pattern.get(u, w) != 0;
+            }
+
+    initCandidates(pattern, hardCheck);
+    initOrder();
+}
+
+/**
+ * Заполнить допустимые вершины точек паттерна
+ *
+ * Вершина дата-графа допустима для точки паттерна, если у неё совпадает петля
+ * (когда она ненулевая в паттерне или проверка жёсткая), и для каждого значения
+ * рёбер паттерна, а при жёсткой проверке и для нулевых рёбер, у неё не меньше
+ * исходящих и входящих рёбер с этим значением, чем у точки паттерна
+ *
+ * @param pattern   искомый паттерн
+ * @param hardCheck флаг, нужна ли жёсткая проверка
+ */
+void SparsePatternSearch::initCandidates(const Matrix &pattern, bool hardCheck) {
+    candidates.assign((long long) patternSize * wordsCnt, 0);
+
+    // виды ограничений на рёбра: значения рёбер паттерна и нулевые рёбра (последний вид)
+    std::unordered_map<int, int> kinds;
+    for (int k = 0; k < patternSize * patternSize; k++)
+        if (constrained[k] && values[k] != 0 && kinds.find(values[k]) == kinds.end()) {
+            int kind = (int) kinds.size();
+            kinds[values[k]] = kind;
+        }
+    int kindsCnt = (int) kinds.size() + 1;
+    int zeroKind = kindsCnt - 1;
+
+    // для каждой точки паттерна считаем кол-во исходящих и входящих рёбер каждого вида
+    std::vector<int> patternOut(patternSize * kindsCnt, 0), patternIn(patternSize * kindsCnt, 0);
+    for (int u = 0; u < patternSize; u++)
+        for (int w = 0; w < patternSize; w++) {
+            if (!constrained[u * patternSize + w])
+                continue;
+            int value = values[u * patternSize + w];
+            int kind = value == 0 ? zeroKind : kinds[value];
+            patternOut[u * kindsCnt + kind]++;
+            patternIn[w * kindsCnt + kind]++;
+        }
+
+    // то же самое для текущей вершины дата-графа
+    std::vector<int> sourceOut(kindsCnt), sourceIn(kindsCnt);
+    for (int vertex = 0; vertex < sourceSize; vertex++) {
+        for (int kind = 0; kind < zeroKind; kind++) {
+            sourceOut[kind] = 0;
+            sourceIn[kind] = 0;
+        }
+        // петли в списки рёбер не входят, поэтому их учитывать не нужно
+        sourceOut[zeroKind] = sourceSize - 1 - graph.getOutDegree(vertex);
+        sourceIn[zeroKind] = sourceSize - 1 - graph.getInDegree(vertex);
+        for (int k = 0; k < graph.getOutDegree(vertex); k++) {
+            auto it = kinds.find(graph.getOutValues(vertex)[k]);
+            if (it != kinds.end())
+                sourceOut[it->second]++;
+        }
+        for (int k = 0; k < graph.getInDegree(vertex); k++) {
+            auto it = kinds.find(graph.getInValues(vertex)[k]);
+            if (it != kinds.end())
+                sourceIn[it->second]++;
+        }
+
+        for (int u = 0; u < patternSize; u++) {
+            // петля должна совпадать, если она ненулевая в паттерне или проверка жёсткая
+            if ((hardCheck || pattern.get(u, u) != 0) && graph.getLoop(vertex) != pattern.get(u, u))
+                continue;
+
+            // рёбра точки паттерна переходят в различные рёбра вершины дата-графа,
+            // поэтому рёбер каждого вида у вершины должно быть не меньше
+            bool enough = true;
+            for (int kind = 0; kind < kindsCnt && enough; kind++)
+                if (sourceOut[kind] < patternOut[u * kindsCnt + kind] ||
+                    sourceIn[kind] < patternIn[u * kindsCnt + kind])
+                    enough = false;
+
+            if (enough)
+                setBit(candidates.data() + (long long) u * wordsCnt, vertex);
+        }
+    }
+}
+
+/**
+ * Построить порядок сопоставления точек паттерна и проверки рёбер для каждой глубины
+ *
+ * Порядок строится так же, как в `FastPatternSearch`: первой идёт точка с наименьшим
+ * кол-вом допустимых вершин, а каждой следующей - точка, у которой больше всего ненулевых
+ * рёбер с уже упорядоченными точками. Так кандидаты почти всех точек берутся из
+ * списков соседей, а не из всех вершин дата-графа
+ */
+void SparsePatternSearch::initOrder() {
+    // кол-во допустимых вершин и кол-во ограничений на рёбра каждой точки
+    std::vector<int> candidatesCnt(patternSize, 0), degrees(patternSize, 0);
+    for (int u = 0; u < patternSize; u++) {
+        candidatesCnt[u] = countBits(candidates.data() + (long long) u * wordsCnt, wordsCnt);
+        for (int w = 0; w < patternSize; w++)
+            degrees[u] += constrained[u * patternSize + w] + constrained[w * patternSize + u];
+    }
+
+    // кол-во ненулевых рёбер между точкой и уже упорядоченными точками
+    std::vector<int> links(patternSize, 0);
+    std::vector<bool> ordered(patternSize, false);
+    order.clear();
+    checks.assign(patternSize, std::vector<Check>());
+
+    while ((int) order.size() < patternSize) {
+        int best = -1;
+        for (int u = 0; u < patternSize; u++) {
+            if (ordered[u])
+                continue;
+            if (best < 0 ||
+                links[u] > links[best] ||
+                (links[u] == links[best] && candidatesCnt[u] < candidatesCnt[best]) ||
+                (links[u] == links[best] && candidatesCnt[u] == candidatesCnt[best] && degrees[u] > degrees[best]))
+                best = u;
+        }
+
+        // проверки рёбер новой точки с уже упорядоченными
+        int depth = (int) order.size();
+        for (int d = 0; d < depth; d++) {
+            int p = order[d];
+            Check check{
+                    d,
+                    (bool) constrained[best * patternSize + p], values[best * patternSize + p],
+                    (bool) constrained[p * patternSize + best], values[p * patternSize + best]
+            };
+            if (check.hasToPrefix || check.hasFromPrefix)
+                checks[depth].push_back(check);
+        }
+
+        order.push_back(best);
+        ordered[best] = true;
+        for (int u = 0; u < patternSize; u++)
+            links[u] += isLink(u, best) + isLink(best, u);
+    }
+}
+
+/**
+ * Проверить, можно ли сопоставить вершину точке паттерна на заданной глубине
+ *
+ * @param combination текущая комбинация в индексах паттерна
+ * @param cnt         глубина
+ * @param vertex      вершина дата-графа
+ * @return флаг, совместима ли вершина со всеми выбранными точками
+ */
+bool SparsePatternSearch::fits(const std::vector<int> &combination, int cnt, int vertex) const {
+    // вершина должна быть допустимой для точки
+    if (!testBit(candidates.data() + (long long) order[cnt] * wordsCnt, vertex))
+        return false;
+
+    // и ещё не занятой
+    for (int d = 0; d < cnt; d++)
+        if (combination[order[d]] == vertex)
+            return false;
+
+    // рёбра с выбранными вершинами должны совпадать с рёбрами паттерна
+    for (const Check &check: checks[cnt]) {
+        int prefixVertex = combination[order[check.depth]];
+        if (check.hasToPrefix && graph.get(vertex, prefixVertex) != check.toPrefix)
+            return false;
+        if (check.hasFromPrefix && graph.get(prefixVertex, vertex) != check.fromPrefix)
+            return false;
+    }
+    return true;
+}
@@ -1,155 +1,437 @@
 #include "fastPatternResolver.h"
+#include "FastPatternSearch.h"
+#include <algorithm>
 
 /**
- * Проверить совпадение самого правого столбца
- * и самой нижней строки подматрицы дата-графа,
- * полученной по соответствующей комбинации
- * (проверяются только новые элементы,
- * они находятся в самом нижнем ряду и в самой правой колонке)
+ * Быстрый поиск изоморфных подграфов
  *
- * @param source      дата-граф
- * @param pattern     паттерн
- * @param combination комбинация
- * @param cnt         кол-во элементов в комбинации
- * @param hardCheck   флаг, нужна ли жёсткая проверка
- * @return флаг, совпадают ли матрицы по углу
+ * @param source        дата-граф
+ * @param sourceSize    размер стороны дата-графа
+ * @param pattern       искомый паттерн
+ * @param patternSize   размер стороны паттерна
+ * @param hardCheck     флаг, нужна ли жёсткая проверка; если `hardCheck` равен `false`, то нулевому элементу паттерна
+ *                      может соответствовать произвольное значение в переставленной подматрице, а если
+ *                      `true`, то все элементы паттерна и переставленной подматрицы должны
+ *                      совпадать с точностью до перестановки.
+ * @return список таких комбинаций точек из источника, чтобы при составлении
+ * соответствующих переставленных подматриц, подграфы, построенные по ним,
+ * были изоморфны заданному паттерну
  */
-bool checkMatrixEdge(
-        int **source, int **pattern, const int *combination, int cnt, bool hardCheck
-) {
-    // перебираем элементы самого нижнего ряда матрицы
-    // и самой правой колонки
-    for (int i = 0; i < cnt; i++) {
-        // если жёсткая проверка
-        if (hardCheck) {
-            // если элемент из паттерна в правом столбце не совпадает с соответствующим
-            // элементом из дата-графа
-            if (pattern[i][cnt - 1] != source[combination[i]][combination[cnt - 1]])
-                // возвращаем флаг, что матрицы не равны по уголку
-                return false;
-            // если элемент из паттерна в нижней строке не совпадает с соответствующим
-            // элементом из дата-графа
-            if (pattern[cnt - 1][i] != source[combination[cnt - 1]][combination[i]])
-                // возвращаем флаг, что матрицы не равны по уголку
-                return false;
-        } else { // если нежёсткая проверка
-            // если элемент из паттерна в правом столбце ненулевой и не совпадает с соответствующим
-            // элементом из дата-графа
-            if (pattern[i][cnt - 1] != 0 && pattern[i][cnt - 1] != source[combination[i]][combination[cnt - 1]])
-                // возвращаем флаг, что матрицы не равны по уголку
-                return false;
-            // если элемент из паттерна в нижней строке ненулевой и не совпадает с соответствующим
-            // элементом из дата-графа
-            if (pattern[cnt - 1][i] != 0 && pattern[cnt - 1][i] != source[combination[cnt - 1]][combination[i]])
-                // возвращаем флаг, что матрицы не равны по уголку
-                return false;
-        }
-    }
+std::vector<CombinatoricsData>
+fastGetAllPatterns(int **source, int sourceSize, int **pattern, int patternSize, bool hardCheck) {
+    return fastGetAllPatterns(Matrix(source, sourceSize), Matrix(pattern, patternSize), hardCheck);
+}
 
-    // если не встречено неравных элементов, то возвращаем флаг, что матрицы равны по уголку
-    return true;
+/**
+ * Быстрый поиск изоморфных подграфов
+ *
+ * @param source    дата-граф
+ * @param pattern   искомый паттерн
+ * @param hardCheck флаг, нужна ли жёсткая проверка
+ * @return список таких комбинаций точек из источника, чтобы при составлении
+ * соответствующих переставленных подматриц, подграфы, построенные по ним,
+ * были изоморфны заданному паттерну
+ */
+std::vector<CombinatoricsData>
+fastGetAllPatterns(const Matrix &source, const Matrix &pattern, bool hardCheck) {
+    // множество найденных паттернов
+    MatchSet res(pattern.getSize());
+    fastGetAllPatterns(source, pattern, hardCheck, res);
+    // возвращаем множество найденных паттернов
+    return res.toCombinations();
 }
 
+/**
+ * Быстрый поиск изоморфных подграфов с записью комбинаций в множество
+ *
+ * @param source    дата-граф
+ * @param pattern   искомый паттерн
+ * @param hardCheck флаг, нужна ли жёсткая проверка
+ * @param res       множество, в конец которого добавляются найденные комбинации
+ *                  в порядке `fastGetAllPatterns`; размер его комбинаций должен совпадать с размером паттерна
+ */
+void fastGetAllPatterns(const Matrix &source, const Matrix &pattern, bool hardCheck, MatchSet &res) {
+    SearchStatistics statistics;
+    fastGetAllPatterns(source, pattern, hardCheck, res, statistics);
+}
 
 /**
- * Шаг поиска паттерна
+ * Быстрый поиск изоморфных подграфов с записью комбинаций в множество и сбором статистики перебора
  *
- * @param consumer      обработчик найденной комбинации
- * @param used          массив флагов, использовалась ли уже i-я точка
- * @param source        дата-граф
- * @param sourceSize    размер стороны дата-графа
- * @param pattern       искомый паттерн
- * @param patternSize   размер стороны искомого паттерна
- * @param sourcePowers  степени вершин источника
- * @param patternPowers степени вершин паттерна
- * @param cnt           кол-во обработанных элементов
- * @param combination   массив комбинации
- * @param hardCheck     флаг, нужна ли жёсткая проверка
- * @param consumer      лямбда выражение (int *c)->{}
- */
-template<typename F>
-void fastFindPatternStep(
-        bool *used, int **source, int sourceSize, int **pattern,
-        int patternSize,
-        int *sourcePowers, int *patternPowers, int cnt, int *combination,
-        bool hardCheck, const F &consumer
+ * @param source     дата-граф
+ * @param pattern    искомый паттерн
+ * @param hardCheck  флаг, нужна ли жёсткая проверка
+ * @param res        множество, в конец которого добавляются найденные комбинации
+ *                   в порядке `fastGetAllPatterns`; размер его комбинаций должен совпадать с размером паттерна
+ * @param statistics статистика, к которой добавляются счётчики построения и перебора
+ */
+void fastGetAllPatterns(
+        const Matrix &source, const Matrix &pattern, bool hardCheck, MatchSet &res, SearchStatistics &statistics
 ) {
-    // если уже выбрана хотя бы одна точка для комбинации и при этом
-    // матрица, составленная из дата-графа по этой комбинации
-    // не совпадает с соответствующей подматрицей паттерна
-    // (нам нужно проверить только новые элементы,
-    // они находятся в самом нижнем ряду и в самой правой колонке)
-    if (cnt > 0 && !checkMatrixEdge(source, pattern, combination, cnt, hardCheck))
-        return;
-
-    // если получено нужное кол-во элементов комбинации
-    if (cnt == patternSize)
-        // обрабатываем её
-        consumer(combination);
-    else
-        // в противном случае перебираем все вершины графа
-        for (int i = 0; i < sourceSize; i++) {
-            // если i-я точка уже использована или её степень меньше степени
-            // следующей точки в паттерне
-            if (used[i] || (hardCheck && sourcePowers[i] < patternPowers[cnt]))
-                continue;
-
-            // говорим, что i-я точка использована
-            used[i] = true;
-            // добавляем индекс точки в комбинацию
-            combination[cnt] = i;
-
-            // вызываем следующий шаг рекурсии
-            fastFindPatternStep(
-                    used, source, sourceSize, pattern, patternSize, sourcePowers,
-                    patternPowers, cnt + 1, combination, hardCheck, consumer
-            );
-
-            // возвращаем значение флага
-            used[i] = false;
-        }
-}
+    if (res.getWidth() != pattern.getSize())
+        throw std::invalid_argument(
+                "fastGetAllPatterns() match set width is not acceptable: " + std::to_string(res.getWidth())
+        );
 
+    // подготавливаем поиск: битовые плоскости и домены точек паттерна
+    FastPatternSearch search(source, pattern, hardCheck);
+
+    // запускаем рекурсию
+    search.run([&res](int *c) {
+        res.add(c);
+        return true;
+    }, &statistics);
+}
 
 /**
- * Быстрый поиск изоморфных подграфов
+ * Быстрый поиск изоморфных подграфов в несколько потоков
  *
  * @param source        дата-граф
- * @param sourceSize    размер стороны дата-графа
  * @param pattern       искомый паттерн
- * @param patternSize   размер стороны паттерна
- * @param hardCheck     флаг, нужна ли жёсткая проверка; если `hardCheck` равен `false`, то нулевому элементу паттерна
- *                      может соответствовать произвольное значение в переставленной подматрице, а если
- *                      `true`, то все элементы паттерна и переставленной подматрицы должны
- *                      совпадать с точностью до перестановки.
+ * @param hardCheck     флаг, нужна ли жёсткая проверка
+ * @param threadCount   кол-во потоков
+ * @param deterministic флаг, нужно ли возвращать комбинации в том же порядке, что и однопоточный поиск
  * @return список таких комбинаций точек из источника, чтобы при составлении
  * соответствующих переставленных подматриц, подграфы, построенные по ним,
  * были изоморфны заданному паттерну
  */
 std::vector<CombinatoricsData>
-fastGetAllPatterns(int **source, int sourceSize, int **pattern, int patternSize, bool hardCheck) {
+fastGetAllPatterns(const Matrix &source, const Matrix &pattern, bool hardCheck, int threadCount, bool deterministic) {
+    if (threadCount < 1)
+        throw std::invalid_argument(
+                "fastGetAllPatterns() thread count is not acceptable: " + std::to_string(threadCount)
+        );
+
+    // в один поток и для пустого паттерна работаем без пула задач
+    if (threadCount == 1 || pattern.getSize() == 0)
+        return fastGetAllPatterns(source, pattern, hardCheck);
+
+    int patternSize = pattern.getSize();
+    // подготавливаем поиск: битовые плоскости и домены точек паттерна
+    FastPatternSearch search(source, pattern, hardCheck);
+
+    // у каждого потока свой буфер найденных комбинаций, записанных подряд
+    std::vector<std::vector<int>> buffers(threadCount);
+    search.runParallel(threadCount, [&buffers, &patternSize](int worker, int *c) {
+        buffers[worker].insert(buffers[worker].end(), c, c + patternSize);
+        return true;
+    });
+
+    // собираем все комбинации в один буфер
+    std::vector<int> all;
+    for (std::vector<int> &buffer: buffers) {
+        all.insert(all.end(), buffer.begin(), buffer.end());
+        std::vector<int>().swap(buffer);
+    }
+    long long cnt = (long long) all.size() / patternSize;
+
+    // индексы комбинаций в итоговом порядке
+    std::vector<long long> indexes(cnt);
+    for (long long i = 0; i < cnt; i++)
+        indexes[i] = i;
+
+    // однопоточный поиск перебирает вершины каждой точки по возрастанию в порядке
+    // сопоставления, поэтому его результат упорядочен лексикографически по комбинации,
+    // переставленной в порядке сопоставления
+    if (deterministic) {
+        const std::vector<int> &order = search.getOrder();
+        std::sort(indexes.begin(), indexes.end(), [&all, &order, &patternSize](long long a, long long b) {
+            for (int u: order) {
+                int va = all[a * patternSize + u];
+                int vb = all[b * patternSize + u];
+                if (va != vb)
+                    return va < vb;
+            }
+            return false;
+        });
+    }
+
     // множество найденных паттернов
     std::vector<CombinatoricsData> res;
-    // флаги, использована ли уже та или иная точка
-    bool *used = new bool[sourceSize];
-    for (int i = 0; i < sourceSize; i++)
-        used[i] = false;
-    // текущая комбинация
-    int *combination = new int[patternSize];
-    // степени вершин в дата-графе
-    int *sourcePowers = getPowers(source, sourceSize);
-    // степени вершин в паттерне
-    int *patternPowers = getPowers(pattern, patternSize);
+    res.reserve(cnt);
+    for (long long i: indexes)
+        res.emplace_back(all.data() + i * patternSize, patternSize);
 
-    // запускаем рекурсию
-    fastFindPatternStep(
-            used, source, sourceSize, pattern, patternSize,
-            sourcePowers, patternPowers, 0, combination, hardCheck, [&res, &patternSize](int *c) {
-                res.emplace_back(CombinatoricsData(c, patternSize));
-            }
+    // возвращаем множество найденных паттернов
+    return res;
+}
+
+/**
+ * Быстрый подсчёт изоморфных подграфов
+ *
+ * @param source    дата-граф
+ * @param pattern   искомый паттерн
+ * @param hardCheck флаг, нужна ли жёсткая проверка
+ * @return кол-во комбинаций, которые вернул бы `fastGetAllPatterns`
+ */
+long long fastCountAllPatterns(const Matrix &source, const Matrix &pattern, bool hardCheck) {
+    // подготавливаем поиск: битовые плоскости и домены точек паттерна
+    FastPatternSearch search(source, pattern, hardCheck);
+    return search.count();
+}
+
+/**
+ * Быстрый подсчёт изоморфных подграфов со сбором статистики перебора
+ *
+ * @param source     дата-граф
+ * @param pattern    искомый паттерн
+ * @param hardCheck  флаг, нужна ли жёсткая проверка
+ * @param statistics статистика, к которой добавляются счётчики построения и перебора
+ * @return кол-во комбинаций, которые вернул бы `fastGetAllPatterns`
+ */
+long long fastCountAllPatterns(
+        const Matrix &source, const Matrix &pattern, bool hardCheck, SearchStatistics &statistics
+) {
+    // подготавливаем поиск: битовые плоскости и домены точек паттерна
+    FastPatternSearch search(source, pattern, hardCheck);
+    return search.count(&statistics);
+}
+
+/**
+ * Быстрый подсчёт изоморфных подграфов в несколько потоков
+ *
+ * @param source      дата-граф
+ * @param pattern     искомый паттерн
+ * @param hardCheck   флаг, нужна ли жёсткая проверка
+ * @param threadCount кол-во потоков
+ * @return кол-во комбинаций, которые вернул бы `fastGetAllPatterns`
+ */
+long long fastCountAllPatterns(const Matrix &source, const Matrix &pattern, bool hardCheck, int threadCount) {
+    if (threadCount < 1)
+        throw std::invalid_argument(
+                "fastCountAllPatterns() thread count is not acceptable: " + std::to_string(threadCount)
+        );
+
+    // подготавливаем поиск: битовые плоскости и домены точек паттерна
+    FastPatternSearch search(source, pattern, hardCheck);
+    return search.countParallel(threadCount);
+}
+
+/**
+ * Быстрый поиск изоморфных подграфов в несколько потоков с асинхронной записью найденных комбинаций
+ *
+ * @param source      дата-граф
+ * @param pattern     искомый паттерн
+ * @param hardCheck   флаг, нужна ли жёсткая проверка
+ * @param threadCount кол-во потоков; производителей у `writer` должно быть не меньше
+ * @param writer      запись комбинаций размера паттерна
+ * @return флаг, был ли перебор доведён до конца, а не остановлен ошибкой записи
+ */
+bool fastWriteAllPatterns(
+        const Matrix &source, const Matrix &pattern, bool hardCheck, int threadCount, MatchWriter &writer
+) {
+    if (writer.getWidth() != pattern.getSize())
+        throw std::invalid_argument(
+                "fastWriteAllPatterns() writer width is not acceptable: " + std::to_string(writer.getWidth())
+        );
+    if (threadCount > writer.getProducerCount())
+        throw std::invalid_argument(
+                "fastWriteAllPatterns() thread count: " + std::to_string(threadCount) +
+                " is greater than writer producer count: " + std::to_string(writer.getProducerCount())
+        );
+    // номер потока поиска - номер производителя записи
+    return fastForEachPattern(source, pattern, hardCheck, threadCount, [&writer](int worker, IntSpan c) {
+        return writer.add(worker, c.data());
+    });
+}
+
+/**
+ * Быстрый поиск изоморфных подграфов, начинающийся с позиций самого редкого значения ребра паттерна
+ *
+ * @param source    дата-граф
+ * @param pattern   искомый паттерн
+ * @param hardCheck флаг, нужна ли жёсткая проверка
+ * @param index     индекс значений рёбер дата-графа
+ * @return список комбинаций, совпадающий как множество с результатом `fastGetAllPatterns`
+ */
+std::vector<CombinatoricsData>
+fastGetAllPatterns(const Matrix &source, const Matrix &pattern, bool hardCheck, const EdgeValueIndex &index) {
+    int patternSize = pattern.getSize();
+    // множество найденных паттернов
+    std::vector<CombinatoricsData> res;
+
+    // подготавливаем поиск: битовые плоскости, домены и позиции самого редкого ребра
+    FastPatternSearch search(source, pattern, hardCheck, index);
+
+    search.run([&res, &patternSize](int *c) {
+        res.emplace_back(c, patternSize);
+        return true;
+    });
+
+    // возвращаем множество найденных паттернов
+    return res;
+}
+
+/**
+ * Быстрый подсчёт изоморфных подграфов, начинающийся с позиций самого редкого значения ребра паттерна
+ *
+ * @param source    дата-граф
+ * @param pattern   искомый паттерн
+ * @param hardCheck флаг, нужна ли жёсткая проверка
+ * @param index     индекс значений рёбер дата-графа
+ * @return кол-во комбинаций, которые вернул бы `fastGetAllPatterns`
+ */
+long long fastCountAllPatterns(
+        const Matrix &source, const Matrix &pattern, bool hardCheck, const EdgeValueIndex &index
+) {
+    return FastPatternSearch(source, pattern, hardCheck, index).count();
+}
+
+/**
+ * Проверить, входит ли паттерн в дата-граф хотя бы один раз
+ *
+ * @param source    дата-граф
+ * @param pattern   искомый паттерн
+ * @param hardCheck флаг, нужна ли жёсткая проверка
+ * @return флаг, найдено ли хотя бы одно вхождение
+ */
+bool fastContainsPattern(const Matrix &source, const Matrix &pattern, bool hardCheck) {
+    return !fastFindFirstPatterns(source, pattern, hardCheck, 1).empty();
+}
+
+/**
+ * Найти первые `k` вхождений паттерна
+ *
+ * @param source    дата-граф
+ * @param pattern   искомый паттерн
+ * @param hardCheck флаг, нужна ли жёсткая проверка
+ * @param k         максимальное кол-во вхождений
+ * @return не более `k` комбинаций; меньше, только если других вхождений нет
+ */
+std::vector<CombinatoricsData>
+fastFindFirstPatterns(const Matrix &source, const Matrix &pattern, bool hardCheck, long long k) {
+    if (k < 0)
+        throw std::invalid_argument("fastFindFirstPatterns() k is not acceptable: " + std::to_string(k));
+
+    int patternSize = pattern.getSize();
+    // множество найденных паттернов
+    std::vector<CombinatoricsData> res;
+    if (k == 0)
+        return res;
+
+    // подготавливаем поиск: битовые плоскости и домены точек паттерна
+    FastPatternSearch search(source, pattern, hardCheck);
+
+    // обработчик останавливает перебор, как только найдено k вхождений
+    auto consumer = [&res, &patternSize, &k](int *c) {
+        res.emplace_back(CombinatoricsData(c, patternSize));
+        return (long long) res.size() < k;
+    };
+
+    // пустой паттерн входит в любой дата-граф ровно один раз
+    if (patternSize == 0) {
+        search.run(consumer);
+        return res;
+    }
+
+    // перебираем поддеревья, начиная с самых перспективных
+    FastPatternSearch::SearchState state = search.createState();
+    for (int root: search.getPromisingRoots())
+        if (!search.runPrefix(state, {root}, consumer))
+            break;
+
+    // возвращаем множество найденных паттернов
+    return res;
+}
+
+/**
+ * Быстрый поиск изоморфных подграфов без повторов из-за симметрий паттерна
+ *
+ * @param source    дата-граф
+ * @param pattern   искомый паттерн
+ * @param hardCheck флаг, нужна ли жёсткая проверка
+ * @return по одной комбинации на каждый найденный подграф
+ */
+std::vector<CombinatoricsData>
+fastGetAllUniquePatterns(const Matrix &source, const Matrix &pattern, bool hardCheck) {
+    int patternSize = pattern.getSize();
+    // множество найденных паттернов
+    std::vector<CombinatoricsData> res;
+
+    fastForEachUniquePattern(source, pattern, hardCheck, [&res, &patternSize](IntSpan c) {
+        res.emplace_back(CombinatoricsData(c.data(), patternSize));
+        return true;
+    });
+
+    // возвращаем множество найденных паттернов
+    return res;
+}
+
+/**
+ * Быстрый подсчёт изоморфных подграфов без повторов из-за симметрий паттерна
+ *
+ * @param source    дата-граф
+ * @param pattern   искомый паттерн
+ * @param hardCheck флаг, нужна ли жёсткая проверка
+ * @return кол-во комбинаций, которые вернул бы `fastGetAllUniquePatterns`
+ */
+long long fastCountAllUniquePatterns(const Matrix &source, const Matrix &pattern, bool hardCheck) {
+    // подготавливаем поиск с ограничениями порядка, отсекающими симметричные комбинации
+    FastPatternSearch search(
+            source, pattern, hardCheck, getSymmetryBreakingConstraints(getAutomorphisms(pattern))
     );
+    return search.count();
+}
+
+/**
+ * Быстрый поиск изоморфных подграфов в одной части перебора
+ *
+ * @param source     дата-граф
+ * @param pattern    искомый паттерн
+ * @param hardCheck  флаг, нужна ли жёсткая проверка
+ * @param shardIndex номер части, от `0` до `shardCount - 1`
+ * @param shardCount кол-во частей
+ * @return список комбинаций, найденных в этой части перебора
+ */
+std::vector<CombinatoricsData>
+fastGetAllPatternsShard(const Matrix &source, const Matrix &pattern, bool hardCheck, int shardIndex, int shardCount) {
+    int patternSize = pattern.getSize();
+    // множество найденных паттернов
+    std::vector<CombinatoricsData> res;
+
+    // подготавливаем поиск: битовые плоскости и домены точек паттерна
+    FastPatternSearch search(source, pattern, hardCheck);
+
+    // пустой паттерн целиком относится к нулевой части
+    if (patternSize == 0) {
+        if (shardIndex == 0)
+            search.run([&res](int *c) {
+                res.emplace_back(CombinatoricsData(c, 0));
+                return true;
+            });
+        return res;
+    }
+
+    // перебираем только поддеревья своей части
+    FastPatternSearch::SearchState state = search.createState();
+    for (int root: search.getShardRoots(shardIndex, shardCount))
+        search.runPrefix(state, {root}, [&res, &patternSize](int *c) {
+            res.emplace_back(CombinatoricsData(c, patternSize));
+            return true;
+        });
 
     // возвращаем множество найденных паттернов
     return res;
 }
 
+/**
+ * Быстрый поиск изоморфных подграфов сразу для нескольких паттернов
+ *
+ * @param source    дата-граф
+ * @param patterns  искомые паттерны
+ * @param hardCheck флаг, нужна ли жёсткая проверка
+ * @return для каждого паттерна - список комбинаций, совпадающий как множество
+ * с результатом `fastGetAllPatterns` для этого паттерна
+ */
+std::vector<std::vector<CombinatoricsData>>
+fastGetAllPatternsBatch(const Matrix &source, const std::vector<Matrix> &patterns, bool hardCheck) {
+    // множества найденных паттернов по номерам паттернов
+    std::vector<std::vector<CombinatoricsData>> res(patterns.size());
+
+    fastForEachPatternBatch(source, patterns, hardCheck, [&res](int patternId, IntSpan c) {
+        res[patternId].emplace_back(CombinatoricsData(c.data(), (int) c.size()));
+        return true;
+    });
+
+    return res;
+}
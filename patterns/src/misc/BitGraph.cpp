@@ -0,0 +1,55 @@
+#include "misc/BitGraph.h"
+
+/**
+ * Конструктор
+ *
+ * @param source дата-граф
+ * @param values ненулевые значения, для которых нужно построить битовые плоскости
+ */
+BitGraph::BitGraph(const Matrix &source, const std::vector<int> &values) {
+    this->sz = source.getSize();
+    this->wordsCnt = wordsCount(sz);
+
+    // размер одной битовой матрицы в словах
+    long long matrixWords = (long long) sz * wordsCnt;
+
+    nonZeroOut.assign(matrixWords, 0);
+    nonZeroIn.assign(matrixWords, 0);
+
+    // заводим по плоскости на каждое различное ненулевое значение
+    for (int value: values)
+        if (value != 0 && planes.find(value) == planes.end()) {
+            planes[value] = (int) valueOut.size();
+            valueOut.emplace_back(matrixWords, 0);
+            valueIn.emplace_back(matrixWords, 0);
+        }
+
+    // перебираем все элементы матрицы
+    for (int i = 0; i < sz; i++) {
+        const int *row = source.getRow(i);
+        for (int j = 0; j < sz; j++) {
+            if (row[j] == 0)
+                continue;
+            // отмечаем ненулевое ребро из i-ой вершины в j-ую
+            setBit(nonZeroOut.data() + (long long) i * wordsCnt, j);
+            setBit(nonZeroIn.data() + (long long) j * wordsCnt, i);
+            // если для значения строится плоскость, отмечаем ребро и в ней
+            int plane = getPlane(row[j]);
+            if (plane >= 0) {
+                setBit(valueOut[plane].data() + (long long) i * wordsCnt, j);
+                setBit(valueIn[plane].data() + (long long) j * wordsCnt, i);
+            }
+        }
+    }
+}
+
+/**
+ * Получить номер битовой плоскости значения
+ *
+ * @param value значение
+ * @return номер плоскости или -1, если для значения плоскость не строилась
+ */
+int BitGraph::getPlane(int value) const {
+    auto it = planes.find(value);
+    return it == planes.end() ? -1 : it->second;
+}
@@ -1,4 +1,5 @@
 #include "misc/CombinatoricsData.h"
+#include <utility>
 
 /**
  * Конструктор
@@ -13,6 +14,43 @@ CombinatoricsData::CombinatoricsData(const int *data, int sz) {
     this->sz = sz;
 }
 
+/**
+ * Конструктор копирования; копия всегда владеет своей памятью
+ *
+ * @param other исходная последовательность
+ */
+CombinatoricsData::CombinatoricsData(const CombinatoricsData &other) : CombinatoricsData(other.data, other.sz) {
+}
+
+/**
+ * Конструктор перемещения
+ *
+ * @param other исходная последовательность
+ */
+CombinatoricsData::CombinatoricsData(CombinatoricsData &&other) noexcept: data(other.data), sz(other.sz) {
+    other.data = nullptr;
+    other.sz = 0;
+}
+
+/**
+ * Оператор присваивания
+ *
+ * @param other исходная последовательность
+ * @return ссылка на эту последовательность
+ */
+CombinatoricsData &CombinatoricsData::operator=(CombinatoricsData other) noexcept {
+    std::swap(data, other.data);
+    std::swap(sz, other.sz);
+    return *this;
+}
+
+/**
+ * Деструктор
+ */
+CombinatoricsData::~CombinatoricsData() {
+    delete[] data;
+}
+
 /**
  * Получить элементы последовательности
  * @return элементы последовательности
@@ -21,6 +59,14 @@ int *CombinatoricsData::getData() {
     return this->data;
 }
 
+/**
+ * Получить элементы последовательности
+ * @return элементы последовательности
+ */
+const int *CombinatoricsData::getData() const {
+    return this->data;
+}
+
 /**
  * Получить размер последовательности
  * @return размер последовательности
@@ -0,0 +1,256 @@
+#include "misc/CsrGraph.h"
+
+#include <algorithm>
+#include <utility>
+
+/**
+ * Конструктор пустого графа
+ */
+CsrGraph::CsrGraph() : sz(0), ownOutOffsets(1, 0), ownInOffsets(1, 0) {
+    bind();
+}
+
+/**
+ * Конструктор по списку рёбер
+ *
+ * @param vertexCount кол-во вершин
+ * @param edges       рёбра в произвольном порядке
+ */
+CsrGraph::CsrGraph(int vertexCount, std::vector<Edge> edges) {
+    if (vertexCount < 0)
+        throw std::invalid_argument("CsrGraph() vertex count is not acceptable: " + std::to_string(vertexCount));
+
+    this->sz = vertexCount;
+    ownLoops.assign(sz, 0);
+
+    for (const Edge &edge: edges)
+        if (edge.from < 0 || edge.from >= sz || edge.to < 0 || edge.to >= sz)
+            throw std::invalid_argument(
+                    "CsrGraph() edge is out of range: " + std::to_string(edge.from) + " " + std::to_string(edge.to)
+            );
+
+    // сортируем рёбра по началу, а затем по концу: так сразу получаются списки исходящих рёбер
+    std::sort(edges.begin(), edges.end(), [](const Edge &a, const Edge &b) {
+        return a.from != b.from ? a.from < b.from : a.to < b.to;
+    });
+
+    ownOutOffsets.assign((long long) sz + 1, 0);
+    for (long long k = 0; k < (long long) edges.size(); k++) {
+        const Edge &edge = edges[k];
+        if (k > 0 && edges[k - 1].from == edge.from && edges[k - 1].to == edge.to)
+            throw std::invalid_argument(
+                    "CsrGraph() edge is duplicated: " + std::to_string(edge.from) + " " + std::to_string(edge.to)
+            );
+        if (edge.value == 0)
+            continue;
+        // петли хранятся отдельно
+        if (edge.from == edge.to) {
+            ownLoops[edge.from] = edge.value;
+            continue;
+        }
+        ownOutTargets.push_back(edge.to);
+        ownOutValues.push_back(edge.value);
+        ownOutOffsets[edge.from + 1]++;
+    }
+    for (int i = 0; i < sz; i++)
+        ownOutOffsets[i + 1] += ownOutOffsets[i];
+
+    buildIn();
+    bind();
+}
+
+/**
+ * Конструктор по плотной матрице связности
+ *
+ * @param source матрица связности
+ */
+CsrGraph::CsrGraph(const Matrix &source) {
+    this->sz = source.getSize();
+    ownLoops.assign(sz, 0);
+    ownOutOffsets.assign((long long) sz + 1, 0);
+
+    // строки матрицы перебираются по возрастанию столбцов, поэтому списки сразу отсортированы
+    for (int i = 0; i < sz; i++) {
+        const int *row = source.getRow(i);
+        for (int j = 0; j < sz; j++) {
+            if (row[j] == 0)
+                continue;
+            if (i == j) {
+                ownLoops[i] = row[j];
+                continue;
+            }
+            ownOutTargets.push_back(j);
+            ownOutValues.push_back(row[j]);
+        }
+        ownOutOffsets[i + 1] = (long long) ownOutTargets.size();
+    }
+
+    buildIn();
+    bind();
+}
+
+/**
+ * Построить списки входящих рёбер по спискам исходящих
+ *
+ * Исходящие рёбра перебираются по возрастанию начала, поэтому раскладка подсчётом
+ * сразу даёт списки входящих рёбер, отсортированные по номеру соседа
+ */
+void CsrGraph::buildIn() {
+    long long cnt = (long long) ownOutTargets.size();
+
+    // считаем кол-во входящих рёбер каждой вершины
+    ownInOffsets.assign((long long) sz + 1, 0);
+    for (long long k = 0; k < cnt; k++)
+        ownInOffsets[ownOutTargets[k] + 1]++;
+    for (int j = 0; j < sz; j++)
+        ownInOffsets[j + 1] += ownInOffsets[j];
+
+    // раскладываем рёбра по спискам
+    ownInSources.assign(cnt, 0);
+    ownInValues.assign(cnt, 0);
+    std::vector<long long> positions(ownInOffsets.begin(), ownInOffsets.end() - 1);
+    for (int i = 0; i < sz; i++)
+        for (long long k = ownOutOffsets[i]; k < ownOutOffsets[i + 1]; k++) {
+            long long position = positions[ownOutTargets[k]]++;
+            ownInSources[position] = i;
+            ownInValues[position] = ownOutValues[k];
+        }
+}
+
+/**
+ * Направить указатели на собственные массивы
+ */
+void CsrGraph::bind() {
+    owner = true;
+    edgesCnt = (long long) ownOutTargets.size();
+    loops = ownLoops.data();
+    outOffsets = ownOutOffsets.data();
+    outTargets = ownOutTargets.data();
+    outValues = ownOutValues.data();
+    inOffsets = ownInOffsets.data();
+    inSources = ownInSources.data();
+    inValues = ownInValues.data();
+}
+
+/**
+ * Конструктор представления чужих массивов; граф не владеет памятью и не освобождает её
+ *
+ * @param vertexCount кол-во вершин
+ * @param edgeCount   кол-во рёбер без учёта петель
+ * @param loops       значения петель: `vertexCount` элементов
+ * @param outOffsets  начала списков исходящих рёбер: `vertexCount + 1` элементов
+ * @param outTargets  вершины, в которые идут исходящие рёбра: `edgeCount` элементов
+ * @param outValues   значения исходящих рёбер: `edgeCount` элементов
+ * @param inOffsets   начала списков входящих рёбер: `vertexCount + 1` элементов
+ * @param inSources   вершины, из которых идут входящие рёбра: `edgeCount` элементов
+ * @param inValues    значения входящих рёбер: `edgeCount` элементов
+ */
+CsrGraph::CsrGraph(int vertexCount, long long edgeCount, const int *loops,
+                   const long long *outOffsets, const int *outTargets, const int *outValues,
+                   const long long *inOffsets, const int *inSources, const int *inValues) :
+        sz(vertexCount), edgesCnt(edgeCount), loops(loops), outOffsets(outOffsets), outTargets(outTargets),
+        outValues(outValues), inOffsets(inOffsets), inSources(inSources), inValues(inValues), owner(false) {
+    if (vertexCount < 0 || edgeCount < 0)
+        throw std::invalid_argument(
+                "CsrGraph() vertex count: " + std::to_string(vertexCount) +
+                " or edge count: " + std::to_string(edgeCount) + " is not acceptable"
+        );
+}
+
+/**
+ * Конструктор копирования; копия представления остаётся представлением тех же массивов
+ *
+ * @param other исходный граф
+ */
+CsrGraph::CsrGraph(const CsrGraph &other) :
+        sz(other.sz), edgesCnt(other.edgesCnt), loops(other.loops), outOffsets(other.outOffsets),
+        outTargets(other.outTargets), outValues(other.outValues), inOffsets(other.inOffsets),
+        inSources(other.inSources), inValues(other.inValues), owner(other.owner),
+        ownLoops(other.ownLoops), ownOutOffsets(other.ownOutOffsets), ownOutTargets(other.ownOutTargets),
+        ownOutValues(other.ownOutValues), ownInOffsets(other.ownInOffsets), ownInSources(other.ownInSources),
+        ownInValues(other.ownInValues) {
+    // указатели копии должны вести на её собственные массивы
+    if (owner)
+        bind();
+}
+
+/**
+ * Конструктор перемещения
+ *
+ * Перемещённые массивы сохраняют свою память, поэтому указатели остаются верными
+ *
+ * @param other исходный граф
+ */
+CsrGraph::CsrGraph(CsrGraph &&other) noexcept:
+        sz(other.sz), edgesCnt(other.edgesCnt), loops(other.loops), outOffsets(other.outOffsets),
+        outTargets(other.outTargets), outValues(other.outValues), inOffsets(other.inOffsets),
+        inSources(other.inSources), inValues(other.inValues), owner(other.owner),
+        ownLoops(std::move(other.ownLoops)), ownOutOffsets(std::move(other.ownOutOffsets)),
+        ownOutTargets(std::move(other.ownOutTargets)), ownOutValues(std::move(other.ownOutValues)),
+        ownInOffsets(std::move(other.ownInOffsets)), ownInSources(std::move(other.ownInSources)),
+        ownInValues(std::move(other.ownInValues)) {
+    // исходный граф становится пустым
+    other.sz = 0;
+    other.ownOutOffsets.assign(1, 0);
+    other.ownInOffsets.assign(1, 0);
+    other.bind();
+}
+
+/**
+ * Оператор присваивания
+ *
+ * @param other исходный граф
+ * @return ссылка на этот граф
+ */
+CsrGraph &CsrGraph::operator=(CsrGraph other) noexcept {
+    // обмен массивов сохраняет их память, поэтому указатели остаются верными
+    std::swap(sz, other.sz);
+    std::swap(edgesCnt, other.edgesCnt);
+    std::swap(loops, other.loops);
+    std::swap(outOffsets, other.outOffsets);
+    std::swap(outTargets, other.outTargets);
+    std::swap(outValues, other.outValues);
+    std::swap(inOffsets, other.inOffsets);
+    std::swap(inSources, other.inSources);
+    std::swap(inValues, other.inValues);
+    std::swap(owner, other.owner);
+    ownLoops.swap(other.ownLoops);
+    ownOutOffsets.swap(other.ownOutOffsets);
+    ownOutTargets.swap(other.ownOutTargets);
+    ownOutValues.swap(other.ownOutValues);
+    ownInOffsets.swap(other.ownInOffsets);
+    ownInSources.swap(other.ownInSources);
+    ownInValues.swap(other.ownInValues);
+    return *this;
+}
+
+/**
+ * Получить значение элемента матрицы связности двоичным поиском по списку рёбер
+ *
+ * @param i номер строки
+ * @param j номер столбца
+ * @return значение ребра из i-ой вершины в j-ую или `0`, если ребра нет
+ */
+int CsrGraph::get(int i, int j) const {
+    if (i == j)
+        return loops[i];
+    const int *begin = getOutTargets(i);
+    const int *end = begin + getOutDegree(i);
+    const int *it = std::lower_bound(begin, end, j);
+    return it != end && *it == j ? getOutValues(i)[it - begin] : 0;
+}
+
+/**
+ * Получить плотную матрицу связности
+ * @return матрица связности
+ */
+Matrix CsrGraph::toMatrix() const {
+    Matrix res(sz);
+    for (int i = 0; i < sz; i++) {
+        int *row = res.getRow(i);
+        row[i] = loops[i];
+        for (int k = 0; k < getOutDegree(i); k++)
+            row[getOutTargets(i)[k]] = getOutValues(i)[k];
+    }
+    return res;
+}
@@ -0,0 +1,126 @@
+#include "misc/DynamicGraph.h"
+
+#include <algorithm>
+
+/**
+ * Задать значение ребра с соседом
+ *
+ * @param vertex сосед
+ * @param value  новое значение; `0` - удалить ребро
+ */
+void DynamicGraph::Adjacency::set(int vertex, int value) {
+    auto it = std::lower_bound(vertices.begin(), vertices.end(), vertex);
+    long long position = it - vertices.begin();
+    bool exists = it != vertices.end() && *it == vertex;
+
+    if (value == 0) {
+        // удаляем ребро, если оно есть
+        if (exists) {
+            vertices.erase(it);
+            values.erase(values.begin() + position);
+        }
+    } else if (exists)
+        values[position] = value;
+    else {
+        // вставляем ребро, сохраняя порядок соседей
+        vertices.insert(it, vertex);
+        values.insert(values.begin() + position, value);
+    }
+}
+
+/**
+ * Конструктор графа без рёбер
+ *
+ * @param vertexCount кол-во вершин
+ */
+DynamicGraph::DynamicGraph(int vertexCount) {
+    if (vertexCount < 0)
+        throw std::invalid_argument("DynamicGraph() vertex count is not acceptable: " + std::to_string(vertexCount));
+
+    this->sz = vertexCount;
+    this->edgesCnt = 0;
+    loops.assign(sz, 0);
+    out.resize(sz);
+    in.resize(sz);
+}
+
+/**
+ * Конструктор по разреженному графу
+ *
+ * @param source разреженный граф
+ */
+DynamicGraph::DynamicGraph(const CsrGraph &source) : DynamicGraph(source.getSize()) {
+    this->edgesCnt = source.getEdgeCount();
+    // списки `CsrGraph` уже отсортированы, поэтому их можно просто скопировать
+    for (int i = 0; i < sz; i++) {
+        loops[i] = source.getLoop(i);
+        out[i].vertices.assign(source.getOutTargets(i), source.getOutTargets(i) + source.getOutDegree(i));
+        out[i].values.assign(source.getOutValues(i), source.getOutValues(i) + source.getOutDegree(i));
+        in[i].vertices.assign(source.getInSources(i), source.getInSources(i) + source.getInDegree(i));
+        in[i].values.assign(source.getInValues(i), source.getInValues(i) + source.getInDegree(i));
+    }
+}
+
+/**
+ * Конструктор по плотной матрице связности
+ *
+ * @param source матрица связности
+ */
+DynamicGraph::DynamicGraph(const Matrix &source) : DynamicGraph(CsrGraph(source)) {
+}
+
+/**
+ * Получить значение элемента матрицы связности двоичным поиском по списку рёбер
+ *
+ * @param i номер строки
+ * @param j номер столбца
+ * @return значение ребра из i-ой вершины в j-ую или `0`, если ребра нет
+ */
+int DynamicGraph::get(int i, int j) const {
+    if (i == j)
+        return loops[i];
+    const std::vector<int> &vertices = out[i].vertices;
+    auto it = std::lower_bound(vertices.begin(), vertices.end(), j);
+    return it != vertices.end() && *it == j ? out[i].values[it - vertices.begin()] : 0;
+}
+
+/**
+ * Задать значение элемента матрицы связности
+ *
+ * @param i     номер строки
+ * @param j     номер столбца
+ * @param value новое значение; `0` - удалить ребро
+ * @return прежнее значение
+ */
+int DynamicGraph::set(int i, int j, int value) {
+    if (i < 0 || i >= sz || j < 0 || j >= sz)
+        throw std::invalid_argument(
+                "DynamicGraph::set() edge is out of range: " + std::to_string(i) + " " + std::to_string(j)
+        );
+
+    int prev = get(i, j);
+    if (i == j) {
+        loops[i] = value;
+        return prev;
+    }
+
+    edgesCnt += (value != 0) - (prev != 0);
+    out[i].set(j, value);
+    in[j].set(i, value);
+    return prev;
+}
+
+/**
+ * Получить плотную матрицу связности
+ * @return матрица связности
+ */
+Matrix DynamicGraph::toMatrix() const {
+    Matrix res(sz);
+    for (int i = 0; i < sz; i++) {
+        int *row = res.getRow(i);
+        row[i] = loops[i];
+        for (int k = 0; k < getOutDegree(i); k++)
+            row[getOutTargets(i)[k]] = getOutValues(i)[k];
+    }
+    return res;
+}
@@ -0,0 +1,64 @@
+#include "misc/EdgeValueIndex.h"
+
+/**
+ * Конструктор по плотной матрице связности
+ *
+ * @param source матрица связности
+ */
+EdgeValueIndex::EdgeValueIndex(const Matrix &source) {
+    std::vector<std::pair<int, Position>> edges;
+    for (int i = 0; i < source.getSize(); i++) {
+        const int *row = source.getRow(i);
+        for (int j = 0; j < source.getSize(); j++)
+            if (i != j && row[j] != 0)
+                edges.emplace_back(row[j], Position{i, j});
+    }
+    build(edges);
+}
+
+/**
+ * Конструктор по разреженному графу
+ *
+ * @param source разреженный граф
+ */
+EdgeValueIndex::EdgeValueIndex(const CsrGraph &source) {
+    std::vector<std::pair<int, Position>> edges;
+    edges.reserve(source.getEdgeCount());
+    // петли хранятся отдельно от списков рёбер, поэтому в индекс не попадают
+    for (int i = 0; i < source.getSize(); i++)
+        for (int k = 0; k < source.getOutDegree(i); k++)
+            edges.emplace_back(source.getOutValues(i)[k], Position{i, source.getOutTargets(i)[k]});
+    build(edges);
+}
+
+/**
+ * Разложить рёбра по группам значений
+ *
+ * Рёбра раскладываются подсчётом: сначала считается размер каждой группы, затем
+ * рёбра записываются на свои места, поэтому порядок внутри группы сохраняется
+ *
+ * @param edges рёбра: значение и позиция
+ */
+void EdgeValueIndex::build(const std::vector<std::pair<int, Position>> &edges) {
+    // заводим группы и считаем их размеры
+    std::vector<long long> counts;
+    for (const std::pair<int, Position> &edge: edges) {
+        auto it = groups.find(edge.first);
+        if (it == groups.end()) {
+            groups[edge.first] = (int) counts.size();
+            counts.push_back(1);
+        } else
+            counts[it->second]++;
+    }
+
+    // начала групп
+    offsets.assign(counts.size() + 1, 0);
+    for (int g = 0; g < (int) counts.size(); g++)
+        offsets[g + 1] = offsets[g] + counts[g];
+
+    // раскладываем позиции по группам
+    std::vector<long long> next(offsets.begin(), offsets.end() - 1);
+    positions.resize(edges.size());
+    for (const std::pair<int, Position> &edge: edges)
+        positions[next[groups[edge.first]]++] = edge.second;
+}
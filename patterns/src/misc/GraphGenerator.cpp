@@ -0,0 +1,380 @@
+#include "misc/GraphGenerator.h"
+#include <cmath>
+
+/**
+ * Кол-во рёбер R-MAT в одной части генерации; части получают потоки случайных чисел
+ * по своим номерам, поэтому результат не зависит от кол-ва потоков заполнения
+ */
+static const long long RMAT_CHUNK = 1 << 16;
+
+/**
+ * Конструктор
+ *
+ * @param seed        зерно
+ * @param threadCount кол-во потоков заполнения
+ */
+GraphGenerator::GraphGenerator(uint64_t seed, int threadCount) {
+    if (threadCount < 1)
+        throw std::invalid_argument(
+                "GraphGenerator() thread count is not acceptable: " + std::to_string(threadCount)
+        );
+    this->seed = seed;
+    this->streams = 0;
+    this->threadCount = threadCount;
+}
+
+/**
+ * Проверить кол-во вершин и значений рёбер модели
+ *
+ * @param method     название метода для сообщения об ошибке
+ * @param n          кол-во вершин
+ * @param valueRange кол-во различных значений рёбер
+ */
+static void checkModel(const std::string &method, int n, int valueRange) {
+    if (n < 0)
+        throw std::invalid_argument(method + " vertex count is not acceptable: " + std::to_string(n));
+    if (valueRange < 1)
+        throw std::invalid_argument(method + " value range is not acceptable: " + std::to_string(valueRange));
+}
+
+/**
+ * Получить случайную перестановку перетасовкой Фишера-Йетса за `O(n)`
+ *
+ * @param n размер перестановки
+ * @return перестановка чисел `[0, n)`
+ */
+std::vector<int> GraphGenerator::permutation(int n) {
+    if (n < 0)
+        throw std::invalid_argument("GraphGenerator::permutation() size is not acceptable: " + std::to_string(n));
+    Random random(nextStream());
+    std::vector<int> res(n);
+    for (int i = 0; i < n; i++)
+        res[i] = i;
+    for (int i = n - 1; i > 0; i--)
+        std::swap(res[i], res[random.nextInt(i + 1)]);
+    return res;
+}
+
+/**
+ * Получить случайную комбинацию выборочным отбором за `O(n)` без дополнительной памяти
+ *
+ * Каждый элемент по порядку берётся с вероятностью `(кол-во ещё не выбранных) /
+ * (кол-во ещё не просмотренных)`, поэтому все комбинации равновероятны, а результат
+ * сразу упорядочен
+ *
+ * @param n кол-во элементов множества
+ * @param k размер комбинации
+ * @return `k` различных чисел из `[0, n)` по возрастанию
+ */
+std::vector<int> GraphGenerator::combination(int n, int k) {
+    if (k < 0 || k > n)
+        throw std::invalid_argument(
+                "GraphGenerator::combination() arr size: " + std::to_string(n) + " elems cnt " + std::to_string(k)
+        );
+    Random random(nextStream());
+    std::vector<int> res;
+    res.reserve(k);
+    for (int i = 0; i < n && (int) res.size() < k; i++)
+        if (random.nextInt(n - i) < k - (int) res.size())
+            res.push_back(i);
+    return res;
+}
+
+/**
+ * Получить случайную матрицу
+ *
+ * @param n           размер стороны матрицы
+ * @param minVal      минимальное значение элемента
+ * @param maxVal      максимальное значение элемента, не включая его
+ * @param nonZeroPart доля ненулевых элементов
+ * @return матрица
+ */
+Matrix GraphGenerator::uniformMatrix(int n, int minVal, int maxVal, double nonZeroPart) {
+    if (n < 0 || maxVal <= minVal)
+        throw std::invalid_argument(
+                "GraphGenerator::uniformMatrix() size: " + std::to_string(n) +
+                " values: " + std::to_string(minVal) + " " + std::to_string(maxVal)
+        );
+    uint64_t stream = nextStream();
+    Matrix res(n);
+    // каждая строка заполняется своим потоком случайных чисел
+    parallelFor(n, [&res, &stream, &n, &minVal, &maxVal, &nonZeroPart](long long from, long long to, int) {
+        for (long long i = from; i < to; i++) {
+            Random random(mix(stream, (uint64_t) i));
+            int *row = res.getRow((int) i);
+            for (int j = 0; j < n; j++)
+                if (random.nextDouble() < nonZeroPart)
+                    row[j] = minVal + random.nextInt(maxVal - minVal);
+        }
+    });
+    return res;
+}
+
+/**
+ * Перебрать рёбра строки графа Эрдёша-Реньи
+ *
+ * Длина пропуска между соседними рёбрами строки распределена геометрически,
+ * поэтому на строку тратится время, пропорциональное кол-ву её рёбер
+ *
+ * @param stream     зерно вызова
+ * @param i          номер строки
+ * @param n          кол-во вершин
+ * @param p          вероятность ребра
+ * @param valueRange кол-во различных значений рёбер
+ * @param consumer   лямбда выражение (int j, int value), получающее рёбра по возрастанию столбца
+ */
+template<typename F>
+void GraphGenerator::forEachErdosRenyiEdge(
+        uint64_t stream, int i, int n, double p, int valueRange, const F &consumer
+) {
+    if (p <= 0)
+        return;
+    Random random(mix(stream, (uint64_t) i));
+    // позиции строки без диагонали: 0..n-2
+    long long slots = (long long) n - 1;
+    double logQ = std::log1p(-p);
+    for (long long pos = -1;;) {
+        if (p >= 1)
+            pos++;
+        else {
+            double skip = std::floor(std::log1p(-random.nextDouble()) / logQ);
+            if (skip >= (double) slots)
+                break;
+            pos += 1 + (long long) skip;
+        }
+        if (pos >= slots)
+            break;
+        int j = pos < i ? (int) pos : (int) pos + 1;
+        consumer(j, random.nextInt(valueRange) + 1);
+    }
+}
+
+/**
+ * Получить граф Эрдёша-Реньи в плотной форме
+ *
+ * @param n          кол-во вершин
+ * @param p          вероятность каждого недиагонального ребра
+ * @param valueRange кол-во различных значений рёбер
+ * @return матрица связности
+ */
+Matrix GraphGenerator::erdosRenyi(int n, double p, int valueRange) {
+    checkModel("GraphGenerator::erdosRenyi()", n, valueRange);
+    uint64_t stream = nextStream();
+    Matrix res(n);
+    parallelFor(n, [&res, &stream, &n, &p, &valueRange](long long from, long long to, int) {
+        for (long long i = from; i < to; i++) {
+            int *row = res.getRow((int) i);
+            forEachErdosRenyiEdge(stream, (int) i, n, p, valueRange, [&row](int j, int value) {
+                row[j] = value;
+            });
+        }
+    });
+    return res;
+}
+
+/**
+ * Получить граф Эрдёша-Реньи в разреженной форме
+ *
+ * @param n          кол-во вершин
+ * @param p          вероятность каждого недиагонального ребра
+ * @param valueRange кол-во различных значений рёбер
+ * @return разреженный граф
+ */
+CsrGraph GraphGenerator::erdosRenyiSparse(int n, double p, int valueRange) {
+    checkModel("GraphGenerator::erdosRenyiSparse()", n, valueRange);
+    uint64_t stream = nextStream();
+    // каждый поток собирает рёбра своих строк, затем части склеиваются по порядку строк
+    std::vector<std::vector<CsrGraph::Edge>> parts(threadCount);
+    int partsCnt = parallelFor(n, [&parts, &stream, &n, &p, &valueRange](long long from, long long to, int worker) {
+        std::vector<CsrGraph::Edge> &edges = parts[worker];
+        for (long long i = from; i < to; i++)
+            forEachErdosRenyiEdge(stream, (int) i, n, p, valueRange, [&edges, &i](int j, int value) {
+                edges.push_back({(int) i, j, value});
+            });
+    });
+
+    std::vector<CsrGraph::Edge> edges;
+    for (int k = 0; k < partsCnt; k++) {
+        edges.insert(edges.end(), parts[k].begin(), parts[k].end());
+        std::vector<CsrGraph::Edge>().swap(parts[k]);
+    }
+    return {n, std::move(edges)};
+}
+
+/**
+ * Сгенерировать рёбра графа Барабаши-Альберт
+ *
+ * Вершины выбираются из списка концов всех уже проведённых рёбер, поэтому вероятность
+ * выбора вершины пропорциональна её степени; первые `m` вершин входят в список по одному
+ * разу, чтобы их можно было выбрать до появления рёбер. Модель последовательна по своей
+ * природе и строится в одном потоке
+ *
+ * @param n          кол-во вершин
+ * @param m          кол-во рёбер каждой новой вершины
+ * @param valueRange кол-во различных значений рёбер
+ * @return рёбра
+ */
+std::vector<CsrGraph::Edge> GraphGenerator::barabasiAlbertEdges(int n, int m, int valueRange) {
+    checkModel("GraphGenerator::barabasiAlbert()", n, valueRange);
+    if (m < 1 || m >= std::max(n, 1))
+        throw std::invalid_argument("GraphGenerator::barabasiAlbert() m is not acceptable: " + std::to_string(m));
+    Random random(nextStream());
+
+    std::vector<CsrGraph::Edge> edges;
+    edges.reserve((long long) (n - m) * m);
+    // концы рёбер: каждая вершина встречается столько раз, какова её степень
+    std::vector<int> ends;
+    ends.reserve(2 * (long long) (n - m) * m + m);
+    for (int v = 0; v < m; v++)
+        ends.push_back(v);
+
+    // для каждой вершины - последняя новая вершина, которая её выбрала
+    std::vector<int> chosenBy(n, -1);
+    for (int v = m; v < n; v++) {
+        long long endsCnt = (long long) ends.size();
+        for (int k = 0; k < m;) {
+            int target = ends[(long long) (random.nextDouble() * (double) endsCnt)];
+            // рёбра новой вершины ведут в различные вершины
+            if (chosenBy[target] == v)
+                continue;
+            chosenBy[target] = v;
+            edges.push_back({v, target, random.nextInt(valueRange) + 1});
+            k++;
+        }
+        // степени обновляются после выбора всех рёбер вершины
+        for (int k = 0; k < m; k++) {
+            ends.push_back(edges[edges.size() - m + k].to);
+            ends.push_back(v);
+        }
+    }
+    return edges;
+}
+
+/**
+ * Получить граф Барабаши-Альберт в плотной форме
+ *
+ * @param n          кол-во вершин
+ * @param m          кол-во рёбер каждой новой вершины
+ * @param valueRange кол-во различных значений рёбер
+ * @return матрица связности
+ */
+Matrix GraphGenerator::barabasiAlbert(int n, int m, int valueRange) {
+    return barabasiAlbertSparse(n, m, valueRange).toMatrix();
+}
+
+/**
+ * Получить граф Барабаши-Альберт в разреженной форме
+ *
+ * @param n          кол-во вершин
+ * @param m          кол-во рёбер каждой новой вершины
+ * @param valueRange кол-во различных значений рёбер
+ * @return разреженный граф
+ */
+CsrGraph GraphGenerator::barabasiAlbertSparse(int n, int m, int valueRange) {
+    return {n, barabasiAlbertEdges(n, m, valueRange)};
+}
+
+/**
+ * Сгенерировать рёбра графа R-MAT
+ *
+ * Матрица связности дополняется до стороны - степени двойки; на каждом уровне ребро
+ * попадает в один из четырёх квадрантов. Рёбра генерируются частями по `RMAT_CHUNK`,
+ * части раздаются потокам; затем рёбра сортируются, и из повторных остаётся первое
+ *
+ * @param n          кол-во вершин
+ * @param edgeCount  кол-во генерируемых рёбер
+ * @param a          вероятность левого верхнего квадранта
+ * @param b          вероятность правого верхнего квадранта
+ * @param c          вероятность левого нижнего квадранта
+ * @param valueRange кол-во различных значений рёбер
+ * @return рёбра без повторов и петель
+ */
+std::vector<CsrGraph::Edge> GraphGenerator::rmatEdges(
+        int n, long long edgeCount, double a, double b, double c, int valueRange
+) {
+    checkModel("GraphGenerator::rmat()", n, valueRange);
+    if (edgeCount < 0)
+        throw std::invalid_argument("GraphGenerator::rmat() edge count is not acceptable: " + std::to_string(edgeCount));
+    if (a < 0 || b < 0 || c < 0 || a + b + c > 1)
+        throw std::invalid_argument(
+                "GraphGenerator::rmat() probabilities are not acceptable: " +
+                std::to_string(a) + " " + std::to_string(b) + " " + std::to_string(c)
+        );
+    uint64_t stream = nextStream();
+
+    // кол-во уровней - логарифм стороны дополненной матрицы
+    int levels = 0;
+    while ((1LL << levels) < n)
+        levels++;
+
+    long long chunksCnt = (edgeCount + RMAT_CHUNK - 1) / RMAT_CHUNK;
+    std::vector<std::vector<CsrGraph::Edge>> chunks(chunksCnt);
+    parallelFor(chunksCnt, [&chunks, &stream, &n, &edgeCount, &a, &b, &c, &valueRange, &levels](
+            long long from, long long to, int
+    ) {
+        for (long long chunk = from; chunk < to; chunk++) {
+            Random random(mix(stream, (uint64_t) chunk));
+            long long cnt = std::min(RMAT_CHUNK, edgeCount - chunk * RMAT_CHUNK);
+            for (long long k = 0; k < cnt; k++) {
+                long long row = 0, col = 0;
+                for (int level = 0; level < levels; level++) {
+                    double r = random.nextDouble();
+                    row <<= 1;
+                    col <<= 1;
+                    if (r >= a + b)
+                        row |= 1;
+                    if ((r >= a && r < a + b) || r >= a + b + c)
+                        col |= 1;
+                }
+                int value = random.nextInt(valueRange) + 1;
+                // рёбра за пределами графа и петли отбрасываются
+                if (row < n && col < n && row != col)
+                    chunks[chunk].push_back({(int) row, (int) col, value});
+            }
+        }
+    });
+
+    std::vector<CsrGraph::Edge> edges;
+    for (std::vector<CsrGraph::Edge> &chunk: chunks) {
+        edges.insert(edges.end(), chunk.begin(), chunk.end());
+        std::vector<CsrGraph::Edge>().swap(chunk);
+    }
+    // из повторных рёбер остаётся сгенерированное первым
+    std::stable_sort(edges.begin(), edges.end(), [](const CsrGraph::Edge &x, const CsrGraph::Edge &y) {
+        return x.from != y.from ? x.from < y.from : x.to < y.to;
+    });
+    edges.erase(std::unique(edges.begin(), edges.end(), [](const CsrGraph::Edge &x, const CsrGraph::Edge &y) {
+        return x.from == y.from && x.to == y.to;
+    }), edges.end());
+    return edges;
+}
+
+/**
+ * Получить граф R-MAT в плотной форме
+ *
+ * @param n          кол-во вершин
+ * @param edgeCount  кол-во генерируемых рёбер
+ * @param a          вероятность левого верхнего квадранта
+ * @param b          вероятность правого верхнего квадранта
+ * @param c          вероятность левого нижнего квадранта
+ * @param valueRange кол-во различных значений рёбер
+ * @return матрица связности
+ */
+Matrix GraphGenerator::rmat(int n, long long edgeCount, double a, double b, double c, int valueRange) {
+    return rmatSparse(n, edgeCount, a, b, c, valueRange).toMatrix();
+}
+
+/**
+ * Получить граф R-MAT в разреженной форме
+ *
+ * @param n          кол-во вершин
+ * @param edgeCount  кол-во генерируемых рёбер
+ * @param a          вероятность левого верхнего квадранта
+ * @param b          вероятность правого верхнего квадранта
+ * @param c          вероятность левого нижнего квадранта
+ * @param valueRange кол-во различных значений рёбер
+ * @return разреженный граф
+ */
+CsrGraph GraphGenerator::rmatSparse(int n, long long edgeCount, double a, double b, double c, int valueRange) {
+    return {n, rmatEdges(n, edgeCount, a, b, c, valueRange)};
+}
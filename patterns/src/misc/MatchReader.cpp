@@ -0,0 +1,156 @@
+#include "misc/MatchReader.h"
+
+#include <algorithm>
+#include <cstring>
+#include <sstream>
+
+/**
+ * Конструктор; открывает файл и читает его заголовок
+ *
+ * @param path путь к файлу
+ */
+MatchReader::MatchReader(const std::string &path) :
+        in(path, std::ios::binary), path(path), format(MATCH_TEXT), width(0), count(-1), position(0), left(0),
+        hasFirstLine(false) {
+    if (!in)
+        throw std::invalid_argument("MatchReader() can not open " + path);
+
+    MatchFileHeader header{};
+    in.read(reinterpret_cast<char *>(&header), sizeof(header));
+    if (in.gcount() == (std::streamsize) sizeof(header) &&
+        std::memcmp(header.magic, MATCH_MAGIC, sizeof(MATCH_MAGIC)) == 0) {
+        if (header.version != MatchFileHeader::VERSION)
+            throw std::invalid_argument("MatchReader() version is not supported: " + std::to_string(header.version));
+        if (header.format != MATCH_BINARY && header.format != MATCH_DELTA)
+            throw std::invalid_argument("MatchReader() format is not supported: " + std::to_string(header.format));
+        format = (MatchFormat) header.format;
+        width = (int) header.width;
+        count = header.count == MatchFileHeader::UNKNOWN_COUNT ? -1 : (long long) header.count;
+    } else {
+        // текстовый файл читаем с начала; размер комбинации - кол-во чисел первой непустой строки
+        in.clear();
+        in.seekg(0);
+        while (std::getline(in, firstLine))
+            if (firstLine.find_first_not_of(" \t\r") != std::string::npos) {
+                hasFirstLine = true;
+                parseLine(firstLine, combination);
+                width = (int) combination.size();
+                break;
+            }
+    }
+    combination.resize(width);
+}
+
+/**
+ * Разобрать строку текстового файла
+ *
+ * @param line  строка
+ * @param items элементы строки
+ */
+void MatchReader::parseLine(const std::string &line, std::vector<int> &items) const {
+    items.clear();
+    std::istringstream stream(line);
+    int value;
+    while (stream >> value)
+        items.push_back(value);
+    if (!stream.eof())
+        throw std::invalid_argument("MatchReader can not parse line of " + path + ": " + line);
+}
+
+/**
+ * Прочитать следующий блок двоичного файла
+ * @return флаг, что блок прочитан, а не достигнут конец файла
+ */
+bool MatchReader::readBlock() {
+    uint32_t blockHeader[2];
+    in.read(reinterpret_cast<char *>(blockHeader), sizeof(blockHeader));
+    if (in.gcount() == 0)
+        return false;
+    if (in.gcount() != (std::streamsize) sizeof(blockHeader))
+        throw std::invalid_argument("MatchReader block header is truncated: " + path);
+
+    block.resize(blockHeader[1]);
+    in.read(&block[0], blockHeader[1]);
+    if (in.gcount() != (std::streamsize) blockHeader[1])
+        throw std::invalid_argument("MatchReader block is truncated: " + path);
+    if (format == MATCH_BINARY && (uint64_t) blockHeader[0] * width * sizeof(int) != blockHeader[1])
+        throw std::invalid_argument("MatchReader block size is not acceptable: " + path);
+
+    left = blockHeader[0];
+    position = 0;
+    // разности сжатого формата считаются от нулей в начале каждого блока
+    std::fill(combination.begin(), combination.end(), 0);
+    return true;
+}
+
+/**
+ * Перейти к следующей комбинации
+ * @return флаг, что комбинация прочитана, а не достигнут конец файла
+ */
+bool MatchReader::next() {
+    if (format == MATCH_TEXT) {
+        // первая строка уже разобрана в конструкторе
+        if (hasFirstLine) {
+            hasFirstLine = false;
+            return true;
+        }
+        std::string line;
+        while (std::getline(in, line)) {
+            if (line.find_first_not_of(" \t\r") == std::string::npos)
+                continue;
+            parseLine(line, combination);
+            if ((int) combination.size() != width)
+                throw std::invalid_argument("MatchReader combination size is not acceptable: " + line);
+            return true;
+        }
+        return false;
+    }
+
+    // пустые блоки пропускаем
+    while (left == 0)
+        if (!readBlock())
+            return false;
+    left--;
+
+    if (format == MATCH_BINARY) {
+        std::memcpy(combination.data(), block.data() + position, width * sizeof(int));
+        position += width * sizeof(int);
+        return true;
+    }
+    for (int j = 0; j < width; j++) {
+        // собираем зигзаг-число по 7 бит
+        uint32_t value = 0;
+        for (int shift = 0;; shift += 7) {
+            if (position >= block.size() || shift > 28)
+                throw std::invalid_argument("MatchReader varint is corrupted: " + path);
+            auto byte = (unsigned char) block[position++];
+            value |= (uint32_t) (byte & 0x7F) << shift;
+            if (!(byte & 0x80))
+                break;
+        }
+        // разность снимается с зигзага и прибавляется по модулю 2^32, как и вычислялась при записи
+        uint32_t delta = (value >> 1) ^ (0u - (value & 1));
+        combination[j] = (int) ((uint32_t) combination[j] + delta);
+    }
+    return true;
+}
+
+/**
+ * Дочитать все оставшиеся комбинации
+ *
+ * @param res множество, в которое добавляются комбинации; размер его комбинаций
+ *            должен совпадать с `getWidth()`
+ * @return кол-во прочитанных комбинаций
+ */
+long long MatchReader::readAll(MatchSet &res) {
+    if (res.getWidth() != width)
+        throw std::invalid_argument(
+                "MatchReader::readAll() width is not acceptable: " + std::to_string(res.getWidth())
+        );
+    long long cnt = 0;
+    while (next()) {
+        res.add(combination.data());
+        cnt++;
+    }
+    return cnt;
+}
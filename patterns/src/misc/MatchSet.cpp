@@ -0,0 +1,78 @@
+#include "misc/MatchSet.h"
+
+/**
+ * Конструктор
+ *
+ * @param width размер одной комбинации
+ */
+MatchSet::MatchSet(int width) {
+    if (width < 0)
+        throw std::invalid_argument("MatchSet() width is not acceptable: " + std::to_string(width));
+    this->width = width;
+    this->cnt = 0;
+}
+
+/**
+ * Конструктор перемещения
+ *
+ * @param other исходное множество
+ */
+MatchSet::MatchSet(MatchSet &&other) noexcept:
+        width(other.width), cnt(other.cnt), buffer(std::move(other.buffer)) {
+    other.cnt = 0;
+    other.buffer.clear();
+}
+
+/**
+ * Оператор присваивания перемещением
+ *
+ * @param other исходное множество
+ * @return ссылка на это множество
+ */
+MatchSet &MatchSet::operator=(MatchSet &&other) noexcept {
+    if (this == &other)
+        return *this;
+    width = other.width;
+    cnt = other.cnt;
+    buffer = std::move(other.buffer);
+    other.cnt = 0;
+    other.buffer.clear();
+    return *this;
+}
+
+/**
+ * Добавить все комбинации другого множества того же размера
+ *
+ * @param other другое множество
+ */
+void MatchSet::append(const MatchSet &other) {
+    if (other.width != width)
+        throw std::invalid_argument(
+                "MatchSet::append() width is not acceptable: " + std::to_string(other.width)
+        );
+    buffer.insert(buffer.end(), other.buffer.begin(), other.buffer.end());
+    cnt += other.cnt;
+}
+
+/**
+ * Зарезервировать память под комбинации
+ *
+ * @param count кол-во комбинаций, которые множество должно вместить без новых выделений памяти
+ */
+void MatchSet::reserve(long long count) {
+    if (count < 0)
+        throw std::invalid_argument("MatchSet::reserve() count is not acceptable: " + std::to_string(count));
+    buffer.reserve(count * width);
+}
+
+/**
+ * Получить комбинации в виде списка последовательностей
+ * @return список комбинаций в том же порядке
+ */
+std::vector<CombinatoricsData> MatchSet::toCombinations() const {
+    std::vector<CombinatoricsData> res;
+    res.reserve(cnt);
+    for (IntSpan c: *this)
+        res.emplace_back(c.data(), c.size());
+    return res;
+}
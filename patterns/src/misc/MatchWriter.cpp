@@ -0,0 +1,240 @@
+#include "misc/MatchWriter.h"
+
+#include <cstddef>
+#include <cstring>
+
+/**
+ * Сигнатура двоичного файла комбинаций
+ */
+const char MATCH_MAGIC[8] = {'P', 'T', 'R', 'N', 'M', 'T', 'C', 'H'};
+
+/**
+ * Дописать число в десятичной записи
+ *
+ * @param bytes строка-результат
+ * @param value число
+ */
+static void appendDecimal(std::string &bytes, int value) {
+    char digits[12];
+    int cnt = 0;
+    // отрицательные числа переводим через беззнаковый тип, чтобы не переполнить INT_MIN
+    unsigned int rest = value < 0 ? 0u - (unsigned int) value : (unsigned int) value;
+    do {
+        digits[cnt++] = (char) ('0' + rest % 10);
+        rest /= 10;
+    } while (rest != 0);
+    if (value < 0)
+        bytes.push_back('-');
+    while (cnt > 0)
+        bytes.push_back(digits[--cnt]);
+}
+
+/**
+ * Дописать число в зигзаг-кодировке переменной длины: младшие 7 бит в каждом байте,
+ * старший бит означает, что за байтом следует продолжение
+ *
+ * @param bytes строка-результат
+ * @param value число
+ */
+static void appendVarint(std::string &bytes, int value) {
+    // зигзаг переводит маленькие по модулю числа в маленькие беззнаковые
+    uint32_t rest = ((uint32_t) value << 1) ^ (uint32_t) (value >> 31);
+    while (rest >= 0x80) {
+        bytes.push_back((char) (rest | 0x80));
+        rest >>= 7;
+    }
+    bytes.push_back((char) rest);
+}
+
+/**
+ * Конструктор; открывает файл и запускает поток записи
+ *
+ * @param path           путь к файлу
+ * @param width          размер одной комбинации
+ * @param producerCount  кол-во производителей
+ * @param format         формат файла
+ * @param bufferCapacity кол-во комбинаций в одном буфере
+ * @param queueLength    кол-во заполненных буферов, которые могут ждать записи; вместе с
+ *                       буферами производителей ограничивает память записи
+ */
+MatchWriter::MatchWriter(const std::string &path, int width, int producerCount, MatchFormat format,
+                         int bufferCapacity, int queueLength) :
+        width(width), format(format), bufferCapacity(bufferCapacity), path(path), closing(false), closed(false),
+        failed(false), written(0) {
+    if (width < 0 || producerCount < 1 || bufferCapacity < 1 || queueLength < 1)
+        throw std::invalid_argument(
+                "MatchWriter() width: " + std::to_string(width) + ", producer count: " +
+                std::to_string(producerCount) + ", buffer capacity: " + std::to_string(bufferCapacity) +
+                " or queue length: " + std::to_string(queueLength) + " is not acceptable"
+        );
+
+    out.open(path, format == MATCH_TEXT ? std::ios::out | std::ios::trunc
+                                        : std::ios::out | std::ios::trunc | std::ios::binary);
+    if (!out)
+        throw std::invalid_argument("MatchWriter() can not open " + path);
+    if (format != MATCH_TEXT) {
+        MatchFileHeader header{};
+        std::memcpy(header.magic, MATCH_MAGIC, sizeof(MATCH_MAGIC));
+        header.version = MatchFileHeader::VERSION;
+        header.format = format;
+        header.width = width;
+        header.count = MatchFileHeader::UNKNOWN_COUNT;
+        out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+    }
+
+    // у каждого производителя свой буфер, ещё `queueLength` буферов могут ждать записи
+    for (int i = 0; i < producerCount + queueLength; i++) {
+        storage.emplace_back(new MatchSet(width));
+        storage.back()->reserve(bufferCapacity);
+    }
+    for (int i = 0; i < producerCount; i++)
+        current.push_back(storage[i].get());
+    for (int i = producerCount; i < producerCount + queueLength; i++)
+        freeBuffers.push_back(storage[i].get());
+
+    writer = std::thread([this]() {
+        drain();
+    });
+}
+
+/**
+ * Деструктор; завершает запись, если `close()` не был вызван, и игнорирует её ошибки
+ */
+MatchWriter::~MatchWriter() {
+    try {
+        close();
+    } catch (...) {
+    }
+}
+
+/**
+ * Передать буфер на запись
+ *
+ * @param buffer заполненный буфер
+ * @param wait   флаг, нужно ли дождаться и вернуть свободный буфер
+ * @return свободный буфер или `nullptr`, если `wait == false`
+ */
+MatchSet *MatchWriter::submit(MatchSet *buffer, bool wait) {
+    std::unique_lock<std::mutex> lock(mutex);
+    fullBuffers.push_back(buffer);
+    hasFull.notify_one();
+    if (!wait)
+        return nullptr;
+    // если запись не успевает, производитель ждёт здесь
+    hasFree.wait(lock, [this]() {
+        return !freeBuffers.empty();
+    });
+    MatchSet *res = freeBuffers.back();
+    freeBuffers.pop_back();
+    return res;
+}
+
+/**
+ * Основной цикл потока записи
+ */
+void MatchWriter::drain() {
+    std::string bytes;
+    for (;;) {
+        MatchSet *buffer;
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            hasFull.wait(lock, [this]() {
+                return !fullBuffers.empty() || closing;
+            });
+            if (fullBuffers.empty())
+                return;
+            buffer = fullBuffers.front();
+            fullBuffers.pop_front();
+        }
+
+        // после ошибки буферы только освобождаются, чтобы производители не ждали вечно
+        if (!failed.load(std::memory_order_relaxed))
+            try {
+                writeBlock(*buffer, bytes);
+            } catch (...) {
+                error = std::current_exception();
+                failed.store(true, std::memory_order_relaxed);
+            }
+        buffer->clear();
+
+        std::lock_guard<std::mutex> lock(mutex);
+        freeBuffers.push_back(buffer);
+        hasFree.notify_one();
+    }
+}
+
+/**
+ * Закодировать и записать буфер
+ *
+ * @param buffer     буфер
+ * @param bytes      байты закодированного блока; память переиспользуется между вызовами
+ */
+void MatchWriter::writeBlock(const MatchSet &buffer, std::string &bytes) {
+    bytes.clear();
+    const int *data = buffer.getData();
+    long long cnt = buffer.getSize();
+    if (format == MATCH_TEXT) {
+        for (long long i = 0; i < cnt; i++) {
+            for (int j = 0; j < width; j++) {
+                if (j > 0)
+                    bytes.push_back(' ');
+                appendDecimal(bytes, data[i * width + j]);
+            }
+            bytes.push_back('\n');
+        }
+    } else {
+        // место под заголовок блока
+        bytes.resize(2 * sizeof(uint32_t));
+        if (format == MATCH_BINARY)
+            bytes.append(reinterpret_cast<const char *>(data), cnt * width * sizeof(int));
+        else
+            for (long long i = 0; i < cnt; i++)
+                for (int j = 0; j < width; j++)
+                    // разность считается по модулю 2^32, чтобы не было переполнения знаковых чисел
+                    appendVarint(bytes, (int) ((uint32_t) data[i * width + j] -
+                                               (uint32_t) (i > 0 ? data[(i - 1) * width + j] : 0)));
+        uint32_t blockHeader[2] = {(uint32_t) cnt, (uint32_t) (bytes.size() - sizeof(blockHeader))};
+        std::memcpy(&bytes[0], blockHeader, sizeof(blockHeader));
+    }
+
+    if (!out.write(bytes.data(), (std::streamsize) bytes.size()))
+        throw std::invalid_argument("MatchWriter can not write " + path);
+    written += cnt;
+}
+
+/**
+ * Записать остатки буферов, дождаться потока записи и закрыть файл
+ *
+ * Вызывается, когда все производители закончили работу. Ошибка записи
+ * выбрасывается отсюда
+ *
+ * @return кол-во записанных комбинаций
+ */
+long long MatchWriter::close() {
+    if (!closed) {
+        closed = true;
+        // непустые буферы производителей уходят на запись без ожидания свободных
+        for (MatchSet *buffer: current)
+            if (!buffer->isEmpty())
+                submit(buffer, false);
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            closing = true;
+            hasFull.notify_one();
+        }
+        writer.join();
+
+        // теперь, когда все блоки записаны, известно итоговое кол-во комбинаций
+        if (!error && format != MATCH_TEXT) {
+            auto count = (uint64_t) written;
+            out.seekp(offsetof(MatchFileHeader, count));
+            out.write(reinterpret_cast<const char *>(&count), sizeof(count));
+        }
+        out.close();
+        if (!error && !out)
+            error = std::make_exception_ptr(std::invalid_argument("MatchWriter can not write " + path));
+    }
+    if (error)
+        std::rethrow_exception(error);
+    return written;
+}
@@ -0,0 +1,143 @@
+#include "misc/Matrix.h"
+
+#include <cstdint>
+#include <utility>
+
+/**
+ * Выделить память под матрицу и заполнить её нулями
+ *
+ * @param sz      размер стороны матрицы
+ * @param padding флаг, нужно ли дополнять строки до размера, кратного кэш-линии
+ */
+void Matrix::allocate(int sz, bool padding) {
+    if (sz < 0)
+        throw std::invalid_argument("Matrix() size is not acceptable: " + std::to_string(sz));
+
+    // кол-во элементов в одной кэш-линии
+    int lineSize = ALIGNMENT / (int) sizeof(int);
+
+    this->sz = sz;
+    // дополняем строку до размера, кратного кэш-линии
+    this->stride = padding ? (sz + lineSize - 1) / lineSize * lineSize : sz;
+
+    // выделяем память с запасом на выравнивание
+    long long cnt = (long long) this->stride * sz + lineSize;
+    this->buffer = new int[cnt]();
+
+    // сдвигаем начало данных до ближайшей границы кэш-линии
+    auto address = reinterpret_cast<std::uintptr_t>(this->buffer);
+    std::uintptr_t shift = (ALIGNMENT - address % ALIGNMENT) % ALIGNMENT;
+    this->data = this->buffer + shift / sizeof(int);
+}
+
+/**
+ * Конструктор пустой матрицы
+ */
+Matrix::Matrix() : buffer(nullptr), data(nullptr), sz(0), stride(0) {
+}
+
+/**
+ * Конструктор нулевой матрицы
+ *
+ * @param sz      размер стороны матрицы
+ * @param padding флаг, нужно ли дополнять строки до размера, кратного кэш-линии
+ */
+Matrix::Matrix(int sz, bool padding) {
+    allocate(sz, padding);
+}
+
+/**
+ * Конструктор копии матрицы в формате `int **`
+ *
+ * @param source  исходная матрица
+ * @param sz      размер стороны матрицы
+ * @param padding флаг, нужно ли дополнять строки до размера, кратного кэш-линии
+ */
+Matrix::Matrix(int **source, int sz, bool padding) {
+    allocate(sz, padding);
+    for (int i = 0; i < sz; i++) {
+        int *row = getRow(i);
+        for (int j = 0; j < sz; j++)
+            row[j] = source[i][j];
+    }
+}
+
+/**
+ * Конструктор представления чужого буфера; матрица не владеет памятью
+ * и не освобождает её
+ *
+ * @param data   начало первой строки
+ * @param sz     размер стороны матрицы
+ * @param stride расстояние между началами соседних строк в элементах
+ */
+Matrix::Matrix(int *data, int sz, int stride) : buffer(nullptr), data(data), sz(sz), stride(stride) {
+    if (stride < sz)
+        throw std::invalid_argument(
+                "Matrix() stride: " + std::to_string(stride) + " is less than size " + std::to_string(sz)
+        );
+}
+
+/**
+ * Конструктор копирования; копия всегда владеет своей памятью
+ *
+ * @param other исходная матрица
+ */
+Matrix::Matrix(const Matrix &other) {
+    allocate(other.sz, other.stride != other.sz);
+    for (int i = 0; i < sz; i++) {
+        int *row = getRow(i);
+        const int *otherRow = other.getRow(i);
+        for (int j = 0; j < sz; j++)
+            row[j] = otherRow[j];
+    }
+}
+
+/**
+ * Конструктор перемещения
+ *
+ * @param other исходная матрица
+ */
+Matrix::Matrix(Matrix &&other) noexcept:
+        buffer(other.buffer), data(other.data), sz(other.sz), stride(other.stride) {
+    other.buffer = nullptr;
+    other.data = nullptr;
+    other.sz = 0;
+    other.stride = 0;
+}
+
+/**
+ * Оператор присваивания
+ *
+ * @param other исходная матрица
+ * @return ссылка на эту матрицу
+ */
+Matrix &Matrix::operator=(Matrix other) noexcept {
+    std::swap(buffer, other.buffer);
+    std::swap(data, other.data);
+    std::swap(sz, other.sz);
+    std::swap(stride, other.stride);
+    return *this;
+}
+
+/**
+ * Деструктор
+ */
+Matrix::~Matrix() {
+    delete[] buffer;
+}
+
+/**
+ * Получить копию матрицы в формате `int **`
+ *
+ * @return копия матрицы
+ */
+int **Matrix::toArray() const {
+    int **res = new int *[sz];
+    for (int i = 0; i < sz; i++) {
+        res[i] = new int[sz];
+        const int *row = getRow(i);
+        for (int j = 0; j < sz; j++)
+            res[i][j] = row[j];
+    }
+    return res;
+}
@@ -1,4 +1,8 @@
 #include "misc/PatternBuilder.h"
+#include <algorithm>
+#include <atomic>
+#include <iterator>
+#include <thread>
 
 /**
  * Конструктор
@@ -6,16 +10,104 @@
  * @param data матрица-результат
  * @param sz   размер стороны матрицы
  */
-PatternBuilder::PatternBuilder(int **data, int sz) {
-    // заполняем массив флагов значениями `false`
-    this->isModified = new bool *[sz];
-    for (int i = 0; i < sz; i++) {
-        this->isModified[i] = new bool[sz];
-        for (int j = 0; j < sz; j++)
-            this->isModified[i][j] = false;
-    }
-
+PatternBuilder::PatternBuilder(int **data, int sz) : occupied(sz) {
     this->data = data;
+    this->sz = sz;
+}
+
+/**
+ * Конструктор; паттерны добавляются прямо в переданную матрицу
+ *
+ * @param data матрица-результат
+ */
+PatternBuilder::PatternBuilder(Matrix &data) : occupied(data.getSize()), rows(data.getSize()) {
+    for (int i = 0; i < data.getSize(); i++)
+        rows[i] = data.getRow(i);
+    this->data = rows.data();
+    this->sz = data.getSize();
+}
+
+/**
+ * Конструктор копирования; копия строится по той же матрице-результату
+ *
+ * @param other построитель
+ */
+PatternBuilder::PatternBuilder(const PatternBuilder &other) :
+        occupied(other.occupied), rows(other.rows), sz(other.sz) {
+    // собственные указатели на строки у копии свои
+    data = rows.empty() ? other.data : rows.data();
+}
+
+/**
+ * Оператор присваивания
+ *
+ * @param other построитель
+ * @return ссылка на этот построитель
+ */
+PatternBuilder &PatternBuilder::operator=(PatternBuilder other) noexcept {
+    // обмен векторов не перемещает их элементы, поэтому `data` остаётся действительным
+    occupied.swap(other.occupied);
+    rows.swap(other.rows);
+    std::swap(data, other.data);
+    std::swap(sz, other.sz);
+    return *this;
+}
+
+/**
+ * Проверить, занята ли ячейка каким-то паттерном
+ *
+ * @param i номер строки
+ * @param j номер столбца
+ * @return флаг, занята ли ячейка
+ */
+bool PatternBuilder::isOccupied(int i, int j) const {
+    return std::binary_search(occupied[i].begin(), occupied[i].end(), j);
+}
+
+/**
+ * Добавить паттерн, если он не противоречит уже добавленным
+ *
+ * Читает и меняет только строки с номерами из комбинации, поэтому вызовы
+ * с непересекающимися комбинациями можно выполнять одновременно
+ *
+ * @param pattern     строки паттерна
+ * @param size        размер стороны паттерна
+ * @param combination вершины результирующей матрицы, в которые нужно добавить паттерн;
+ *                    `i`-ая вершина паттерна переходит в `combination[i]`
+ * @return флаг, получилось ли добавить
+ */
+bool PatternBuilder::tryPut(const int *const *pattern, int size, const int *combination) {
+    // перебираем пары элементов комбинаций
+    for (int i = 0; i < size; i++)
+        for (int j = 0; j < size; j++) {
+            // получаем две координаты по соответствующим элементам из перебираемой пары
+            int posX = combination[i];
+            int posY = combination[j];
+            // если элемент в матрице уже занят другим паттерном и при
+            // этом значение в матрице не совпадает с новым
+            if (pattern[i][j] != data[posX][posY] && isOccupied(posX, posY))
+                // возвращаем флаг, что не удалось добавить паттерн
+                return false;
+        }
+
+    // столбцы комбинации по возрастанию, чтобы сливать их со списками занятых столбцов
+    std::vector<int> columns(combination, combination + size);
+    std::sort(columns.begin(), columns.end());
+
+    std::vector<int> merged;
+    for (int i = 0; i < size; i++) {
+        int posX = combination[i];
+        // заполняем соответствующие элементы строки матрицы
+        for (int j = 0; j < size; j++)
+            data[posX][combination[j]] = pattern[i][j];
+        // отмечаем ячейки строки занятыми; уже занятые столбцы не повторяются
+        std::vector<int> &row = occupied[posX];
+        merged.clear();
+        std::set_union(row.begin(), row.end(), columns.begin(), columns.end(), std::back_inserter(merged));
+        row.assign(merged.begin(), merged.end());
+    }
+    // возвращаем флаг, что удалось добавить паттерн
+    return true;
 }
 
 /**
@@ -33,33 +125,75 @@ bool PatternBuilder::putPattern(int **pattern, int size, CombinatoricsData combi
                 " not equal to combination size" +
                 std::to_string(combinatoricsData.getSize())
         );
+    return tryPut(pattern, size, combinatoricsData.getData());
+}
 
-    // перебираем пары элементов комбинаций
-    for (int i = 0; i < combinatoricsData.getSize(); i++)
-        for (int j = 0; j < combinatoricsData.getSize(); j++) {
-            // получаем две координаты по соответствующим элементам из перебираемой пары
-            int posX = combinatoricsData.getData()[i];
-            int posY = combinatoricsData.getData()[j];
-            // если элемент в матрице уже занят другим паттерном и при
-            // этом значение в матрице не совпадает с новым
-            if (isModified[posX][posY] && pattern[i][j] != data[posX][posY])
-                // возвращаем флаг, что не удалось добавить паттерн
-                return false;
-        }
+/**
+ * Добавить много копий паттерна в случайные комбинации вершин
+ *
+ * Добавление идёт раундами: в каждом раунде случайная перестановка вершин режется
+ * на непересекающиеся комбинации размера паттерна, которые добавляются параллельно;
+ * комбинации, противоречащие паттернам прошлых раундов, отбрасываются. Т.к. внутри
+ * раунда комбинации не пересекаются, результат зависит только от генератора, но не
+ * от кол-ва потоков
+ *
+ * @param pattern     паттерн
+ * @param count       кол-во копий паттерна
+ * @param generator   генератор случайных перестановок
+ * @param threadCount кол-во потоков
+ * @param maxRounds   максимальное кол-во раундов; ограничивает работу, если плотно
+ *                    занятая матрица не принимает новых копий
+ * @return добавленные комбинации: `i`-ая вершина паттерна переходит в `i`-ый элемент
+ *         комбинации; комбинаций может оказаться меньше `count`, если не хватило раундов
+ */
+MatchSet PatternBuilder::plantPatterns(const Matrix &pattern, int count, GraphGenerator &generator,
+                                       int threadCount, int maxRounds) {
+    int size = pattern.getSize();
+    if (size < 1 || size > sz)
+        throw std::invalid_argument(
+                "PatternBuilder::plantPatterns() pattern size is not acceptable: " + std::to_string(size)
+        );
+    if (count < 0 || threadCount < 1)
+        throw std::invalid_argument(
+                "PatternBuilder::plantPatterns() count: " + std::to_string(count) +
+                " or thread count: " + std::to_string(threadCount) + " is not acceptable"
+        );
 
-    // перебираем пары элементов комбинаций
-    for (int i = 0; i < combinatoricsData.getSize(); i++)
-        for (int j = 0; j < combinatoricsData.getSize(); j++) {
-            // получаем две координаты по соответствующим элементам из перебираемой пары
-            int posX = combinatoricsData.getData()[i];
-            int posY = combinatoricsData.getData()[j];
-            // заполняем соответствующий элемент матрицы
-            data[posX][posY] = pattern[i][j];
-            // выставляем флаг, что э
-            isModified[posX][posY] = true;
+    std::vector<const int *> rows(size);
+    for (int i = 0; i < size; i++)
+        rows[i] = pattern.getRow(i);
+
+    MatchSet res(size);
+    res.reserve(count);
+    for (int round = 0; round < maxRounds && res.getSize() < count; round++) {
+        // непересекающиеся комбинации раунда лежат в перестановке подряд
+        std::vector<int> order = generator.permutation(sz);
+        int blocksCnt = (int) std::min((long long) (sz / size), count - res.getSize());
+        std::vector<char> accepted(blocksCnt, 0);
+        std::atomic<int> nextBlock(0);
+
+        auto body = [this, &rows, &size, &order, &blocksCnt, &accepted, &nextBlock]() {
+            for (int block = nextBlock++; block < blocksCnt; block = nextBlock++)
+                accepted[block] = tryPut(rows.data(), size, order.data() + (long long) block * size);
+        };
+        // в один поток работаем без создания потоков
+        int workers = std::min(threadCount, blocksCnt);
+        if (workers <= 1)
+            body();
+        else {
+            std::vector<std::thread> threads;
+            for (int worker = 0; worker < workers; worker++)
+                threads.emplace_back(body);
+            for (std::thread &thread: threads)
+                thread.join();
         }
-    // возвращаем флаг, что удалось добавить паттерн
-    return true;
+
+        // добавленные комбинации сохраняем в порядке номеров
+        for (int block = 0; block < blocksCnt; block++)
+            if (accepted[block])
+                res.add(order.data() + (long long) block * size);
+    }
+    return res;
 }
 
 /**
@@ -0,0 +1,41 @@
+#include "misc/SearchStatistics.h"
+
+/**
+ * Получить кол-во узлов дерева перебора на всех глубинах
+ * @return кол-во узлов
+ */
+long long SearchStatistics::getTotalNodes() const {
+    long long res = 0;
+    for (long long cnt: nodes)
+        res += cnt;
+    return res;
+}
+
+/**
+ * Добавить к статистике счётчики другой статистики
+ *
+ * @param other другая статистика
+ */
+void SearchStatistics::merge(const SearchStatistics &other) {
+    if (other.nodes.size() > nodes.size())
+        nodes.resize(other.nodes.size(), 0);
+    for (int depth = 0; depth < (int) other.nodes.size(); depth++)
+        nodes[depth] += other.nodes[depth];
+    for (int reason = 0; reason < REASONS_COUNT; reason++)
+        prunes[reason] += other.prunes[reason];
+    matches += other.matches;
+    buildTime += other.buildTime;
+    searchTime += other.searchTime;
+}
+
+/**
+ * Обнулить все счётчики
+ */
+void SearchStatistics::clear() {
+    nodes.clear();
+    for (long long &cnt: prunes)
+        cnt = 0;
+    matches = 0;
+    buildTime = 0;
+    searchTime = 0;
+}
@@ -0,0 +1,460 @@
+#include "misc/binaryIO.h"
+
+#include <algorithm>
+#include <climits>
+#include <cstring>
+#include <fstream>
+#include <vector>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+static_assert(sizeof(BinaryGraphHeader) == 128, "BinaryGraphHeader must take 128 bytes");
+static_assert(sizeof(long long) == sizeof(int64_t) && sizeof(int) == sizeof(int32_t), "unexpected integer sizes");
+
+/**
+ * Сигнатура двоичного файла графа
+ */
+static const char MAGIC[8] = {'P', 'T', 'R', 'N', 'G', 'R', 'P', 'H'};
+/**
+ * Метка порядка байт
+ */
+static const uint32_t BYTE_ORDER_MARK = 0x01020304;
+/**
+ * Кол-во секций разреженного графа
+ */
+static const int CSR_SECTIONS = 7;
+
+/**
+ * Округлить смещение вверх до границы секции
+ *
+ * @param offset смещение в байтах
+ * @return выровненное смещение
+ */
+static uint64_t alignUp(uint64_t offset) {
+    return (offset + BinaryGraphHeader::ALIGNMENT - 1) / BinaryGraphHeader::ALIGNMENT * BinaryGraphHeader::ALIGNMENT;
+}
+
+/**
+ * Получить расстояние между началами строк плотной матрицы в файле:
+ * строки дополняются до размера, кратного выравниванию, как у `Matrix`
+ *
+ * @param n размер стороны матрицы
+ * @return расстояние в элементах
+ */
+static int64_t denseStride(int64_t n) {
+    int64_t lineSize = BinaryGraphHeader::ALIGNMENT / sizeof(int32_t);
+    return (n + lineSize - 1) / lineSize * lineSize;
+}
+
+/**
+ * Разложить секции разреженного графа
+ *
+ * @param n       кол-во вершин
+ * @param m       кол-во рёбер
+ * @param offset  начало первой секции
+ * @param offsets массив начал секций: петли, смещения, концы и значения исходящих рёбер,
+ *                смещения, начала и значения входящих рёбер
+ * @return конец последней секции
+ */
+static uint64_t layoutCsr(uint64_t n, uint64_t m, uint64_t offset, uint64_t *offsets) {
+    const uint64_t sizes[CSR_SECTIONS] = {
+            n * sizeof(int32_t),
+            (n + 1) * sizeof(int64_t), m * sizeof(int32_t), m * sizeof(int32_t),
+            (n + 1) * sizeof(int64_t), m * sizeof(int32_t), m * sizeof(int32_t)
+    };
+    for (int section = 0; section < CSR_SECTIONS; section++) {
+        offsets[section] = alignUp(offset);
+        offset = offsets[section] + sizes[section];
+    }
+    return offset;
+}
+
+/**
+ * Разложить секцию степеней
+ *
+ * @param n         кол-во вершин
+ * @param offset    начало секции
+ * @param inOffset  начало входящих степеней
+ * @return конец секции
+ */
+static uint64_t layoutDegrees(uint64_t n, uint64_t offset, uint64_t &inOffset) {
+    inOffset = alignUp(offset + n * sizeof(int32_t));
+    return inOffset + n * sizeof(int32_t);
+}
+
+/**
+ * Конструктор; отображает файл в память и проверяет заголовок
+ *
+ * @param path путь к файлу
+ */
+MappedGraph::MappedGraph(const std::string &path) : address(nullptr), length(0), outDegrees(nullptr),
+                                                    inDegrees(nullptr) {
+    int fd = open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw std::invalid_argument("MappedGraph() can not open " + path);
+    struct stat st{};
+    if (fstat(fd, &st) != 0 || st.st_size < (off_t) sizeof(BinaryGraphHeader)) {
+        close(fd);
+        throw std::invalid_argument("MappedGraph() file is too short: " + path);
+    }
+    length = (std::size_t) st.st_size;
+    // частное отображение: страницы читаются по требованию, а запись копирует только изменённые страницы
+    address = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    // отображение не зависит от дескриптора
+    close(fd);
+    if (address == MAP_FAILED) {
+        address = nullptr;
+        throw std::invalid_argument("MappedGraph() can not map " + path);
+    }
+
+    try {
+        std::memcpy(&header, address, sizeof(BinaryGraphHeader));
+        if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0)
+            throw std::invalid_argument("MappedGraph() not a binary graph file: " + path);
+        if (header.byteOrder != BYTE_ORDER_MARK)
+            throw std::invalid_argument("MappedGraph() byte order is not acceptable: " + path);
+        if (header.version != BinaryGraphHeader::VERSION)
+            throw std::invalid_argument("MappedGraph() version is not supported: " + std::to_string(header.version));
+        if (header.elementType != BinaryGraphHeader::INT32)
+            throw std::invalid_argument(
+                    "MappedGraph() element type is not supported: " + std::to_string(header.elementType)
+            );
+        if (header.fileSize != length)
+            throw std::invalid_argument("MappedGraph() file is truncated: " + path);
+        if (header.vertexCount < 0 || header.vertexCount > INT_MAX || header.edgeCount < 0)
+            throw std::invalid_argument("MappedGraph() sizes are not acceptable: " + path);
+        if (header.payloadOffset < sizeof(BinaryGraphHeader) || header.payloadOffset % BinaryGraphHeader::ALIGNMENT)
+            throw std::invalid_argument("MappedGraph() payload offset is not acceptable: " + path);
+
+        auto n = (uint64_t) header.vertexCount;
+        auto m = (uint64_t) header.edgeCount;
+        uint64_t end;
+        if (header.layout == BinaryGraphHeader::DENSE) {
+            if (header.stride < header.vertexCount || header.stride > INT_MAX)
+                throw std::invalid_argument("MappedGraph() stride is not acceptable: " + path);
+            end = header.payloadOffset + n * (uint64_t) header.stride * sizeof(int32_t);
+            if (end > length)
+                throw std::invalid_argument("MappedGraph() file is truncated: " + path);
+            matrix = Matrix(reinterpret_cast<int *>(at(header.payloadOffset)), (int) n, (int) header.stride);
+        } else if (header.layout == BinaryGraphHeader::CSR) {
+            uint64_t offsets[CSR_SECTIONS];
+            end = layoutCsr(n, m, header.payloadOffset, offsets);
+            if (end > length)
+                throw std::invalid_argument("MappedGraph() file is truncated: " + path);
+            auto outOffsets = reinterpret_cast<const long long *>(at(offsets[1]));
+            auto inOffsets = reinterpret_cast<const long long *>(at(offsets[4]));
+            // полная проверка списков стоила бы прохода по всем рёбрам, поэтому сверяем только их концы
+            if (outOffsets[n] != (long long) m || inOffsets[n] != (long long) m)
+                throw std::invalid_argument("MappedGraph() edge lists are corrupted: " + path);
+            graph = CsrGraph(
+                    (int) n, (long long) m, reinterpret_cast<const int *>(at(offsets[0])),
+                    outOffsets, reinterpret_cast<const int *>(at(offsets[2])),
+                    reinterpret_cast<const int *>(at(offsets[3])),
+                    inOffsets, reinterpret_cast<const int *>(at(offsets[5])),
+                    reinterpret_cast<const int *>(at(offsets[6]))
+            );
+        } else
+            throw std::invalid_argument("MappedGraph() layout is not supported: " + std::to_string(header.layout));
+
+        if (header.flags & BinaryGraphHeader::DEGREES) {
+            uint64_t inOffset;
+            if (header.degreesOffset < end || header.degreesOffset % BinaryGraphHeader::ALIGNMENT ||
+                layoutDegrees(n, header.degreesOffset, inOffset) > length)
+                throw std::invalid_argument("MappedGraph() degrees offset is not acceptable: " + path);
+            outDegrees = reinterpret_cast<const int *>(at(header.degreesOffset));
+            inDegrees = reinterpret_cast<const int *>(at(inOffset));
+        }
+    } catch (...) {
+        munmap(address, length);
+        throw;
+    }
+}
+
+/**
+ * Деструктор; снимает отображение
+ */
+MappedGraph::~MappedGraph() {
+    munmap(address, length);
+}
+
+/**
+ * Получить плотную матрицу
+ * @return представление отображённой матрицы
+ */
+Matrix &MappedGraph::getMatrix() {
+    if (!isDense())
+        throw std::invalid_argument("MappedGraph::getMatrix() graph is not dense");
+    return matrix;
+}
+
+/**
+ * Получить плотную матрицу
+ * @return представление отображённой матрицы
+ */
+const Matrix &MappedGraph::getMatrix() const {
+    if (!isDense())
+        throw std::invalid_argument("MappedGraph::getMatrix() graph is not dense");
+    return matrix;
+}
+
+/**
+ * Получить разреженный граф
+ * @return представление отображённого графа
+ */
+const CsrGraph &MappedGraph::getGraph() const {
+    if (isDense())
+        throw std::invalid_argument("MappedGraph::getGraph() graph is not sparse");
+    return graph;
+}
+
+/**
+ * Получить кол-во ненулевых исходящих рёбер вершин без учёта петель
+ * @return `getSize()` степеней
+ */
+const int *MappedGraph::getOutDegrees() const {
+    if (!hasDegrees())
+        throw std::invalid_argument("MappedGraph::getOutDegrees() file has no degrees");
+    return outDegrees;
+}
+
+/**
+ * Получить кол-во ненулевых входящих рёбер вершин без учёта петель
+ * @return `getSize()` степеней
+ */
+const int *MappedGraph::getInDegrees() const {
+    if (!hasDegrees())
+        throw std::invalid_argument("MappedGraph::getInDegrees() file has no degrees");
+    return inDegrees;
+}
+
+/**
+ * Проверить, начинается ли файл с сигнатуры двоичного формата графа
+ *
+ * @param path путь к файлу
+ * @return флаг, двоичный ли файл; `false`, если файл не удалось открыть
+ */
+bool isBinaryGraphFile(const std::string &path) {
+    std::ifstream in(path, std::ios::binary);
+    char magic[sizeof(MAGIC)];
+    return in.read(magic, sizeof(magic)) && std::memcmp(magic, MAGIC, sizeof(MAGIC)) == 0;
+}
+
+/**
+ * Последовательная запись секций двоичного файла
+ */
+class SectionWriter {
+    /**
+     * Поток вывода
+     */
+    std::ofstream out;
+    /**
+     * Кол-во записанных байт
+     */
+    uint64_t position;
+    /**
+     * Путь к файлу для сообщений об ошибках
+     */
+    std::string path;
+
+public:
+    /**
+     * Конструктор
+     *
+     * @param path путь к файлу
+     */
+    explicit SectionWriter(const std::string &path) : out(path, std::ios::binary | std::ios::trunc), position(0),
+                                                      path(path) {
+        if (!out)
+            throw std::invalid_argument("writeBinary() can not open " + path);
+    }
+
+    /**
+     * Дополнить файл нулями до заданного смещения
+     *
+     * @param offset смещение начала следующей секции
+     */
+    void seek(uint64_t offset) {
+        static const char zeros[BinaryGraphHeader::ALIGNMENT] = {};
+        while (position < offset) {
+            uint64_t cnt = std::min(offset - position, (uint64_t) sizeof(zeros));
+            write(zeros, cnt);
+        }
+    }
+
+    /**
+     * Записать байты
+     *
+     * @param data начало данных
+     * @param size кол-во байт
+     */
+    void write(const void *data, uint64_t size) {
+        if (!out.write(static_cast<const char *>(data), (std::streamsize) size))
+            throw std::invalid_argument("writeBinary() can not write " + path);
+        position += size;
+    }
+
+    /**
+     * Завершить запись
+     */
+    void close() {
+        out.close();
+        if (!out)
+            throw std::invalid_argument("writeBinary() can not write " + path);
+    }
+};
+
+/**
+ * Заполнить общие поля заголовка
+ *
+ * @param layout раскладка данных
+ * @param n      кол-во вершин
+ * @param m      кол-во рёбер
+ * @return заголовок
+ */
+static BinaryGraphHeader makeHeader(BinaryGraphHeader::Layout layout, int n, long long m) {
+    BinaryGraphHeader header{};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = BinaryGraphHeader::VERSION;
+    header.byteOrder = BYTE_ORDER_MARK;
+    header.layout = layout;
+    header.elementType = BinaryGraphHeader::INT32;
+    header.vertexCount = n;
+    header.edgeCount = m;
+    header.payloadOffset = alignUp(sizeof(BinaryGraphHeader));
+    return header;
+}
+
+/**
+ * Записать секцию степеней
+ *
+ * @param writer     запись секций
+ * @param header     заголовок файла
+ * @param outDegrees исходящие степени
+ * @param inDegrees  входящие степени
+ */
+static void writeDegrees(SectionWriter &writer, const BinaryGraphHeader &header,
+                         const std::vector<int> &outDegrees, const std::vector<int> &inDegrees) {
+    uint64_t inOffset;
+    layoutDegrees(header.vertexCount, header.degreesOffset, inOffset);
+    writer.seek(header.degreesOffset);
+    writer.write(outDegrees.data(), outDegrees.size() * sizeof(int32_t));
+    writer.seek(inOffset);
+    writer.write(inDegrees.data(), inDegrees.size() * sizeof(int32_t));
+}
+
+/**
+ * Записать плотную матрицу в двоичном формате
+ *
+ * @param path    путь к файлу
+ * @param matrix  матрица
+ * @param degrees флаг, нужно ли записать степени вершин
+ */
+void writeBinaryMatrix(const std::string &path, const Matrix &matrix, bool degrees) {
+    int n = matrix.getSize();
+
+    // степени, кол-во рёбер и симметричность считаются за один проход
+    std::vector<int> outDegrees(n, 0), inDegrees(n, 0);
+    long long m = 0;
+    bool symmetric = true;
+    for (int i = 0; i < n; i++) {
+        const int *row = matrix.getRow(i);
+        for (int j = 0; j < n; j++) {
+            if (row[j] != matrix.get(j, i))
+                symmetric = false;
+            if (i == j || row[j] == 0)
+                continue;
+            outDegrees[i]++;
+            inDegrees[j]++;
+            m++;
+        }
+    }
+
+    BinaryGraphHeader header = makeHeader(BinaryGraphHeader::DENSE, n, m);
+    header.stride = denseStride(n);
+    header.flags = (symmetric ? (uint32_t) BinaryGraphHeader::SYMMETRIC : 0u) |
+                   (degrees ? (uint32_t) BinaryGraphHeader::DEGREES : 0u);
+    uint64_t end = header.payloadOffset + (uint64_t) n * header.stride * sizeof(int32_t);
+    if (degrees) {
+        header.degreesOffset = alignUp(end);
+        uint64_t inOffset;
+        end = layoutDegrees(n, header.degreesOffset, inOffset);
+    }
+    header.fileSize = end;
+
+    SectionWriter writer(path);
+    writer.write(&header, sizeof(header));
+    writer.seek(header.payloadOffset);
+    // хвосты строк заполняются нулями
+    std::vector<int32_t> row(header.stride, 0);
+    for (int i = 0; i < n; i++) {
+        std::memcpy(row.data(), matrix.getRow(i), n * sizeof(int32_t));
+        writer.write(row.data(), row.size() * sizeof(int32_t));
+    }
+    if (degrees)
+        writeDegrees(writer, header, outDegrees, inDegrees);
+    writer.seek(header.fileSize);
+    writer.close();
+}
+
+/**
+ * Записать разреженный граф в двоичном формате
+ *
+ * @param path    путь к файлу
+ * @param graph   граф
+ * @param degrees флаг, нужно ли записать степени вершин
+ */
+void writeBinaryGraph(const std::string &path, const CsrGraph &graph, bool degrees) {
+    int n = graph.getSize();
+    long long m = graph.getEdgeCount();
+
+    // граф симметричен, если списки исходящих и входящих рёбер каждой вершины совпадают
+    std::vector<int> outDegrees(n), inDegrees(n), loops(n);
+    bool symmetric = true;
+    for (int i = 0; i < n; i++) {
+        outDegrees[i] = graph.getOutDegree(i);
+        inDegrees[i] = graph.getInDegree(i);
+        loops[i] = graph.getLoop(i);
+        symmetric = symmetric && outDegrees[i] == inDegrees[i] &&
+                    std::equal(graph.getOutTargets(i), graph.getOutTargets(i) + outDegrees[i],
+                               graph.getInSources(i)) &&
+                    std::equal(graph.getOutValues(i), graph.getOutValues(i) + outDegrees[i],
+                               graph.getInValues(i));
+    }
+
+    BinaryGraphHeader header = makeHeader(BinaryGraphHeader::CSR, n, m);
+    header.flags = (symmetric ? (uint32_t) BinaryGraphHeader::SYMMETRIC : 0u) |
+                   (degrees ? (uint32_t) BinaryGraphHeader::DEGREES : 0u);
+    uint64_t offsets[CSR_SECTIONS];
+    uint64_t end = layoutCsr(n, m, header.payloadOffset, offsets);
+    if (degrees) {
+        header.degreesOffset = alignUp(end);
+        uint64_t inOffset;
+        end = layoutDegrees(n, header.degreesOffset, inOffset);
+    }
+    header.fileSize = end;
+
+    // рёбра всех вершин лежат в графе подряд, начиная со списка первой вершины
+    const void *sections[CSR_SECTIONS] = {
+            loops.data(),
+            graph.getOutOffsets(), graph.getOutTargets(0), graph.getOutValues(0),
+            graph.getInOffsets(), graph.getInSources(0), graph.getInValues(0)
+    };
+    const uint64_t sizes[CSR_SECTIONS] = {
+            (uint64_t) n * sizeof(int32_t),
+            ((uint64_t) n + 1) * sizeof(int64_t), m * sizeof(int32_t), m * sizeof(int32_t),
+            ((uint64_t) n + 1) * sizeof(int64_t), m * sizeof(int32_t), m * sizeof(int32_t)
+    };
+
+    SectionWriter writer(path);
+    writer.write(&header, sizeof(header));
+    for (int section = 0; section < CSR_SECTIONS; section++) {
+        writer.seek(offsets[section]);
+        writer.write(sections[section], sizes[section]);
+    }
+    if (degrees)
+        writeDegrees(writer, header, outDegrees, inDegrees);
+    writer.seek(header.fileSize);
+    writer.close();
+}
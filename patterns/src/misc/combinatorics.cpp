@@ -1,4 +1,5 @@
 #include "misc/combinatorics.h"
+#include <limits>
 
 /**
  * Получить обратную перестановку
@@ -50,6 +51,26 @@ int **makePermute(int **source, int sz, const int *p) {
     return res;
 }
 
+/**
+ * Применить перестановку к матрице
+ *
+ * @param source источник
+ * @param p      перестановка
+ * @return переставленная матрица
+ */
+Matrix makePermute(const Matrix &source, const int *p) {
+    Matrix res(source.getSize());
+
+    for (int i = 0; i < source.getSize(); i++) {
+        int *row = res.getRow(i);
+        const int *sourceRow = source.getRow(p[i]);
+        for (int j = 0; j < source.getSize(); j++)
+            row[j] = sourceRow[p[j]];
+    }
+
+    return res;
+}
+
 /**
  * Получить случайную комбинацию
  *
@@ -63,30 +84,15 @@ CombinatoricsData getRandomCombination(int n, int k) {
                 "getRandomCombination() arr size: " + std::to_string(n) + " elems cnt " + std::to_string(k)
         );
 
-    // создаём множество значений случайной комбинации
-    std::unordered_set<int> combination;
-
-    // пока не набралось достаточное количество значений в множестве
-    while (combination.size() < k)
-        // добавляем в него случайное значение от 0 до n
-        combination.insert(std::abs(std::rand()) % n);
-
-    // переводим комбинацию из множества в список
-    std::vector<int> lst(combination.begin(), combination.end());
-
-
-    // перемешиваем этот список
-    auto rng = std::default_random_engine{};
-    std::shuffle(std::begin(lst), std::end(lst), rng);
-
-    // массив итоговой комбинации
-    int *res = new int[k];
-    // заполняем массив, начиная с нулевого индекса
-    int pos = 0;
-    for (int e: lst)
-        res[pos++] = e;
+    // частичная перетасовка Фишера-Йетса: первые k элементов - случайные
+    // различные значения в случайном порядке
+    std::vector<int> lst(n);
+    for (int i = 0; i < n; i++)
+        lst[i] = i;
+    for (int i = 0; i < k; i++)
+        std::swap(lst[i], lst[i + std::abs(std::rand()) % (n - i)]);
 
-    return {res, k};
+    return {lst.data(), k};
 }
 
 
@@ -102,30 +108,15 @@ int *getRandomPermutation(int size) {
                 "getRandomPermutation() permutation size is not acceptable: " + std::to_string(size)
         );
 
-    // заполняем массив данных заданной длины случайными числами
-    int *r = new int[size];
-    for (int i = 0; i < size; i++)
-        r[i] = std::rand() % 20000 - 10000;
-
     // заполняем массив заданной длины индексами
     int *rc = new int[size];
     for (int i = 0; i < size; i++)
         rc[i] = i;
 
-    // сортируем совместно два массива по значению из массива данных
-    for (int i = 0; i < size; i++)
-        for (int j = i + 1; j < size; j++)
-            if (r[i] < r[j]) {
-                int c = r[i];
-                r[i] = r[j];
-                r[j] = c;
-
-                c = rc[i];
-                rc[i] = rc[j];
-                rc[j] = c;
-            }
-    // возвращаем отсортированный по значениям массива данных
-    // массив индексов
+    // перетасовка Фишера-Йетса: каждый элемент меняется местами со случайным
+    // элементом из ещё не перемешанного начала массива
+    for (int i = size - 1; i > 0; i--)
+        std::swap(rc[i], rc[std::abs(std::rand()) % (i + 1)]);
     return rc;
 }
 
@@ -164,6 +155,28 @@ int **getSubMatrix(int **source, const int *select, int selectSize) {
 }
 
 
+/**
+ * Получить подматрицу по массиву используемых индексов
+ *
+ * @param source     источник
+ * @param select     массив используемых индексов
+ * @param selectSize размер массива используемых индексов
+ * @return подматрица
+ */
+Matrix getSubMatrix(const Matrix &source, const int *select, int selectSize) {
+    Matrix res(selectSize);
+
+    for (int i = 0; i < selectSize; i++) {
+        int *row = res.getRow(i);
+        const int *sourceRow = source.getRow(select[i]);
+        for (int j = 0; j < selectSize; j++)
+            row[j] = sourceRow[select[j]];
+    }
+
+    return res;
+}
+
+
 /**
  * Проверка на равенство двух матриц
  *
@@ -181,6 +194,28 @@ bool areEqual(int **a, int **b, int sz) {
     return true;
 }
 
+/**
+ * Проверка на равенство двух матриц
+ *
+ * @param a первая матрица
+ * @param b вторая матрица
+ * @return флаг, равны ли матрицы
+ */
+bool areEqual(const Matrix &a, const Matrix &b) {
+    if (a.getSize() != b.getSize())
+        return false;
+
+    for (int i = 0; i < a.getSize(); i++) {
+        const int *rowA = a.getRow(i);
+        const int *rowB = b.getRow(i);
+        for (int j = 0; j < a.getSize(); j++)
+            if (rowA[j] != rowB[j])
+                return false;
+    }
+
+    return true;
+}
+
 
 /**
  * Получить случайную матрицу
@@ -192,9 +227,10 @@ bool areEqual(int **a, int **b, int sz) {
  * @return случайная матрица
  */
 int **randomMatrix(int n, int minVal, int maxVal, double nonZeroPart) {
+    // невыбранные элементы остаются нулевыми
     int **r = new int *[n];
     for (int i = 0; i < n; i++)
-        r[i] = new int[n];
+        r[i] = new int[n]();
 
     // и заполняем её случайными значениями
     for (int i = 0; i < n; i++)
@@ -204,3 +240,124 @@ int **randomMatrix(int n, int minVal, int maxVal, double nonZeroPart) {
 
     return r;
 }
+
+/**
+ * Наибольший общий делитель
+ *
+ * @param a первое число
+ * @param b второе число
+ * @return наибольший общий делитель
+ */
+static long long gcd(long long a, long long b) {
+    while (b != 0) {
+        long long t = a % b;
+        a = b;
+        b = t;
+    }
+    return a;
+}
+
+/**
+ * Получить биномиальный коэффициент - кол-во комбинаций из `n` элементов по `k`
+ *
+ * @param n общее число элементов
+ * @param k размер комбинации
+ * @return кол-во комбинаций; `0`, если `k < 0` или `k > n`
+ * @throws std::overflow_error если кол-во не помещается в `long long`
+ */
+long long binomial(int n, int k) {
+    if (k < 0 || k > n)
+        return 0;
+    k = std::min(k, n - k);
+
+    // C(n - k + i, i) = C(n - k + i - 1, i - 1) * (n - k + i) / i; чтобы промежуточное
+    // произведение не переполнялось, сначала сокращаем дробь на gcd(res, i)
+    long long res = 1;
+    for (int i = 1; i <= k; i++) {
+        long long g = gcd(res, i);
+        long long factor = (long long) (n - k + i) / (i / g);
+        res /= g;
+        if (res > std::numeric_limits<long long>::max() / factor)
+            throw std::overflow_error(
+                    "binomial() result is too big: n " + std::to_string(n) + " k " + std::to_string(k)
+            );
+        res *= factor;
+    }
+    return res;
+}
+
+/**
+ * Получить номер возрастающей комбинации в порядке перебора `combine()` (лексикографическом)
+ *
+ * @param c возрастающая комбинация
+ * @param n общее число элементов
+ * @param k размер комбинации
+ * @return номер комбинации, от `0` до `binomial(n, k) - 1`
+ */
+long long rankCombination(const int *c, int n, int k) {
+    long long rank = 0;
+    int min = 0;
+    for (int i = 0; i < k; i++) {
+        if (c[i] < min || c[i] > n - k + i)
+            throw std::invalid_argument(
+                    "rankCombination() combination is not acceptable at " + std::to_string(i) + ": " +
+                    std::to_string(c[i])
+            );
+        // пропускаем все комбинации, у которых на i-ой позиции стоит меньшее значение
+        for (int v = min; v < c[i]; v++)
+            rank += binomial(n - 1 - v, k - 1 - i);
+        min = c[i] + 1;
+    }
+    return rank;
+}
+
+/**
+ * Получить возрастающую комбинацию по её номеру в порядке перебора `combine()`
+ *
+ * @param rank номер комбинации, от `0` до `binomial(n, k) - 1`
+ * @param n    общее число элементов
+ * @param k    размер комбинации
+ * @param c    массив из `k` элементов, в который записывается комбинация
+ */
+void unrankCombination(long long rank, int n, int k, int *c) {
+    if (k < 0 || k > n || rank < 0 || rank >= binomial(n, k))
+        throw std::invalid_argument(
+                "unrankCombination() rank is not acceptable: " + std::to_string(rank) +
+                " n " + std::to_string(n) + " k " + std::to_string(k)
+        );
+
+    int v = 0;
+    for (int i = 0; i < k; i++) {
+        // кол-во комбинаций, у которых на i-ой позиции стоит `v`, - это C(n - 1 - v, k - 1 - i);
+        // пропускаем значения, пока номер не попадёт в такой блок
+        long long block = binomial(n - 1 - v, k - 1 - i);
+        while (rank >= block) {
+            rank -= block;
+            v++;
+            block = binomial(n - 1 - v, k - 1 - i);
+        }
+        c[i] = v++;
+    }
+}
+
+/**
+ * Перейти к следующей возрастающей комбинации в порядке перебора `combine()`
+ *
+ * @param c возрастающая комбинация; заменяется следующей
+ * @param n общее число элементов
+ * @param k размер комбинации
+ * @return флаг, есть ли следующая комбинация; если нет, `c` не меняется
+ */
+bool nextCombination(int *c, int n, int k) {
+    // ищем самую правую позицию, значение на которой ещё можно увеличить
+    int i = k - 1;
+    while (i >= 0 && c[i] == n - k + i)
+        i--;
+    if (i < 0)
+        return false;
+    // увеличиваем его, а все значения правее делаем наименьшими возможными
+    c[i]++;
+    for (int j = i + 1; j < k; j++)
+        c[j] = c[j - 1] + 1;
+    return true;
+}
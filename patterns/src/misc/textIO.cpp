@@ -0,0 +1,89 @@
+#include "misc/textIO.h"
+
+#include <sstream>
+#include <string>
+
+/**
+ * Прочитать матрицу в текстовом формате: сначала размер стороны,
+ * затем все элементы построчно через пробельные символы
+ *
+ * @param in поток ввода
+ * @return матрица
+ */
+Matrix readMatrix(std::istream &in) {
+    int sz;
+    if (!(in >> sz) || sz < 0)
+        throw std::invalid_argument("readMatrix() can not read matrix size");
+
+    Matrix res(sz);
+    for (int i = 0; i < sz; i++) {
+        int *row = res.getRow(i);
+        for (int j = 0; j < sz; j++)
+            if (!(in >> row[j]))
+                throw std::invalid_argument(
+                        "readMatrix() can not read element " + std::to_string(i) + " " + std::to_string(j)
+                );
+    }
+    return res;
+}
+
+/**
+ * Записать матрицу в текстовом формате: в первой строке размер стороны,
+ * затем по строке матрицы на каждой строке файла
+ *
+ * @param out    поток вывода
+ * @param matrix матрица
+ */
+void writeMatrix(std::ostream &out, const Matrix &matrix) {
+    out << matrix.getSize() << "\n";
+    for (int i = 0; i < matrix.getSize(); i++) {
+        const int *row = matrix.getRow(i);
+        for (int j = 0; j < matrix.getSize(); j++) {
+            if (j > 0)
+                out << " ";
+            out << row[j];
+        }
+        out << "\n";
+    }
+}
+
+/**
+ * Прочитать список комбинаций: по одной комбинации на строку,
+ * элементы через пробел; пустые строки пропускаются
+ *
+ * @param in поток ввода
+ * @return список комбинаций
+ */
+std::vector<CombinatoricsData> readCombinations(std::istream &in) {
+    std::vector<CombinatoricsData> res;
+    std::string line;
+    std::vector<int> values;
+    while (std::getline(in, line)) {
+        // разбираем элементы строки
+        std::istringstream lineStream(line);
+        values.clear();
+        int value;
+        while (lineStream >> value)
+            values.push_back(value);
+        if (!values.empty())
+            res.emplace_back(values.data(), (int) values.size());
+    }
+    return res;
+}
+
+/**
+ * Записать список комбинаций: по одной комбинации на строку, элементы через пробел
+ *
+ * @param out          поток вывода
+ * @param combinations список комбинаций
+ */
+void writeCombinations(std::ostream &out, const std::vector<CombinatoricsData> &combinations) {
+    for (const CombinatoricsData &cd: combinations) {
+        for (int i = 0; i < cd.getSize(); i++) {
+            if (i > 0)
+                out << " ";
+            out << cd.getData()[i];
+        }
+        out << "\n";
+    }
+}
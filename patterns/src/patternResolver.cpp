@@ -1,4 +1,6 @@
 #include "patternResolver.h"
+#include <atomic>
+#include <thread>
 
 
 /**
@@ -47,6 +49,95 @@ bool arePermutatedEquals(
     return true;
 }
 
+/**
+ * Проверка переставленной подматрицы на равенство целевой матрице;
+ * Этот метод проверяет, что каждому ненулевому элементу образца
+ * должен соответствовать ненулевой элемент в переставленной матрице.
+ * В случае жёсткой проверки каждому нулевому элементу целевой матрицы должен
+ * соответствовать нулевой элемент переставленной матрицы
+ *
+ * @param p          перестановка
+ * @param source     матрица-источник
+ * @param target     матрица-цель
+ * @param sourceSum  степени вершин у графа-источника
+ * @param targetSum  степени вершин у графа-цели
+ * @param hardCheck  флаг, нужна ли жёсткая проверка
+ * @return - флаг, является ли одна матрица перестановкой другой
+ */
+bool arePermutatedEquals(
+        const int *p, const Matrix &source, const Matrix &target, const int *sourceSum, const int *targetSum,
+        bool hardCheck
+) {
+    int sz = target.getSize();
+
+    // проверяем, что у графов совпадают степени вершин
+    for (int i = 0; i < sz; i++)
+        // или её степень меньше степени в паттерне
+        if (hardCheck && sourceSum[p[i]] < targetSum[i])
+            return false;
+
+    // перебираем все вершины
+    for (int i = 0; i < sz; i++) {
+        const int *targetRow = target.getRow(i);
+        const int *sourceRow = source.getRow(p[i]);
+        // снова перебираем все вершины
+        for (int j = 0; j < sz; j++) {
+            // если проверка жёсткая и элемент из переставленной не совпадает с соответствующим
+            // элементом из целевой матрицы
+            if (hardCheck && targetRow[j] != sourceRow[p[j]])
+                // возвращаем флаг, что матрицы не равны
+                return false;
+            // если проверка нежёсткая, элемент целевой матрицы не равен 0
+            // и при этом элемент из переставленной не совпадает с соответствующим
+            // элементом из целевой матрицы
+            if (!hardCheck && targetRow[j] != 0 && targetRow[j] != sourceRow[p[j]])
+                // возвращаем флаг, что матрицы не равны
+                return false;
+        }
+    }
+    // если не встречено неравных элементов, то возвращаем флаг, что матрицы равны
+    return true;
+}
+
+
+/**
+ * Проверка префикса перестановки: сравнивает с целевой матрицей только элементы
+ * переставленной матрицы между последней точкой префикса и всеми точками префикса,
+ * по тем же правилам, что и `arePermutatedEquals`. Перестановка, у которой допустимы
+ * все префиксы, удовлетворяет и `arePermutatedEquals`
+ *
+ * @param p          префикс перестановки
+ * @param pos        номер последней точки префикса
+ * @param source     матрица-источник
+ * @param target     матрица-цель
+ * @param sourceSum  степени вершин у графа-источника
+ * @param targetSum  степени вершин у графа-цели
+ * @param hardCheck  флаг, нужна ли жёсткая проверка
+ * @return флаг, может ли префикс быть началом подходящей перестановки
+ */
+bool isPermutatedPrefixValid(
+        const int *p, int pos, const Matrix &source, const Matrix &target, const int *sourceSum,
+        const int *targetSum, bool hardCheck
+) {
+    // при жёсткой проверке степень вершины не может быть меньше степени в паттерне
+    if (hardCheck && sourceSum[p[pos]] < targetSum[pos])
+        return false;
+
+    const int *targetRow = target.getRow(pos);
+    const int *sourceRow = source.getRow(p[pos]);
+    // перебираем точки префикса вместе с последней, чтобы проверить и диагональный элемент
+    for (int j = 0; j <= pos; j++) {
+        // элемент из строки последней точки
+        int expected = targetRow[j];
+        if ((hardCheck || expected != 0) && expected != sourceRow[p[j]])
+            return false;
+        // элемент из столбца последней точки
+        expected = target.get(j, pos);
+        if ((hardCheck || expected != 0) && expected != source.get(p[j], p[pos]))
+            return false;
+    }
+    return true;
+}
 
 /**
  * Получить массив степеней вершин
@@ -80,6 +171,38 @@ int *getPowers(int **connectivityMatrix, int sz) {
     return powers;
 }
 
+/**
+ * Получить массив степеней вершин
+ *
+ * @param connectivityMatrix матрица связности
+ * @return массив степеней вершин
+ */
+int *getPowers(const Matrix &connectivityMatrix) {
+    int sz = connectivityMatrix.getSize();
+    // создаём массив степеней вершин
+    int *powers = new int[sz];
+
+    // перебираем все точки паттерна
+    for (int i = 0; i < sz; i++)
+        powers[i] = 0;
+
+    // перебираем все строки матрицы
+    for (int i = 0; i < sz; i++) {
+        const int *row = connectivityMatrix.getRow(i);
+        // внутри перебираем все элементы строки
+        for (int j = 0; j < sz; j++)
+            // если есть ребро от i-ой точки к j-ой
+            if (row[j] != 0) {
+                // увеличиваем степень i-ой вершины
+                powers[i]++;
+                // и степень j-ой вершины
+                powers[j]++;
+            }
+    }
+    // возвращаем массив степеней
+    return powers;
+}
+
 
 /**
  * Поиск всех перестановок исходной матрицы таких, что переставленная матрица совпадает
@@ -98,22 +221,42 @@ int *getPowers(int **connectivityMatrix, int sz) {
  */
 std::unordered_set<CombinatoricsData, CombinatoricsData::HashFunction>
 getAllIsomorphicPermutations(int **source, int **target, int sz, bool hardCheck) {
+    return getAllIsomorphicPermutations(Matrix(source, sz), Matrix(target, sz), hardCheck);
+}
+
+/**
+ * Поиск всех перестановок исходной матрицы таких, что переставленная матрица совпадает
+ * с целевой
+ *
+ * @param source    матрица-источник
+ * @param target    целевая матрица
+ * @param hardCheck флаг, нужна ли жёсткая проверка
+ * @return список всех перестановок исходной матрицы таких, что переставленная матрица совпадает
+ * с целевой
+ */
+std::unordered_set<CombinatoricsData, CombinatoricsData::HashFunction>
+getAllIsomorphicPermutations(const Matrix &source, const Matrix &target, bool hardCheck) {
+    int sz = target.getSize();
     // степени вершин
-    int *sourceSum = getPowers(source, sz);
-    int *targetSum = getPowers(target, sz);
+    int *sourceSum = getPowers(source);
+    int *targetSum = getPowers(target);
 
 
     // множество перестановок
     std::unordered_set<CombinatoricsData, CombinatoricsData::HashFunction> ps;
-    // запускаем генерацию перестановок
+    // запускаем генерацию перестановок, отсекая префиксы, которые уже не совпадают с целевой матрицей
     generatePermutations(
             sz,
-            [&ps, &sz, &source, &target, &hardCheck, &targetSum, &sourceSum](int *p) {
-                // если подграф изоморфен паттерну по рассматриваемой перестановке
-                if (arePermutatedEquals(p, source, target, sourceSum, targetSum, sz, hardCheck))
-                    // добавляем эту перестановку в множество изоморфных перестановок
-                    ps.insert(CombinatoricsData(p, sz));
+            [&source, &target, &hardCheck, &targetSum, &sourceSum](const int *p, int pos) {
+                return isPermutatedPrefixValid(p, pos, source, target, sourceSum, targetSum, hardCheck);
+            },
+            [&ps, &sz](int *p) {
+                // все префиксы допустимы, значит подграф изоморфен паттерну по этой перестановке
+                ps.insert(CombinatoricsData(p, sz));
             });
+
+    delete[] sourceSum;
+    delete[] targetSum;
     return ps;
 }
 
@@ -134,34 +277,303 @@ getAllIsomorphicPermutations(int **source, int **target, int sz, bool hardCheck)
  */
 std::vector<CombinatoricsData>
 getAllPatterns(int **source, int sourceSize, int **pattern, int patternSize, bool hardCheck) {
+    return getAllPatterns(Matrix(source, sourceSize), Matrix(pattern, patternSize), hardCheck);
+}
+
+/**
+ * Рабочие буферы полного перебора; заводятся один раз на поток,
+ * чтобы не выделять память на каждую комбинацию и перестановку
+ */
+struct OracleScratch {
+    /**
+     * Подматрица дата-графа по текущей комбинации
+     */
+    Matrix subMatrix;
+    /**
+     * Степени вершин подматрицы
+     */
+    std::vector<int> powers;
+    /**
+     * Переставленная комбинация
+     */
+    std::vector<int> permuted;
+    /**
+     * Генератор перестановок комбинации
+     */
+    PermutationGenerator permutations;
+
+    /**
+     * Конструктор
+     *
+     * @param patternSize размер стороны паттерна
+     */
+    explicit OracleScratch(int patternSize) :
+            subMatrix(patternSize), powers(patternSize), permuted(patternSize), permutations(patternSize) {
+    }
+};
+
+/**
+ * Кол-во частей полного перебора на один поток: частей больше, чем потоков,
+ * чтобы потоки, быстро закончившие свои части, забирали оставшиеся
+ */
+static const int ORACLE_CHUNKS_PER_THREAD = 64;
+
+/**
+ * Посчитать степени вершин матрицы, как `getPowers`, но в готовый массив
+ *
+ * @param connectivityMatrix матрица связности
+ * @param powers             массив, в который записываются степени
+ */
+static void fillPowers(const Matrix &connectivityMatrix, int *powers) {
+    int sz = connectivityMatrix.getSize();
+    for (int i = 0; i < sz; i++)
+        powers[i] = 0;
+    for (int i = 0; i < sz; i++) {
+        const int *row = connectivityMatrix.getRow(i);
+        for (int j = 0; j < sz; j++)
+            if (row[j] != 0) {
+                powers[i]++;
+                powers[j]++;
+            }
+    }
+}
+
+/**
+ * Найти все вхождения паттерна, вершины которых составляют заданную возрастающую комбинацию
+ *
+ * Делает то же, что `getAllIsomorphicPermutations` для подматрицы по комбинации,
+ * но в буферах потока: различные перестановки дают различные комбинации, поэтому
+ * собирать их в хэш-множество не нужно
+ *
+ * @param source        дата-граф
+ * @param pattern       искомый паттерн
+ * @param patternPowers степени вершин паттерна
+ * @param hardCheck     флаг, нужна ли жёсткая проверка
+ * @param c             возрастающая комбинация вершин дата-графа
+ * @param scratch       рабочие буферы потока
+ * @param consumer      обработчик переставленной комбинации (const int *c)->{}
+ */
+template<typename F>
+static void forEachCombinationPattern(
+        const Matrix &source, const Matrix &pattern, const int *patternPowers, bool hardCheck, const int *c,
+        OracleScratch &scratch, const F &consumer
+) {
+    int patternSize = pattern.getSize();
+    // заполняем подматрицу дата-графа по комбинации
+    for (int i = 0; i < patternSize; i++) {
+        int *row = scratch.subMatrix.getRow(i);
+        const int *sourceRow = source.getRow(c[i]);
+        for (int j = 0; j < patternSize; j++)
+            row[j] = sourceRow[c[j]];
+    }
+    // степени вершин нужны только для жёсткой проверки
+    if (hardCheck)
+        fillPowers(scratch.subMatrix, scratch.powers.data());
+
+    // перебираем перестановки, отсекая префиксы, которые уже не совпадают с паттерном
+    scratch.permutations.run(
+            [&scratch, &pattern, &patternPowers, &hardCheck](const int *p, int pos) {
+                return isPermutatedPrefixValid(
+                        p, pos, scratch.subMatrix, pattern, scratch.powers.data(), patternPowers, hardCheck
+                );
+            },
+            [&scratch, &patternSize, &c, &consumer](int *p) {
+                // i-ой точке паттерна соответствует p[i]-ая вершина комбинации
+                for (int i = 0; i < patternSize; i++)
+                    scratch.permuted[i] = c[p[i]];
+                consumer(scratch.permuted.data());
+            }
+    );
+}
+
+/**
+ * Поиск изоморфных подграфов полным перебором
+ *
+ * @param source    матрица-источник
+ * @param pattern   искомый паттерн
+ * @param hardCheck флаг, нужна ли жёсткая проверка
+ * @return список таких комбинаций точек из источника, чтобы при составлении
+ * соответствующих переставленных подматриц, подграфы, построенные по ним,
+ * были изоморфны заданному паттерну
+ */
+std::vector<CombinatoricsData>
+getAllPatterns(const Matrix &source, const Matrix &pattern, bool hardCheck) {
     // множество найденных паттернов
-    std::vector<CombinatoricsData> res;
+    MatchSet res(pattern.getSize());
+    getAllPatterns(source, pattern, hardCheck, res);
+    // возвращаем множество найденных паттернов
+    return res.toCombinations();
+}
+
+/**
+ * Поиск изоморфных подграфов полным перебором с записью комбинаций в множество
+ *
+ * @param source    матрица-источник
+ * @param pattern   искомый паттерн
+ * @param hardCheck флаг, нужна ли жёсткая проверка
+ * @param res       множество, в конец которого добавляются найденные комбинации;
+ *                  размер его комбинаций должен совпадать с размером паттерна
+ */
+void getAllPatterns(const Matrix &source, const Matrix &pattern, bool hardCheck, MatchSet &res) {
+    int patternSize = pattern.getSize();
+    if (res.getWidth() != patternSize)
+        throw std::invalid_argument(
+                "getAllPatterns() match set width is not acceptable: " + std::to_string(res.getWidth())
+        );
+
+    // степени вершин паттерна и рабочие буферы считаются один раз на весь перебор
+    std::vector<int> patternPowers(patternSize);
+    fillPowers(pattern, patternPowers.data());
+    OracleScratch scratch(patternSize);
 
     // перебираем все возрастающие комбинации
-    combine(sourceSize, patternSize, [&source, &patternSize, &res, &pattern, &hardCheck](const int *c) {
-        // для каждой из них получаем матрицу из дата-графа по этой комбинации
-        int **subMatrix = getSubMatrix(source, c, patternSize);
-
-        // находим все перестановки, которые связывают паттерн
-        // и составленную подматрицу
-        std::unordered_set<CombinatoricsData, CombinatoricsData::HashFunction> ps =
-                getAllIsomorphicPermutations(subMatrix, pattern, patternSize, hardCheck);
-
-        // для каждой найденной перестановки
-        for (CombinatoricsData p: ps) {
-            // в множество добавляем переставленную комбинацию
-            // в соответствии с той, которая найдена при поиске изоморфных
-            // матриц
-            res.emplace_back(
-                    makePermute(c, patternSize, getReversePermutation(p.getData(), p.getSize())),
-                    p.getSize()
-            );
-        }
+    combine(source.getSize(), patternSize, [&source, &pattern, &patternPowers, &hardCheck, &scratch, &res](const int *c) {
+        forEachCombinationPattern(
+                source, pattern, patternPowers.data(), hardCheck, c, scratch, [&res](const int *permuted) {
+                    res.add(permuted);
+                }
+        );
     });
+}
 
+/**
+ * Поиск изоморфных подграфов полным перебором в несколько потоков
+ *
+ * @param source      матрица-источник
+ * @param pattern     искомый паттерн
+ * @param hardCheck   флаг, нужна ли жёсткая проверка
+ * @param threadCount кол-во потоков
+ * @return список комбинаций в том же порядке, что и у однопоточного `getAllPatterns`
+ */
+std::vector<CombinatoricsData>
+getAllPatterns(const Matrix &source, const Matrix &pattern, bool hardCheck, int threadCount) {
+    // множество найденных паттернов
+    MatchSet res(pattern.getSize());
+    getAllPatterns(source, pattern, hardCheck, threadCount, res);
     // возвращаем множество найденных паттернов
-    return res;
+    return res.toCombinations();
+}
+
+/**
+ * Поиск изоморфных подграфов полным перебором в несколько потоков с записью комбинаций в множество
+ *
+ * Возрастающие комбинации делятся на части с равным кол-вом комбинаций по их номерам
+ * (`rankCombination`); потоки забирают следующую часть из общего атомарного счётчика,
+ * поэтому загрузка выравнивается сама собой. Каждый поток пишет вхождения в свой буфер,
+ * а в конце части склеиваются по порядку номеров
+ *
+ * @param source      матрица-источник
+ * @param pattern     искомый паттерн
+ * @param hardCheck   флаг, нужна ли жёсткая проверка
+ * @param threadCount кол-во потоков
+ * @param res         множество, в конец которого добавляются найденные комбинации в порядке
+ *                    однопоточного `getAllPatterns`; размер его комбинаций должен совпадать с размером паттерна
+ */
+void getAllPatterns(const Matrix &source, const Matrix &pattern, bool hardCheck, int threadCount, MatchSet &res) {
+    if (threadCount < 1)
+        throw std::invalid_argument(
+                "getAllPatterns() thread count is not acceptable: " + std::to_string(threadCount)
+        );
+
+    int sourceSize = source.getSize();
+    int patternSize = pattern.getSize();
+    // в один поток, для пустого и для слишком большого паттерна работаем без потоков
+    if (threadCount == 1 || patternSize == 0 || patternSize > sourceSize) {
+        getAllPatterns(source, pattern, hardCheck, res);
+        return;
+    }
+    if (res.getWidth() != patternSize)
+        throw std::invalid_argument(
+                "getAllPatterns() match set width is not acceptable: " + std::to_string(res.getWidth())
+        );
+
+    std::vector<int> patternPowers(patternSize);
+    fillPowers(pattern, patternPowers.data());
+
+    // часть перебора: вершины её вхождений лежат в буфере потока `worker` с `from` по `to`
+    struct Chunk {
+        int worker;
+        long long from;
+        long long to;
+    };
+    // делим все комбинации на части равного размера, по несколько на поток
+    long long combinationsCnt = binomial(sourceSize, patternSize);
+    long long chunksCnt = std::min(combinationsCnt, (long long) threadCount * ORACLE_CHUNKS_PER_THREAD);
+    long long chunkSize = (combinationsCnt + chunksCnt - 1) / chunksCnt;
+    // после округления размера части вверх последние части могут оказаться лишними
+    chunksCnt = (combinationsCnt + chunkSize - 1) / chunkSize;
+    std::vector<Chunk> chunks(chunksCnt);
+    std::atomic<long long> nextChunk(0);
+
+    std::vector<MatchSet> buffers;
+    for (int i = 0; i < threadCount; i++)
+        buffers.emplace_back(patternSize);
+
+    std::vector<std::thread> threads;
+    for (int worker = 0; worker < threadCount; worker++)
+        threads.emplace_back([&buffers, &chunks, &nextChunk, &chunksCnt, &chunkSize, &combinationsCnt, &source,
+                                     &pattern, &patternPowers, &hardCheck, &patternSize, &sourceSize, worker]() {
+            OracleScratch scratch(patternSize);
+            MatchSet &buffer = buffers[worker];
+            for (long long chunk = nextChunk++; chunk < chunksCnt; chunk = nextChunk++) {
+                long long from = buffer.getSize();
+                // перебираем комбинации с номерами из этой части
+                long long fromRank = chunk * chunkSize;
+                long long toRank = std::min(combinationsCnt, fromRank + chunkSize);
+                combineRange(
+                        sourceSize, patternSize, fromRank, toRank,
+                        [&source, &pattern, &patternPowers, &hardCheck, &scratch, &buffer](const int *c) {
+                            forEachCombinationPattern(
+                                    source, pattern, patternPowers.data(), hardCheck, c, scratch,
+                                    [&buffer](const int *permuted) {
+                                        buffer.add(permuted);
+                                    }
+                            );
+                        }
+                );
+                chunks[chunk] = Chunk{worker, from, buffer.getSize()};
+            }
+        });
+    for (std::thread &thread: threads)
+        thread.join();
+
+    // склеиваем части в порядке номеров
+    long long total = 0;
+    for (const MatchSet &buffer: buffers)
+        total += buffer.getSize();
+    res.reserve(res.getSize() + total);
+    for (const Chunk &chunk: chunks)
+        for (long long k = chunk.from; k < chunk.to; k++)
+            res.add(buffers[chunk.worker][k].data());
 }
 
+/**
+ * Подсчёт изоморфных подграфов полным перебором
+ *
+ * @param source    матрица-источник
+ * @param pattern   искомый паттерн
+ * @param hardCheck флаг, нужна ли жёсткая проверка
+ * @return кол-во комбинаций, которые вернул бы `getAllPatterns`
+ */
+long long countAllPatterns(const Matrix &source, const Matrix &pattern, bool hardCheck) {
+    int patternSize = pattern.getSize();
+    // кол-во найденных паттернов
+    long long res = 0;
+
+    std::vector<int> patternPowers(patternSize);
+    fillPowers(pattern, patternPowers.data());
+    OracleScratch scratch(patternSize);
 
+    // перебираем все возрастающие комбинации
+    combine(source.getSize(), patternSize, [&source, &pattern, &patternPowers, &hardCheck, &scratch, &res](const int *c) {
+        // каждая перестановка, связывающая паттерн и подматрицу, даёт одну комбинацию
+        forEachCombinationPattern(
+                source, pattern, patternPowers.data(), hardCheck, c, scratch, [&res](const int *) {
+                    res++;
+                }
+        );
+    });
 
+    // возвращаем кол-во найденных паттернов
+    return res;
+}
@@ -0,0 +1,58 @@
+#include "patternSymmetry.h"
+
+#include <algorithm>
+#include "patternResolver.h"
+
+/**
+ * Получить группу автоморфизмов паттерна
+ *
+ * @param pattern паттерн
+ * @return автоморфизмы в лексикографическом порядке; первый из них - тождественная перестановка
+ */
+std::vector<CombinatoricsData> getAutomorphisms(const Matrix &pattern) {
+    // при жёсткой проверке переставленный паттерн должен совпасть с исходным поэлементно
+    std::unordered_set<CombinatoricsData, CombinatoricsData::HashFunction> permutations =
+            getAllIsomorphicPermutations(pattern, pattern, true);
+
+    std::vector<CombinatoricsData> res(permutations.begin(), permutations.end());
+    std::sort(res.begin(), res.end());
+    return res;
+}
+
+/**
+ * Получить ограничения порядка, отсекающие симметричные комбинации
+ *
+ * @param automorphisms группа автоморфизмов паттерна
+ * @return пары `(a, b)`: вершина точки `a` должна быть меньше вершины точки `b`
+ */
+std::vector<std::pair<int, int>> getSymmetryBreakingConstraints(const std::vector<CombinatoricsData> &automorphisms) {
+    std::vector<std::pair<int, int>> res;
+    if (automorphisms.empty())
+        return res;
+
+    int sz = automorphisms.front().getSize();
+    // текущая подгруппа: стабилизатор уже обработанных точек
+    std::vector<const CombinatoricsData *> group;
+    for (const CombinatoricsData &p: automorphisms)
+        group.push_back(&p);
+
+    for (int v = 0; v < sz && group.size() > 1; v++) {
+        // орбита точки v в текущей подгруппе
+        std::vector<bool> orbit(sz, false);
+        for (const CombinatoricsData *p: group)
+            orbit[p->getData()[v]] = true;
+
+        // вершина точки v должна быть меньше вершин остальных точек её орбиты
+        for (int w = 0; w < sz; w++)
+            if (w != v && orbit[w])
+                res.emplace_back(v, w);
+
+        // оставляем только перестановки, которые не сдвигают точку v
+        std::vector<const CombinatoricsData *> stabilizer;
+        for (const CombinatoricsData *p: group)
+            if (p->getData()[v] == v)
+                stabilizer.push_back(p);
+        group.swap(stabilizer);
+    }
+    return res;
+}
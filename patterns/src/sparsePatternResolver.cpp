@@ -0,0 +1,50 @@
+#include "sparsePatternResolver.h"
+
+/**
+ * Поиск изоморфных подграфов в разреженном дата-графе
+ *
+ * @param source    дата-граф
+ * @param pattern   искомый паттерн
+ * @param hardCheck флаг, нужна ли жёсткая проверка
+ * @return те же комбинации, что и `fastGetAllPatterns` для плотной матрицы того же графа,
+ * но, возможно, в другом порядке
+ */
+std::vector<CombinatoricsData>
+sparseGetAllPatterns(const CsrGraph &source, const Matrix &pattern, bool hardCheck) {
+    int patternSize = pattern.getSize();
+    // множество найденных паттернов
+    std::vector<CombinatoricsData> res;
+
+    // подготавливаем поиск: допустимые вершины и порядок сопоставления точек паттерна
+    SparsePatternSearch search(source, pattern, hardCheck);
+
+    // запускаем рекурсию
+    search.run([&res, &patternSize](int *c) {
+        res.emplace_back(CombinatoricsData(c, patternSize));
+        return true;
+    });
+
+    // возвращаем множество найденных паттернов
+    return res;
+}
+
+/**
+ * Подсчёт изоморфных подграфов в разреженном дата-графе
+ *
+ * @param source    дата-граф
+ * @param pattern   искомый паттерн
+ * @param hardCheck флаг, нужна ли жёсткая проверка
+ * @return кол-во комбинаций, которые вернул бы `sparseGetAllPatterns`
+ */
+long long sparseCountAllPatterns(const CsrGraph &source, const Matrix &pattern, bool hardCheck) {
+    long long res = 0;
+
+    // подготавливаем поиск: допустимые вершины и порядок сопоставления точек паттерна
+    SparsePatternSearch search(source, pattern, hardCheck);
+    search.run([&res](int *) {
+        res++;
+        return true;
+    });
+
+    return res;
+}
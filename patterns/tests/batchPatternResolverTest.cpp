@@ -0,0 +1,115 @@
+#include <cassert>
+#include <ctime>
+#include <iostream>
+#include "misc/combinatorics.h"
+#include "misc/Matrix.h"
+#include "misc/PatternBuilder.h"
+#include "fastPatternResolver.h"
+
+/**
+ * Получить ведущую подматрицу
+ *
+ * @param pattern матрица
+ * @param size    размер стороны подматрицы
+ * @return подматрица из первых `size` строк и столбцов
+ */
+Matrix getLeading(const Matrix &pattern, int size) {
+    Matrix res(size);
+    for (int i = 0; i < size; i++)
+        for (int j = 0; j < size; j++)
+            res.set(i, j, pattern.get(i, j));
+    return res;
+}
+
+/**
+ * Сверка результатов поиска нескольких паттернов за один обход с результатами
+ * быстрого поиска каждого паттерна по отдельности
+ *
+ * Паттерны строятся из одного случайного паттерна: его ведущие подматрицы, копии
+ * с изменённой последней точкой и точная копия, поэтому у них есть общие ведущие подматрицы
+ *
+ * @param testCnt     кол-во тестов
+ * @param minS        минимальный размер матрицы-источника
+ * @param maxS        максимальный размер матрицы-источника
+ * @param minP        минимальный размер матрицы-паттерна
+ * @param maxP        максимальный размер матрицы-паттерна
+ * @param minE        минимальное значение элементов матриц
+ * @param maxE        максимальный значение элементов матриц
+ * @param nonZeroPart доля ненулевых элементов
+ * @param hardCheck   флаг, нужна ли жёсткая сверка
+ */
+void compare(
+        int testCnt, int minS, int maxS, int minP, int maxP, int minE, int maxE, double nonZeroPart,
+        bool hardCheck
+) {
+    for (int i = 0; i < testCnt; i++) {
+        int sourceSize = std::abs(std::rand()) % (maxS - minS) + minS;
+        int patternSize = std::abs(std::rand()) % (maxP - minP) + minP;
+        // формируем случайные матрицы
+        Matrix source(randomMatrix(sourceSize, minE, maxE, nonZeroPart), sourceSize);
+        Matrix pattern(randomMatrix(patternSize, minE, maxE, nonZeroPart), patternSize);
+
+        // добавляем в дата-граф несколько паттернов
+        PatternBuilder pb(source);
+        for (int j = 0; j < 5;)
+            if (pb.putPattern(pattern.toArray(), patternSize, getRandomCombination(sourceSize, patternSize)))
+                j++;
+
+        // паттерны с общими ведущими подматрицами
+        std::vector<Matrix> patterns;
+        for (int size = 1; size <= patternSize; size++)
+            patterns.push_back(getLeading(pattern, size));
+        for (int j = 0; j < 2; j++) {
+            Matrix changed = pattern;
+            int last = patternSize - 1;
+            changed.set(last, std::abs(std::rand()) % patternSize, std::abs(std::rand()) % (maxE - minE) + minE);
+            changed.set(std::abs(std::rand()) % patternSize, last, std::abs(std::rand()) % (maxE - minE) + minE);
+            patterns.push_back(changed);
+        }
+        patterns.push_back(pattern);
+
+        // общие ведущие подматрицы делят узлы дерева
+        BatchPatternSearch search(source, patterns, hardCheck);
+        assert(search.getNodeCount() <= patternSize + 2);
+
+        std::vector<std::vector<CombinatoricsData>> batch = fastGetAllPatternsBatch(source, patterns, hardCheck);
+        assert(batch.size() == patterns.size());
+        for (int id = 0; id < (int) patterns.size(); id++) {
+            std::vector<CombinatoricsData> single = fastGetAllPatterns(source, patterns[id], hardCheck);
+            std::unordered_set<CombinatoricsData, CombinatoricsData::HashFunction>
+                    singleSet(single.begin(), single.end());
+            std::unordered_set<CombinatoricsData, CombinatoricsData::HashFunction>
+                    batchSet(batch[id].begin(), batch[id].end());
+
+            // каждая комбинация найдена ровно один раз
+            assert(batch[id].size() == single.size());
+            assert(batchSet == singleSet);
+        }
+
+        // обработчик может остановить поиск после первой комбинации
+        long long visited = 0;
+        bool completed = fastForEachPatternBatch(source, patterns, hardCheck, [&visited](int, IntSpan) {
+            visited++;
+            return false;
+        });
+        assert(!completed);
+        assert(visited == 1);
+    }
+}
+
+/**
+ * Главный метод
+ * @return код возрата
+ */
+int main() {
+    long ltime = time(nullptr);
+    int stime = (unsigned int) ltime / 2;
+    srand(stime);
+
+    std::cout << "TEST 1:" << std::endl;
+    compare(10, 30, 40, 3, 5, 0, 3, 0.5, true);
+    std::cout << "TEST 2:" << std::endl;
+    compare(10, 30, 40, 3, 5, -2, 2, 0.3, false);
+    std::cout << "TEST 3:" << std::endl;
+    compare(10, 60, 80, 2, 4, 0, 2, 0.2, false);
+}
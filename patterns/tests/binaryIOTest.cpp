@@ -0,0 +1,204 @@
+#include <cassert>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include "misc/binaryIO.h"
+#include "misc/combinatorics.h"
+#include "misc/CsrGraph.h"
+#include "misc/GraphGenerator.h"
+#include "misc/MatchSet.h"
+#include "misc/Matrix.h"
+#include "misc/textIO.h"
+#include "fastPatternResolver.h"
+#include "sparsePatternResolver.h"
+
+/**
+ * Проверка, что отказ открыть файл выражается исключением
+ *
+ * @param path путь к файлу
+ */
+void checkRejected(const std::string &path) {
+    bool thrown = false;
+    try {
+        MappedGraph mapped(path);
+    } catch (const std::invalid_argument &) {
+        thrown = true;
+    }
+    assert(thrown);
+}
+
+/**
+ * Проверка, что степени файла совпадают со степенями графа
+ *
+ * @param mapped отображённый граф
+ * @param graph  исходный граф
+ */
+void checkDegrees(const MappedGraph &mapped, const CsrGraph &graph) {
+    assert(mapped.hasDegrees());
+    for (int i = 0; i < graph.getSize(); i++) {
+        assert(mapped.getOutDegrees()[i] == graph.getOutDegree(i));
+        assert(mapped.getInDegrees()[i] == graph.getInDegree(i));
+    }
+}
+
+/**
+ * Проверка плотной раскладки: отображённая матрица совпадает с исходной
+ * и ищется без копирования теми же результатами
+ *
+ * @param testCnt    кол-во тестов
+ * @param sourceSize размер матрицы-источника
+ * @param hardCheck  флаг, нужна ли жёсткая сверка
+ */
+void checkDense(int testCnt, int sourceSize, bool hardCheck) {
+    const std::string path = "binaryIOTest_dense.bin";
+    for (int test = 0; test < testCnt; test++) {
+        GraphGenerator generator(std::rand());
+        Matrix source = generator.uniformMatrix(sourceSize + test, -2, 3, 0.4);
+        Matrix pattern = generator.uniformMatrix(4, -2, 3, 0.6);
+        writeBinaryMatrix(path, source);
+        assert(isBinaryGraphFile(path));
+
+        MappedGraph mapped(path);
+        assert(mapped.isDense() && mapped.getSize() == source.getSize());
+        assert(mapped.getEdgeCount() == CsrGraph(source).getEdgeCount());
+        assert(!mapped.isSymmetric());
+        // строки отображённой матрицы выровнены по кэш-линии
+        assert(reinterpret_cast<std::uintptr_t>(mapped.getMatrix().getData()) % 64 == 0);
+        assert(areEqual(mapped.getMatrix(), source));
+        checkDegrees(mapped, CsrGraph(source));
+
+        MatchSet expected(4), actual(4);
+        fastGetAllPatterns(source, pattern, hardCheck, expected);
+        fastGetAllPatterns(mapped.getMatrix(), pattern, hardCheck, actual);
+        assert(expected.getSize() == actual.getSize());
+        for (long long i = 0; i < expected.getSize(); i++)
+            for (int j = 0; j < 4; j++)
+                assert(expected[i][j] == actual[i][j]);
+
+        // изменения отображённой матрицы не попадают в файл
+        mapped.getMatrix().set(0, 1, source.get(0, 1) + 1);
+        MappedGraph reopened(path);
+        assert(areEqual(reopened.getMatrix(), source));
+    }
+
+    // симметричная матрица без степеней
+    Matrix symmetric(5);
+    for (int i = 0; i < 5; i++)
+        for (int j = i; j < 5; j++) {
+            symmetric.set(i, j, i + j);
+            symmetric.set(j, i, i + j);
+        }
+    writeBinaryMatrix(path, symmetric, false);
+    MappedGraph mapped(path);
+    assert(mapped.isSymmetric() && !mapped.hasDegrees());
+    assert(areEqual(mapped.getMatrix(), symmetric));
+
+    std::remove(path.c_str());
+}
+
+/**
+ * Проверка разреженной раскладки: отображённый граф совпадает с исходным
+ * и ищется без копирования теми же результатами
+ *
+ * @param testCnt   кол-во тестов
+ * @param hardCheck флаг, нужна ли жёсткая сверка
+ */
+void checkSparse(int testCnt, bool hardCheck) {
+    const std::string path = "binaryIOTest_sparse.bin";
+    for (int test = 0; test < testCnt; test++) {
+        GraphGenerator generator(std::rand());
+        CsrGraph graph = generator.erdosRenyiSparse(2000, 0.003, 3);
+        Matrix pattern = generator.uniformMatrix(3, 1, 4, 0.7);
+        writeBinaryGraph(path, graph);
+
+        MappedGraph mapped(path);
+        assert(!mapped.isDense() && mapped.getSize() == graph.getSize());
+        const CsrGraph &view = mapped.getGraph();
+        assert(!view.isOwner() && view.getEdgeCount() == graph.getEdgeCount());
+        for (int i = 0; i < graph.getSize(); i++) {
+            assert(view.getLoop(i) == graph.getLoop(i));
+            assert(view.getOutDegree(i) == graph.getOutDegree(i) && view.getInDegree(i) == graph.getInDegree(i));
+            for (int k = 0; k < graph.getOutDegree(i); k++)
+                assert(view.getOutTargets(i)[k] == graph.getOutTargets(i)[k] &&
+                       view.getOutValues(i)[k] == graph.getOutValues(i)[k]);
+            for (int k = 0; k < graph.getInDegree(i); k++)
+                assert(view.getInSources(i)[k] == graph.getInSources(i)[k] &&
+                       view.getInValues(i)[k] == graph.getInValues(i)[k]);
+        }
+        checkDegrees(mapped, graph);
+        assert(sparseCountAllPatterns(view, pattern, hardCheck) == sparseCountAllPatterns(graph, pattern, hardCheck));
+
+        // копия представления - тоже представление, копия владеющего графа владеет своими массивами
+        CsrGraph viewCopy(view);
+        assert(!viewCopy.isOwner() && viewCopy.getOutTargets(0) == view.getOutTargets(0));
+        CsrGraph ownCopy(graph);
+        assert(ownCopy.isOwner() && ownCopy.getEdgeCount() == graph.getEdgeCount());
+        assert(graph.getEdgeCount() == 0 || ownCopy.getOutTargets(0) != graph.getOutTargets(0));
+        CsrGraph moved(std::move(ownCopy));
+        assert(moved.getEdgeCount() == graph.getEdgeCount() && ownCopy.getEdgeCount() == 0);
+        moved = viewCopy;
+        assert(!moved.isOwner() && areEqual(moved.toMatrix(), graph.toMatrix()));
+    }
+
+    // симметричный граф
+    std::vector<CsrGraph::Edge> edges = {{0, 1, 2}, {1, 0, 2}, {1, 2, 5}, {2, 1, 5}, {2, 2, 7}};
+    writeBinaryGraph(path, CsrGraph(3, edges));
+    MappedGraph mapped(path);
+    assert(mapped.isSymmetric() && mapped.getGraph().getLoop(2) == 7);
+    assert(areEqual(mapped.getGraph().toMatrix(), CsrGraph(3, edges).toMatrix()));
+
+    std::remove(path.c_str());
+}
+
+/**
+ * Проверка отказа открывать повреждённые и чужие файлы
+ */
+void checkCorrupted() {
+    const std::string path = "binaryIOTest_corrupted.bin";
+    Matrix source(randomMatrix(30, 1, 4, 0.5), 30);
+    writeBinaryMatrix(path, source);
+
+    // усечённый файл
+    std::ifstream in(path, std::ios::binary);
+    std::string bytes((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+    in.close();
+    std::ofstream(path, std::ios::binary).write(bytes.data(), (std::streamsize) bytes.size() - 64);
+    checkRejected(path);
+
+    // неизвестная версия
+    std::string wrongVersion = bytes;
+    wrongVersion[8] = 9;
+    std::ofstream(path, std::ios::binary).write(wrongVersion.data(), (std::streamsize) wrongVersion.size());
+    checkRejected(path);
+
+    // текстовый файл
+    std::ofstream text(path);
+    writeMatrix(text, source);
+    text.close();
+    assert(!isBinaryGraphFile(path));
+    checkRejected(path);
+
+    std::remove(path.c_str());
+    assert(!isBinaryGraphFile(path));
+    checkRejected(path);
+}
+
+/**
+ * Главный метод
+ * @return код возрата
+ */
+int main() {
+    long ltime = time(nullptr);
+    int stime = (unsigned int) ltime / 2;
+    srand(stime);
+
+    std::cout << "TEST 1:" << std::endl;
+    checkDense(5, 50, true);
+    std::cout << "TEST 2:" << std::endl;
+    checkDense(5, 50, false);
+    std::cout << "TEST 3:" << std::endl;
+    checkSparse(3, true);
+    std::cout << "TEST 4:" << std::endl;
+    checkCorrupted();
+}
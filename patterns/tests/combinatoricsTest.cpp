@@ -1,5 +1,7 @@
 #include <cassert>
 #include <ctime>
+#include <limits>
+#include <vector>
 #include "misc/combinatorics.h"
 
 /**
@@ -16,6 +18,44 @@ bool areEqual(const int *arr1, const int *arr2, int sz) {
     return true;
 }
 
+/**
+ * Проверка номеров комбинаций и перебора части комбинаций
+ *
+ * @param n общее число элементов
+ * @param k размер комбинации
+ */
+void checkRanks(int n, int k) {
+    // все комбинации в порядке `combine()`
+    std::vector<std::vector<int>> all;
+    combine(n, k, [&all, &k](const int *c) {
+        all.emplace_back(c, c + k);
+    });
+    assert((long long) all.size() == binomial(n, k));
+
+    std::vector<int> c(k);
+    for (long long rank = 0; rank < (long long) all.size(); rank++) {
+        // номер комбинации совпадает с её местом в переборе
+        assert(rankCombination(all[rank].data(), n, k) == rank);
+        unrankCombination(rank, n, k, c.data());
+        assert(c == all[rank]);
+        // следующая комбинация - следующая в переборе
+        bool hasNext = nextCombination(c.data(), n, k);
+        assert(hasNext == (rank + 1 < (long long) all.size()));
+        if (hasNext)
+            assert(c == all[rank + 1]);
+    }
+
+    // перебор части совпадает с соответствующим участком полного перебора
+    long long from = std::abs(rand()) % (all.size() + 1);
+    long long to = from + std::abs(rand()) % (all.size() - from + 1);
+    long long rank = from;
+    combineRange(n, k, from, to, [&all, &rank, &k](const int *c) {
+        assert(std::vector<int>(c, c + k) == all[rank]);
+        rank++;
+    });
+    assert(rank == to);
+}
+
 /**
  * Главный метод
  * @return код возрата
@@ -32,4 +72,30 @@ int main() {
         int *rr = getReversePermutation(p, sz);
         assert(areEqual(r, rr, sz));
     }
-}
\ No newline at end of file
+
+    // биномиальные коэффициенты
+    assert(binomial(5, 2) == 10);
+    assert(binomial(5, 6) == 0);
+    assert(binomial(0, 0) == 1);
+    assert(binomial(62, 31) == 465428353255261088LL);
+    assert(binomial(66, 33) == 7219428434016265740LL);
+    bool overflow = false;
+    try {
+        binomial(67, 33);
+    } catch (const std::overflow_error &) {
+        overflow = true;
+    }
+    assert(overflow);
+
+    // номера комбинаций
+    for (int n = 0; n <= 9; n++)
+        for (int k = 0; k <= n; k++)
+            checkRanks(n, k);
+
+    // номера комбинаций, близкие к пределу `long long`
+    std::vector<int> c(33);
+    unrankCombination(binomial(66, 33) - 1, 66, 33, c.data());
+    for (int i = 0; i < 33; i++)
+        assert(c[i] == 33 + i);
+    assert(rankCombination(c.data(), 66, 33) == binomial(66, 33) - 1);
+}
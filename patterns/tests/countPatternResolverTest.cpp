@@ -0,0 +1,70 @@
+#include <cassert>
+#include <ctime>
+#include <iostream>
+#include "misc/combinatorics.h"
+#include "misc/Matrix.h"
+#include "misc/PatternBuilder.h"
+#include "patternResolver.h"
+#include "fastPatternResolver.h"
+
+/**
+ * Сверка подсчёта изоморфных подграфов с кол-вом найденных комбинаций
+ *
+ * @param testCnt     кол-во тестов
+ * @param minS        минимальный размер матрицы-источника
+ * @param maxS        максимальный размер матрицы-источника
+ * @param minP        минимальный размер матрицы-паттерна
+ * @param maxP        максимальный размер матрицы-паттерна
+ * @param minE        минимальное значение элементов матриц
+ * @param maxE        максимальный значение элементов матриц
+ * @param nonZeroPart доля ненулевых элементов
+ * @param hardCheck   флаг, нужна ли жёсткая сверка
+ * @param bruteForce  флаг, нужно ли сверять с полным перебором
+ */
+void compare(
+        int testCnt, int minS, int maxS, int minP, int maxP, int minE, int maxE, double nonZeroPart,
+        bool hardCheck, bool bruteForce
+) {
+    for (int i = 0; i < testCnt; i++) {
+        int sourceSize = std::abs(std::rand()) % (maxS - minS) + minS;
+        int patternSize = std::abs(std::rand()) % (maxP - minP) + minP;
+        // формируем случайные матрицы
+        Matrix source(randomMatrix(sourceSize, minE, maxE, nonZeroPart), sourceSize);
+        Matrix pattern(randomMatrix(patternSize, minE, maxE, nonZeroPart), patternSize);
+
+        // добавляем в дата-граф несколько паттернов
+        PatternBuilder pb(source);
+        for (int j = 0; j < 3;)
+            if (pb.putPattern(pattern.toArray(), patternSize, getRandomCombination(sourceSize, patternSize)))
+                j++;
+
+        long long expected = (long long) fastGetAllPatterns(source, pattern, hardCheck).size();
+        assert(fastCountAllPatterns(source, pattern, hardCheck) == expected);
+        for (int threadCount = 1; threadCount <= 8; threadCount *= 2)
+            assert(fastCountAllPatterns(source, pattern, hardCheck, threadCount) == expected);
+
+        if (bruteForce) {
+            assert((long long) getAllPatterns(source, pattern, hardCheck).size() == expected);
+            assert(countAllPatterns(source, pattern, hardCheck) == expected);
+        }
+    }
+}
+
+/**
+ * Главный метод
+ * @return код возрата
+ */
+int main() {
+    long ltime = time(nullptr);
+    int stime = (unsigned int) ltime / 2;
+    srand(stime);
+
+    std::cout << "TEST 1:" << std::endl;
+    compare(10, 10, 14, 2, 4, 0, 2, 0.5, true, true);
+    std::cout << "TEST 2:" << std::endl;
+    compare(10, 10, 14, 2, 4, -1, 1, 0.3, false, true);
+    std::cout << "TEST 3:" << std::endl;
+    compare(10, 60, 80, 3, 5, 1, 3, 0.2, false, false);
+    std::cout << "TEST 4:" << std::endl;
+    compare(10, 100, 130, 2, 4, 1, 2, 0.3, true, false);
+}
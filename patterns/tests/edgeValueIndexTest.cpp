@@ -0,0 +1,125 @@
+#include <cassert>
+#include <ctime>
+#include <iostream>
+#include <unordered_set>
+#include "misc/combinatorics.h"
+#include "misc/EdgeValueIndex.h"
+#include "misc/Matrix.h"
+#include "misc/PatternBuilder.h"
+#include "fastPatternResolver.h"
+
+/**
+ * Проверка, что индекс содержит ровно все недиагональные ненулевые элементы матрицы
+ *
+ * @param source матрица
+ * @param index  индекс значений рёбер
+ */
+void checkIndex(const Matrix &source, const EdgeValueIndex &index) {
+    long long total = 0;
+    std::unordered_set<int> values;
+    for (int i = 0; i < source.getSize(); i++)
+        for (int j = 0; j < source.getSize(); j++) {
+            int value = source.get(i, j);
+            if (i == j || value == 0)
+                continue;
+            total++;
+            values.insert(value);
+            // позиция лежит в группе своего значения
+            bool found = false;
+            const EdgeValueIndex::Position *positions = index.getPositions(value);
+            for (long long k = 0; k < index.getCount(value) && !found; k++)
+                found = positions[k].row == i && positions[k].col == j;
+            assert(found);
+        }
+
+    // других позиций в индексе нет
+    long long indexed = 0;
+    for (int value: values) {
+        const EdgeValueIndex::Position *positions = index.getPositions(value);
+        for (long long k = 0; k < index.getCount(value); k++)
+            assert(source.get(positions[k].row, positions[k].col) == value);
+        indexed += index.getCount(value);
+    }
+    assert(index.getValuesCount() == (int) values.size());
+    assert(index.getCount(0) == 0);
+    assert(indexed == total);
+}
+
+/**
+ * Сверка поиска с позиций самого редкого ребра с обычным быстрым поиском
+ *
+ * @param testCnt     кол-во тестов
+ * @param minS        минимальный размер матрицы-источника
+ * @param maxS        максимальный размер матрицы-источника
+ * @param minP        минимальный размер матрицы-паттерна
+ * @param maxP        максимальный размер матрицы-паттерна
+ * @param minE        минимальное значение элементов матриц
+ * @param maxE        максимальный значение элементов матриц
+ * @param nonZeroPart доля ненулевых элементов
+ * @param hardCheck   флаг, нужна ли жёсткая сверка
+ */
+void compare(
+        int testCnt, int minS, int maxS, int minP, int maxP, int minE, int maxE, double nonZeroPart,
+        bool hardCheck
+) {
+    for (int i = 0; i < testCnt; i++) {
+        int sourceSize = std::abs(std::rand()) % (maxS - minS) + minS;
+        int patternSize = std::abs(std::rand()) % (maxP - minP) + minP;
+        // формируем случайные матрицы
+        Matrix source(randomMatrix(sourceSize, minE, maxE, nonZeroPart), sourceSize);
+        Matrix pattern(randomMatrix(patternSize, minE, maxE, nonZeroPart), patternSize);
+
+        // добавляем в дата-граф несколько паттернов
+        PatternBuilder pb(source);
+        for (int j = 0; j < 5;)
+            if (pb.putPattern(pattern.toArray(), patternSize, getRandomCombination(sourceSize, patternSize)))
+                j++;
+
+        EdgeValueIndex index(source);
+        checkIndex(source, index);
+        // индекс по разреженному графу совпадает с индексом по матрице
+        checkIndex(source, EdgeValueIndex(CsrGraph(source)));
+
+        std::vector<CombinatoricsData> expected = fastGetAllPatterns(source, pattern, hardCheck);
+        std::unordered_set<CombinatoricsData, CombinatoricsData::HashFunction>
+                expectedSet(expected.begin(), expected.end());
+
+        std::vector<CombinatoricsData> seeded = fastGetAllPatterns(source, pattern, hardCheck, index);
+        std::unordered_set<CombinatoricsData, CombinatoricsData::HashFunction>
+                seededSet(seeded.begin(), seeded.end());
+        assert(seeded.size() == expected.size());
+        assert(seededSet == expectedSet);
+        assert(fastCountAllPatterns(source, pattern, hardCheck, index) == (long long) expected.size());
+
+        // параллельный перебор раздаёт потокам позиции ребра
+        FastPatternSearch search(source, pattern, hardCheck, index);
+        assert(search.countParallel(4) == (long long) expected.size());
+        // каждое вхождение содержит ребро, с которого начинается перебор
+        if (search.isSeeded() && !expected.empty())
+            assert(search.getSeedsCount() > 0);
+    }
+}
+
+/**
+ * Главный метод
+ * @return код возрата
+ */
+int main() {
+    long ltime = time(nullptr);
+    int stime = (unsigned int) ltime / 2;
+    srand(stime);
+
+    std::cout << "TEST 1:" << std::endl;
+    compare(10, 30, 40, 3, 5, -20, 20, 0.5, true);
+    std::cout << "TEST 2:" << std::endl;
+    compare(10, 30, 40, 3, 5, -2, 2, 0.3, false);
+    std::cout << "TEST 3:" << std::endl;
+    compare(10, 60, 80, 2, 4, 0, 2, 0.2, true);
+
+    // у паттерна без рёбер поиск начинается с вершин первой точки
+    Matrix source(randomMatrix(20, 0, 3, 0.5), 20);
+    Matrix empty(3);
+    FastPatternSearch search(source, empty, false, EdgeValueIndex(source));
+    assert(!search.isSeeded());
+    assert(search.count() == fastCountAllPatterns(source, empty, false));
+}
@@ -0,0 +1,156 @@
+#include <algorithm>
+#include <cassert>
+#include <ctime>
+#include <iostream>
+#include <mutex>
+#include "misc/combinatorics.h"
+#include "misc/EdgeValueIndex.h"
+#include "misc/GraphGenerator.h"
+#include "misc/Matrix.h"
+#include "misc/PatternBuilder.h"
+#include "FastPatternSearch.h"
+
+/**
+ * Найти все комбинации поиска в одном потоке
+ *
+ * @param search поиск
+ * @return комбинации в порядке перебора
+ */
+std::vector<std::vector<int>> runAll(const FastPatternSearch &search) {
+    int patternSize = search.getPatternSize();
+    std::vector<std::vector<int>> res;
+    search.run([&res, &patternSize](int *c) {
+        res.emplace_back(c, c + patternSize);
+        return true;
+    });
+    return res;
+}
+
+/**
+ * Найти все комбинации поиска в несколько потоков
+ *
+ * @param search      поиск
+ * @param threadCount кол-во потоков
+ * @return отсортированные комбинации
+ */
+std::vector<std::vector<int>> runAllParallel(const FastPatternSearch &search, int threadCount) {
+    int patternSize = search.getPatternSize();
+    std::vector<std::vector<int>> res;
+    std::mutex mutex;
+    search.runParallel(threadCount, [&res, &mutex, &patternSize](int, int *c) {
+        std::lock_guard<std::mutex> lock(mutex);
+        res.emplace_back(c, c + patternSize);
+        return true;
+    });
+    std::sort(res.begin(), res.end());
+    return res;
+}
+
+/**
+ * Сверить специализированное ядро поиска с общим перебором
+ *
+ * @param generic     поиск общим перебором
+ * @param specialized тот же поиск ядрами, собранными под размер паттерна
+ */
+void compareSearches(const FastPatternSearch &generic, const FastPatternSearch &specialized) {
+    // в одном потоке порядок комбинаций тот же
+    std::vector<std::vector<int>> expected = runAll(generic);
+    assert(runAll(specialized) == expected);
+    assert(specialized.count() == (long long) expected.size());
+
+    std::sort(expected.begin(), expected.end());
+    for (int threadCount = 2; threadCount <= 4; threadCount *= 2) {
+        assert(runAllParallel(specialized, threadCount) == expected);
+        assert(specialized.countParallel(threadCount) == (long long) expected.size());
+    }
+
+    // остановка по запросу обработчика
+    long long limit = std::min((long long) expected.size(), 3LL), found = 0;
+    bool finished = specialized.run([&found, &limit](int *) {
+        return ++found < limit;
+    });
+    assert(found == limit && finished == (limit == 0));
+
+    // продолжение с префикса из одной вершины
+    if (specialized.getPatternSize() > 0 && !expected.empty()) {
+        std::vector<int> prefix{expected[0][specialized.getOrder()[0]]};
+        long long fromPrefix = 0, genericFromPrefix = 0;
+        specialized.runPrefix(prefix, [&fromPrefix](int *) {
+            fromPrefix++;
+            return true;
+        });
+        generic.runPrefix(prefix, [&genericFromPrefix](int *) {
+            genericFromPrefix++;
+            return true;
+        });
+        assert(fromPrefix == genericFromPrefix && fromPrefix > 0);
+    }
+}
+
+/**
+ * Сверка ядер поиска, собранных под размер паттерна, с общим перебором
+ *
+ * @param testCnt     кол-во тестов на каждый размер паттерна
+ * @param sourceSize  размер дата-графа
+ * @param minP        минимальный размер матрицы-паттерна
+ * @param maxP        максимальный размер матрицы-паттерна
+ * @param minE        минимальное значение элементов матриц
+ * @param maxE        максимальный значение элементов матриц
+ * @param nonZeroPart доля ненулевых элементов
+ * @param hardCheck   флаг, нужна ли жёсткая сверка
+ */
+void compare(
+        int testCnt, int sourceSize, int minP, int maxP, int minE, int maxE, double nonZeroPart, bool hardCheck
+) {
+    for (int patternSize = minP; patternSize <= maxP; patternSize++)
+        for (int i = 0; i < testCnt; i++) {
+            GraphGenerator generator(std::rand());
+            // формируем случайные матрицы
+            Matrix source = generator.uniformMatrix(sourceSize, minE, maxE, nonZeroPart);
+            Matrix pattern = generator.uniformMatrix(patternSize, minE, maxE, nonZeroPart);
+
+            // добавляем в дата-граф несколько паттернов
+            PatternBuilder pb(source);
+            pb.plantPatterns(pattern, 5, generator);
+
+            FastPatternSearch generic(source, pattern, hardCheck);
+            generic.setSpecialized(false);
+            FastPatternSearch specialized(source, pattern, hardCheck);
+            assert(!generic.isSpecialized());
+            assert(specialized.isSpecialized() == (patternSize >= 3 && patternSize <= 8));
+            compareSearches(generic, specialized);
+
+            // перебор с позиций самого редкого ребра
+            EdgeValueIndex index(source);
+            FastPatternSearch genericSeeded(source, pattern, hardCheck, index);
+            genericSeeded.setSpecialized(false);
+            compareSearches(genericSeeded, FastPatternSearch(source, pattern, hardCheck, index));
+
+            // ограничения порядка
+            if (patternSize >= 2) {
+                std::vector<std::pair<int, int>> lessConstraints{{0, 1}, {patternSize - 1, 0}};
+                if (patternSize == 2)
+                    lessConstraints.pop_back();
+                FastPatternSearch genericLess(source, pattern, hardCheck, lessConstraints);
+                genericLess.setSpecialized(false);
+                compareSearches(genericLess, FastPatternSearch(source, pattern, hardCheck, lessConstraints));
+            }
+        }
+}
+
+/**
+ * Главный метод
+ * @return код возрата
+ */
+int main() {
+    long ltime = time(nullptr);
+    int stime = (unsigned int) ltime / 2;
+    srand(stime);
+
+    std::cout << "TEST 1:" << std::endl;
+    compare(3, 40, 1, 10, 1, 3, 0.4, true);
+    std::cout << "TEST 2:" << std::endl;
+    compare(3, 20, 1, 10, 1, 3, 0.5, false);
+    std::cout << "TEST 3:" << std::endl;
+    compare(2, 100, 3, 8, 1, 3, 0.5, true);
+}
@@ -68,7 +68,7 @@ void compare(
         std::vector<CombinatoricsData> fastPatternsList =
                 fastGetAllPatterns(res, sourceSize, pattern, patternSize, hardCheck);
         std::unordered_set<CombinatoricsData, CombinatoricsData::HashFunction>
-                fastPatterns(patternsList.begin(), patternsList.end());
+                fastPatterns(fastPatternsList.begin(), fastPatternsList.end());
         //   std::cout << "got fast pattern list" << std::endl;
 
 
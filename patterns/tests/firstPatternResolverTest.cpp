@@ -0,0 +1,73 @@
+#include <cassert>
+#include <ctime>
+#include <iostream>
+#include "misc/combinatorics.h"
+#include "misc/Matrix.h"
+#include "misc/PatternBuilder.h"
+#include "fastPatternResolver.h"
+
+/**
+ * Сверка поиска первых вхождений с полным быстрым поиском
+ *
+ * @param testCnt     кол-во тестов
+ * @param minS        минимальный размер матрицы-источника
+ * @param maxS        максимальный размер матрицы-источника
+ * @param minP        минимальный размер матрицы-паттерна
+ * @param maxP        максимальный размер матрицы-паттерна
+ * @param minE        минимальное значение элементов матриц
+ * @param maxE        максимальный значение элементов матриц
+ * @param pCnt        кол-во добавленных паттернов
+ * @param nonZeroPart доля ненулевых элементов
+ * @param hardCheck   флаг, нужна ли жёсткая сверка
+ */
+void compare(
+        int testCnt, int minS, int maxS, int minP, int maxP, int minE, int maxE, int pCnt, double nonZeroPart,
+        bool hardCheck
+) {
+    for (int i = 0; i < testCnt; i++) {
+        int sourceSize = std::abs(std::rand()) % (maxS - minS) + minS;
+        int patternSize = std::abs(std::rand()) % (maxP - minP) + minP;
+        // формируем случайные матрицы
+        Matrix source(randomMatrix(sourceSize, minE, maxE, nonZeroPart), sourceSize);
+        Matrix pattern(randomMatrix(patternSize, minE, maxE, nonZeroPart), patternSize);
+
+        // добавляем в дата-граф несколько паттернов
+        PatternBuilder pb(source);
+        for (int j = 0; j < pCnt;)
+            if (pb.putPattern(pattern.toArray(), patternSize, getRandomCombination(sourceSize, patternSize)))
+                j++;
+
+        std::vector<CombinatoricsData> all = fastGetAllPatterns(source, pattern, hardCheck);
+        std::unordered_set<CombinatoricsData, CombinatoricsData::HashFunction> allSet(all.begin(), all.end());
+
+        assert(fastContainsPattern(source, pattern, hardCheck) == !all.empty());
+
+        for (long long k = 0; k <= (long long) all.size() + 1; k = k * 2 + 1) {
+            std::vector<CombinatoricsData> first = fastFindFirstPatterns(source, pattern, hardCheck, k);
+            // найдено ровно min(k, всего) различных вхождений
+            std::unordered_set<CombinatoricsData, CombinatoricsData::HashFunction>
+                    firstSet(first.begin(), first.end());
+            assert((long long) first.size() == std::min(k, (long long) all.size()));
+            assert(firstSet.size() == first.size());
+            for (const CombinatoricsData &cd: first)
+                assert(allSet.find(cd) != allSet.end());
+        }
+    }
+}
+
+/**
+ * Главный метод
+ * @return код возрата
+ */
+int main() {
+    long ltime = time(nullptr);
+    int stime = (unsigned int) ltime / 2;
+    srand(stime);
+
+    std::cout << "TEST 1:" << std::endl;
+    compare(10, 30, 40, 3, 5, 0, 3, 5, 0.5, true);
+    std::cout << "TEST 2:" << std::endl;
+    compare(10, 30, 40, 3, 5, -2, 2, 5, 0.3, false);
+    std::cout << "TEST 3:" << std::endl;
+    compare(10, 60, 80, 4, 6, 1, 9, 0, 0.9, true);
+}
@@ -0,0 +1,191 @@
+#include <cassert>
+#include <cmath>
+#include <ctime>
+#include <iostream>
+#include <unordered_set>
+#include "misc/combinatorics.h"
+#include "misc/CsrGraph.h"
+#include "misc/GraphGenerator.h"
+#include "misc/Matrix.h"
+
+/**
+ * Проверка, что два разреженных графа совпадают
+ *
+ * @param a первый граф
+ * @param b второй граф
+ */
+void checkEqual(const CsrGraph &a, const CsrGraph &b) {
+    assert(a.getSize() == b.getSize());
+    assert(a.getEdgeCount() == b.getEdgeCount());
+    for (int i = 0; i < a.getSize(); i++) {
+        assert(a.getOutDegree(i) == b.getOutDegree(i));
+        for (int k = 0; k < a.getOutDegree(i); k++) {
+            assert(a.getOutTargets(i)[k] == b.getOutTargets(i)[k]);
+            assert(a.getOutValues(i)[k] == b.getOutValues(i)[k]);
+        }
+    }
+}
+
+/**
+ * Проверка, что у графа нет петель, а значения рёбер лежат в `[1, valueRange]`
+ *
+ * @param graph      граф
+ * @param valueRange кол-во различных значений рёбер
+ */
+void checkValues(const CsrGraph &graph, int valueRange) {
+    for (int i = 0; i < graph.getSize(); i++) {
+        assert(graph.getLoop(i) == 0);
+        for (int k = 0; k < graph.getOutDegree(i); k++)
+            assert(graph.getOutValues(i)[k] >= 1 && graph.getOutValues(i)[k] <= valueRange);
+    }
+}
+
+/**
+ * Проверка случайных перестановок и комбинаций
+ */
+void checkSampling() {
+    GraphGenerator generator(1);
+    for (int n = 0; n < 50; n++) {
+        // перестановка содержит каждое число ровно один раз
+        std::vector<int> p = generator.permutation(n);
+        std::vector<bool> used(n, false);
+        for (int e: p) {
+            assert(e >= 0 && e < n && !used[e]);
+            used[e] = true;
+        }
+
+        // комбинация возрастает и лежит в диапазоне
+        for (int k = 0; k <= n; k++) {
+            std::vector<int> c = generator.combination(n, k);
+            assert((int) c.size() == k);
+            for (int i = 0; i < k; i++)
+                assert(c[i] >= 0 && c[i] < n && (i == 0 || c[i - 1] < c[i]));
+        }
+
+        // старые функции тоже возвращают перестановки и различные элементы
+        if (n > 0) {
+            int *rp = getRandomPermutation(n);
+            std::unordered_set<int> values(rp, rp + n);
+            assert((int) values.size() == n && *values.begin() >= 0);
+            delete[] rp;
+            CombinatoricsData rc = getRandomCombination(n, n / 2);
+            std::unordered_set<int> elements(rc.getData(), rc.getData() + rc.getSize());
+            assert((int) elements.size() == n / 2);
+            for (int e: elements)
+                assert(e >= 0 && e < n);
+        }
+    }
+
+    // все комбинации из 5 по 2 выпадают примерно одинаково часто
+    std::vector<int> hits(25, 0);
+    for (int i = 0; i < 10000; i++) {
+        std::vector<int> c = generator.combination(5, 2);
+        hits[c[0] * 5 + c[1]]++;
+    }
+    for (int a = 0; a < 5; a++)
+        for (int b = a + 1; b < 5; b++)
+            assert(hits[a * 5 + b] > 800 && hits[a * 5 + b] < 1200);
+
+    // невыбранные элементы случайной матрицы нулевые
+    int **zero = randomMatrix(20, 1, 5, 0);
+    for (int i = 0; i < 20; i++) {
+        for (int j = 0; j < 20; j++)
+            assert(zero[i][j] == 0);
+        delete[] zero[i];
+    }
+    delete[] zero;
+}
+
+/**
+ * Проверка воспроизводимости: результат зависит только от зерна и не зависит от кол-ва потоков
+ */
+void checkReproducibility() {
+    GraphGenerator a(42, 1), b(42, 4), other(43, 4);
+
+    Matrix ma = a.uniformMatrix(100, -3, 4, 0.3);
+    Matrix mb = b.uniformMatrix(100, -3, 4, 0.3);
+    assert(areEqual(ma, mb));
+    assert(!areEqual(ma, other.uniformMatrix(100, -3, 4, 0.3)));
+    for (int i = 0; i < 100; i++)
+        for (int j = 0; j < 100; j++)
+            assert(ma.get(i, j) >= -3 && ma.get(i, j) < 4);
+
+    checkEqual(a.erdosRenyiSparse(1000, 0.01, 5), b.erdosRenyiSparse(1000, 0.01, 5));
+    checkEqual(a.barabasiAlbertSparse(1000, 3, 5), b.barabasiAlbertSparse(1000, 3, 5));
+    checkEqual(
+            a.rmatSparse(1000, 200000, 0.57, 0.19, 0.19, 5),
+            b.rmatSparse(1000, 200000, 0.57, 0.19, 0.19, 5)
+    );
+
+    // плотная и разреженная формы генераторов с одинаковым зерном задают один граф
+    GraphGenerator denseGenerator(7, 3), sparseGenerator(7, 2);
+    assert(areEqual(denseGenerator.erdosRenyi(300, 0.05, 3), sparseGenerator.erdosRenyiSparse(300, 0.05, 3).toMatrix()));
+    assert(areEqual(denseGenerator.barabasiAlbert(300, 2, 3),
+                    sparseGenerator.barabasiAlbertSparse(300, 2, 3).toMatrix()));
+    assert(areEqual(denseGenerator.rmat(300, 5000, 0.45, 0.15, 0.15, 3),
+                    sparseGenerator.rmatSparse(300, 5000, 0.45, 0.15, 0.15, 3).toMatrix()));
+}
+
+/**
+ * Проверка свойств моделей
+ */
+void checkModels() {
+    GraphGenerator generator((uint64_t) time(nullptr), 4);
+
+    // кол-во рёбер графа Эрдёша-Реньи близко к ожидаемому
+    int n = 200000;
+    double p = 0.00005;
+    CsrGraph er = generator.erdosRenyiSparse(n, p, 4);
+    checkValues(er, 4);
+    double expected = p * n * (n - 1.0);
+    assert(std::fabs((double) er.getEdgeCount() - expected) < 6 * std::sqrt(expected));
+    // крайние вероятности
+    assert(generator.erdosRenyiSparse(50, 0, 1).getEdgeCount() == 0);
+    assert(generator.erdosRenyiSparse(50, 1, 1).getEdgeCount() == 50 * 49);
+
+    // у каждой новой вершины графа Барабаши-Альберт ровно m исходящих рёбер
+    int m = 4;
+    CsrGraph ba = generator.barabasiAlbertSparse(100000, m, 3);
+    checkValues(ba, 3);
+    assert(ba.getEdgeCount() == (long long) (100000 - m) * m);
+    int maxIn = 0;
+    for (int i = 0; i < ba.getSize(); i++) {
+        assert(ba.getOutDegree(i) == (i < m ? 0 : m));
+        maxIn = std::max(maxIn, ba.getInDegree(i));
+    }
+    // степени распределены с тяжёлым хвостом: самые старые вершины собирают сотни рёбер
+    assert(maxIn > 100);
+
+    // рёбер R-MAT не больше запрошенного, повторов и петель нет
+    CsrGraph rmat = generator.rmatSparse(100000, 500000, 0.57, 0.19, 0.19, 2);
+    checkValues(rmat, 2);
+    assert(rmat.getEdgeCount() <= 500000 && rmat.getEdgeCount() > 400000);
+    // вершины с маленькими номерами получают больше рёбер
+    assert(rmat.getOutDegree(0) > rmat.getEdgeCount() / rmat.getSize());
+
+    // неверные параметры
+    bool thrown = false;
+    try {
+        generator.barabasiAlbertSparse(5, 5, 1);
+    } catch (const std::invalid_argument &) {
+        thrown = true;
+    }
+    assert(thrown);
+}
+
+/**
+ * Главный метод
+ * @return код возрата
+ */
+int main() {
+    long ltime = time(nullptr);
+    int stime = (unsigned int) ltime / 2;
+    srand(stime);
+
+    std::cout << "TEST 1:" << std::endl;
+    checkSampling();
+    std::cout << "TEST 2:" << std::endl;
+    checkReproducibility();
+    std::cout << "TEST 3:" << std::endl;
+    checkModels();
+}
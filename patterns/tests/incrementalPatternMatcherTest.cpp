@@ -0,0 +1,100 @@
+#include <cassert>
+#include <ctime>
+#include <iostream>
+#include "misc/combinatorics.h"
+#include "misc/Matrix.h"
+#include "misc/PatternBuilder.h"
+#include "fastPatternResolver.h"
+#include "IncrementalPatternMatcher.h"
+
+/**
+ * Множество комбинаций
+ */
+typedef std::unordered_set<CombinatoricsData, CombinatoricsData::HashFunction> CombinationSet;
+
+/**
+ * Сверка изменений вхождений с полным поиском до и после каждого изменения дата-графа
+ *
+ * @param testCnt     кол-во тестов
+ * @param changesCnt  кол-во изменений дата-графа в каждом тесте
+ * @param minS        минимальный размер матрицы-источника
+ * @param maxS        максимальный размер матрицы-источника
+ * @param minP        минимальный размер матрицы-паттерна
+ * @param maxP        максимальный размер матрицы-паттерна
+ * @param minE        минимальное значение элементов матриц
+ * @param maxE        максимальный значение элементов матриц
+ * @param nonZeroPart доля ненулевых элементов
+ */
+void compare(
+        int testCnt, int changesCnt, int minS, int maxS, int minP, int maxP, int minE, int maxE, double nonZeroPart
+) {
+    for (int i = 0; i < testCnt; i++) {
+        int sourceSize = std::abs(std::rand()) % (maxS - minS) + minS;
+        Matrix source(randomMatrix(sourceSize, minE, maxE, nonZeroPart), sourceSize);
+
+        // два паттерна: с жёсткой и с нежёсткой проверкой
+        std::vector<Matrix> patterns;
+        std::vector<bool> hardChecks = {true, false};
+        PatternBuilder pb(source);
+        for (int k = 0; k < 2; k++) {
+            int patternSize = std::abs(std::rand()) % (maxP - minP) + minP;
+            patterns.emplace_back(randomMatrix(patternSize, minE, maxE, nonZeroPart), patternSize);
+            for (int j = 0; j < 3;)
+                if (pb.putPattern(patterns[k].toArray(), patternSize, getRandomCombination(sourceSize, patternSize)))
+                    j++;
+        }
+
+        IncrementalPatternMatcher matcher{DynamicGraph(source)};
+        std::vector<CombinationSet> current;
+        for (int k = 0; k < 2; k++) {
+            int patternId = matcher.addPattern(patterns[k], hardChecks[k]);
+            assert(patternId == k);
+            std::vector<CombinatoricsData> all = fastGetAllPatterns(source, patterns[k], hardChecks[k]);
+            current.emplace_back(all.begin(), all.end());
+        }
+
+        for (int change = 0; change < changesCnt; change++) {
+            int from = std::rand() % sourceSize;
+            int to = std::rand() % sourceSize;
+            // чаще меняем элемент на значение из того же диапазона, иногда удаляем ребро
+            int value = std::rand() % 3 == 0 ? 0 : std::rand() % (maxE - minE + 1) + minE;
+
+            // применяем изменения вхождений к текущим множествам
+            for (const IncrementalPatternMatcher::MatchDelta &delta: matcher.setEdge(from, to, value)) {
+                CombinationSet &set = current[delta.patternId];
+                if (delta.gained) {
+                    bool inserted = set.insert(delta.combination).second;
+                    assert(inserted);
+                } else {
+                    size_t erased = set.erase(delta.combination);
+                    assert(erased == 1);
+                }
+            }
+            source.set(from, to, value);
+
+            // результат совпадает с полным поиском в изменённом графе
+            assert(areEqual(matcher.getGraph().toMatrix(), source));
+            for (int k = 0; k < 2; k++) {
+                std::vector<CombinatoricsData> all = fastGetAllPatterns(source, patterns[k], hardChecks[k]);
+                assert(CombinationSet(all.begin(), all.end()) == current[k]);
+            }
+        }
+    }
+}
+
+/**
+ * Главный метод
+ * @return код возрата
+ */
+int main() {
+    long ltime = time(nullptr);
+    int stime = (unsigned int) ltime / 2;
+    srand(stime);
+
+    std::cout << "TEST 1:" << std::endl;
+    compare(5, 50, 15, 25, 2, 5, 0, 2, 0.5);
+    std::cout << "TEST 2:" << std::endl;
+    compare(5, 50, 15, 25, 2, 5, -1, 1, 0.3);
+    std::cout << "TEST 3:" << std::endl;
+    compare(5, 50, 30, 40, 3, 5, 1, 2, 0.2);
+}
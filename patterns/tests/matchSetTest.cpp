@@ -0,0 +1,132 @@
+#include <cassert>
+#include <ctime>
+#include <iostream>
+#include "misc/combinatorics.h"
+#include "misc/Matrix.h"
+#include "misc/MatchSet.h"
+#include "misc/PatternBuilder.h"
+#include "patternResolver.h"
+#include "fastPatternResolver.h"
+
+/**
+ * Проверка хранения комбинаций в множестве и владения памятью
+ */
+void checkStorage() {
+    MatchSet matches(3);
+    matches.reserve(100);
+    for (int i = 0; i < 100; i++) {
+        int c[3] = {i, i + 1, i + 2};
+        matches.add(c);
+    }
+    assert(matches.getSize() == 100);
+    assert(matches[42][0] == 42 && matches[42][2] == 44);
+
+    // комбинации лежат подряд в одном буфере
+    for (int i = 0; i < 300; i++)
+        assert(matches.getData()[i] == i / 3 + i % 3);
+
+    // при перемещении буфер переходит к новому множеству
+    const int *data = matches.getData();
+    MatchSet moved(std::move(matches));
+    assert(moved.getData() == data);
+    assert(moved.getSize() == 100);
+    assert(matches.isEmpty());
+
+    long long index = 0;
+    for (IntSpan c: moved) {
+        assert(c.size() == 3 && c[1] == index + 1);
+        index++;
+    }
+    assert(index == 100);
+
+    // комбинации нулевого размера тоже считаются
+    MatchSet empty(0);
+    empty.add(IntSpan(nullptr, 0));
+    assert(empty.getSize() == 1);
+
+    // копия последовательности владеет своей памятью
+    int arr[2] = {1, 2};
+    CombinatoricsData cd(arr, 2);
+    CombinatoricsData copy = cd;
+    copy.getData()[0] = 5;
+    assert(cd.getData()[0] == 1);
+    cd = copy;
+    assert(cd.getData()[0] == 5 && cd.getData() != copy.getData());
+}
+
+/**
+ * Сверка комбинаций, записанных в множество, с результатами поиска списком
+ *
+ * @param testCnt     кол-во тестов
+ * @param minS        минимальный размер матрицы-источника
+ * @param maxS        максимальный размер матрицы-источника
+ * @param minP        минимальный размер матрицы-паттерна
+ * @param maxP        максимальный размер матрицы-паттерна
+ * @param minE        минимальное значение элементов матриц
+ * @param maxE        максимальный значение элементов матриц
+ * @param nonZeroPart доля ненулевых элементов
+ * @param hardCheck   флаг, нужна ли жёсткая сверка
+ */
+void compare(
+        int testCnt, int minS, int maxS, int minP, int maxP, int minE, int maxE, double nonZeroPart,
+        bool hardCheck
+) {
+    for (int i = 0; i < testCnt; i++) {
+        int sourceSize = std::abs(std::rand()) % (maxS - minS) + minS;
+        int patternSize = std::abs(std::rand()) % (maxP - minP) + minP;
+        // формируем случайные матрицы
+        Matrix source(randomMatrix(sourceSize, minE, maxE, nonZeroPart), sourceSize);
+        Matrix pattern(randomMatrix(patternSize, minE, maxE, nonZeroPart), patternSize);
+
+        // добавляем в дата-граф несколько паттернов
+        PatternBuilder pb(source);
+        for (int j = 0; j < 3;)
+            if (pb.putPattern(pattern.toArray(), patternSize, getRandomCombination(sourceSize, patternSize)))
+                j++;
+
+        // быстрый поиск записывает комбинации в том же порядке
+        std::vector<CombinatoricsData> fast = fastGetAllPatterns(source, pattern, hardCheck);
+        MatchSet fastSet(patternSize);
+        fastGetAllPatterns(source, pattern, hardCheck, fastSet);
+        assert(fastSet.getSize() == (long long) fast.size());
+        for (long long k = 0; k < fastSet.getSize(); k++)
+            for (int j = 0; j < patternSize; j++)
+                assert(fastSet[k][j] == fast[k].getData()[j]);
+
+        // полный перебор находит те же комбинации
+        MatchSet slowSet(patternSize);
+        getAllPatterns(source, pattern, hardCheck, slowSet);
+        std::vector<CombinatoricsData> slow = slowSet.toCombinations();
+        std::unordered_set<CombinatoricsData, CombinatoricsData::HashFunction> slowHash(slow.begin(), slow.end());
+        std::unordered_set<CombinatoricsData, CombinatoricsData::HashFunction> fastHash(fast.begin(), fast.end());
+        assert(slow.size() == fast.size());
+        assert(slowHash == fastHash);
+
+        // размер комбинаций множества должен совпадать с размером паттерна
+        MatchSet wrong(patternSize + 1);
+        bool thrown = false;
+        try {
+            fastGetAllPatterns(source, pattern, hardCheck, wrong);
+        } catch (const std::invalid_argument &) {
+            thrown = true;
+        }
+        assert(thrown);
+    }
+}
+
+/**
+ * Главный метод
+ * @return код возрата
+ */
+int main() {
+    long ltime = time(nullptr);
+    int stime = (unsigned int) ltime / 2;
+    srand(stime);
+
+    std::cout << "TEST 1:" << std::endl;
+    checkStorage();
+    std::cout << "TEST 2:" << std::endl;
+    compare(10, 8, 12, 2, 4, 0, 3, 0.5, true);
+    std::cout << "TEST 3:" << std::endl;
+    compare(10, 8, 12, 2, 4, -2, 2, 0.3, false);
+}
@@ -0,0 +1,285 @@
+#include <algorithm>
+#include <cassert>
+#include <climits>
+#include <cstdio>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <thread>
+#include <vector>
+#include "misc/combinatorics.h"
+#include "misc/GraphGenerator.h"
+#include "misc/MatchReader.h"
+#include "misc/MatchSet.h"
+#include "misc/MatchWriter.h"
+#include "misc/Matrix.h"
+#include "misc/PatternBuilder.h"
+#include "misc/textIO.h"
+#include "fastPatternResolver.h"
+
+/**
+ * Получить отсортированный список комбинаций множества
+ *
+ * @param matches множество комбинаций
+ * @return отсортированный список
+ */
+std::vector<std::vector<int>> sorted(const MatchSet &matches) {
+    std::vector<std::vector<int>> res;
+    for (IntSpan c: matches)
+        res.emplace_back(c.begin(), c.end());
+    std::sort(res.begin(), res.end());
+    return res;
+}
+
+/**
+ * Прочитать файл комбинаций целиком
+ *
+ * @param path   путь к файлу
+ * @param format ожидаемый формат
+ * @param width  ожидаемый размер комбинации
+ * @return прочитанные комбинации
+ */
+MatchSet readBack(const std::string &path, MatchFormat format, int width) {
+    MatchReader reader(path);
+    assert(reader.getFormat() == format);
+    assert(reader.getWidth() == width);
+    MatchSet res(width);
+    long long cnt = reader.readAll(res);
+    assert(cnt == res.getSize());
+    assert(format == MATCH_TEXT || reader.getCount() == cnt);
+    return res;
+}
+
+/**
+ * Проверка записи из нескольких потоков: маленькие буферы и короткая очередь заставляют
+ * производителей ждать запись, а прочитанный файл совпадает с записанным как множество
+ *
+ * @param format         формат файла
+ * @param producerCount  кол-во производителей
+ * @param perProducer    кол-во комбинаций каждого производителя
+ * @param bufferCapacity кол-во комбинаций в одном буфере
+ */
+void checkProducers(MatchFormat format, int producerCount, int perProducer, int bufferCapacity) {
+    const std::string path = "matchWriterTest.out";
+    const int width = 4;
+    GraphGenerator generator(std::rand());
+
+    // комбинации каждого производителя заготовлены заранее; встречаются и отрицательные числа
+    std::vector<MatchSet> expected;
+    MatchSet all(width);
+    for (int producer = 0; producer < producerCount; producer++) {
+        expected.emplace_back(width);
+        for (int i = 0; i < perProducer; i++) {
+            std::vector<int> c = generator.combination(1000, width);
+            if (i % 7 == 0)
+                c[0] = -c[0] - 1;
+            expected.back().add(c.data());
+            all.add(c.data());
+        }
+    }
+
+    MatchWriter writer(path, width, producerCount, format, bufferCapacity, 1);
+    std::vector<std::thread> threads;
+    for (int producer = 0; producer < producerCount; producer++)
+        threads.emplace_back([&writer, &expected, producer]() {
+            for (IntSpan c: expected[producer]) {
+                bool ok = writer.add(producer, c);
+                assert(ok);
+            }
+        });
+    for (std::thread &thread: threads)
+        thread.join();
+    long long written = writer.close();
+    assert(written == all.getSize());
+    // повторное закрытие ничего не меняет
+    written = writer.close();
+    assert(written == all.getSize());
+
+    MatchSet actual = readBack(path, format, width);
+    assert(sorted(actual) == sorted(all));
+
+    // комбинации одного производителя идут в порядке добавления
+    if (producerCount == 1)
+        for (long long i = 0; i < all.getSize(); i++)
+            for (int j = 0; j < width; j++)
+                assert(actual[i][j] == all[i][j]);
+
+    std::remove(path.c_str());
+}
+
+/**
+ * Проверка сжатия: разности соседних комбинаций поиска маленькие, поэтому сжатый
+ * файл заметно меньше несжатого
+ */
+void checkCompression() {
+    const std::string binaryPath = "matchWriterTest.bin", deltaPath = "matchWriterTest.delta";
+    const int width = 3;
+    MatchWriter binary(binaryPath, width, 1, MATCH_BINARY), delta(deltaPath, width, 1, MATCH_DELTA);
+    for (int a = 0; a < 40; a++)
+        for (int b = 0; b < 40; b++)
+            for (int c = 0; c < 40; c++) {
+                int combination[] = {1000 + a, 2000 + b, 3000 + c};
+                binary.add(0, combination);
+                delta.add(0, combination);
+            }
+    binary.close();
+    delta.close();
+
+    std::ifstream binaryIn(binaryPath, std::ios::binary | std::ios::ate);
+    std::ifstream deltaIn(deltaPath, std::ios::binary | std::ios::ate);
+    assert(deltaIn.tellg() * 3 < binaryIn.tellg());
+    assert(sorted(readBack(binaryPath, MATCH_BINARY, width)) == sorted(readBack(deltaPath, MATCH_DELTA, width)));
+
+    std::remove(binaryPath.c_str());
+    std::remove(deltaPath.c_str());
+}
+
+/**
+ * Проверка сжатия крайних значений: разность соседних элементов не помещается в `int`
+ * и считается по модулю 2^32
+ */
+void checkExtremeDeltas() {
+    const std::string path = "matchWriterTest.extreme";
+    const int width = 2;
+    MatchSet expected(width);
+    int combinations[][width] = {{INT_MIN, INT_MAX}, {INT_MAX, INT_MIN}, {INT_MIN, INT_MIN}, {0, INT_MAX},
+                                 {INT_MAX, -1}, {-1, INT_MIN}, {INT_MIN, 0}};
+    MatchWriter writer(path, width, 1, MATCH_DELTA);
+    for (int *c: combinations) {
+        expected.add(c);
+        writer.add(0, c);
+    }
+    long long written = writer.close();
+    assert(written == expected.getSize());
+
+    // порядок одного производителя сохраняется
+    MatchSet actual = readBack(path, MATCH_DELTA, width);
+    for (long long i = 0; i < expected.getSize(); i++)
+        for (int j = 0; j < width; j++)
+            assert(actual[i][j] == expected[i][j]);
+    std::remove(path.c_str());
+}
+
+/**
+ * Сверка записи результатов поиска с `fastGetAllPatterns`
+ *
+ * @param testCnt   кол-во тестов
+ * @param hardCheck флаг, нужна ли жёсткая сверка
+ */
+void checkSearch(int testCnt, bool hardCheck) {
+    const std::string path = "matchWriterTest.search";
+    for (int test = 0; test < testCnt; test++) {
+        GraphGenerator generator(std::rand());
+        Matrix source = generator.uniformMatrix(60, 1, 3, 0.3);
+        Matrix pattern = generator.uniformMatrix(3, 1, 3, 0.5);
+        PatternBuilder pb(source);
+        pb.plantPatterns(pattern, 5, generator);
+
+        MatchSet expected(3);
+        fastGetAllPatterns(source, pattern, hardCheck, expected);
+
+        MatchFormat formats[] = {MATCH_BINARY, MATCH_DELTA, MATCH_TEXT};
+        for (MatchFormat format: formats) {
+            MatchWriter writer(path, 3, 4, format, 16, 2);
+            bool ok = fastWriteAllPatterns(source, pattern, hardCheck, 4, writer);
+            assert(ok);
+            long long written = writer.close();
+            assert(written == expected.getSize());
+            assert(sorted(readBack(path, format, 3)) == sorted(expected));
+        }
+
+        // последним записан текстовый файл: он читается и `readCombinations`
+        std::ifstream in(path);
+        assert((long long) readCombinations(in).size() == expected.getSize());
+    }
+    std::remove(path.c_str());
+}
+
+/**
+ * Проверка ошибок
+ */
+void checkErrors() {
+    bool thrown = false;
+    try {
+        MatchWriter writer("no_such_directory/matches.bin", 3, 1);
+    } catch (const std::invalid_argument &) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    thrown = false;
+    try {
+        MatchReader reader("no_such_directory/matches.bin");
+    } catch (const std::invalid_argument &) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    // пустой текстовый файл
+    const std::string path = "matchWriterTest.empty";
+    MatchWriter(path, 2, 1, MATCH_TEXT).close();
+    MatchReader reader(path);
+    bool read = reader.next();
+    assert(reader.getWidth() == 0 && !read);
+
+    // потоков поиска больше, чем производителей записи
+    MatchWriter writer(path, 3, 2, MATCH_BINARY);
+    assert(writer.getProducerCount() == 2);
+    Matrix source(5);
+    Matrix pattern(3);
+    thrown = false;
+    try {
+        fastWriteAllPatterns(source, pattern, false, 4, writer);
+    } catch (const std::invalid_argument &) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    // номер производителя вне диапазона
+    int c[] = {0, 1, 2};
+    thrown = false;
+    try {
+        writer.add(2, IntSpan(c, 3));
+    } catch (const std::invalid_argument &) {
+        thrown = true;
+    }
+    assert(thrown);
+    long long written = writer.close();
+    assert(written == 0);
+
+    // добавление после закрытия
+    thrown = false;
+    try {
+        writer.add(0, c);
+    } catch (const std::invalid_argument &) {
+        thrown = true;
+    }
+    assert(thrown);
+    std::remove(path.c_str());
+}
+
+/**
+ * Главный метод
+ * @return код возрата
+ */
+int main() {
+    long ltime = time(nullptr);
+    int stime = (unsigned int) ltime / 2;
+    srand(stime);
+
+    std::cout << "TEST 1:" << std::endl;
+    checkProducers(MATCH_TEXT, 4, 5000, 64);
+    checkProducers(MATCH_BINARY, 4, 5000, 64);
+    checkProducers(MATCH_DELTA, 4, 5000, 64);
+    std::cout << "TEST 2:" << std::endl;
+    checkProducers(MATCH_DELTA, 1, 3000, 100);
+    checkProducers(MATCH_TEXT, 1, 3000, 100);
+    std::cout << "TEST 3:" << std::endl;
+    checkCompression();
+    checkExtremeDeltas();
+    std::cout << "TEST 4:" << std::endl;
+    checkSearch(5, true);
+    checkSearch(5, false);
+    std::cout << "TEST 5:" << std::endl;
+    checkErrors();
+}
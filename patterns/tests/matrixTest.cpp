@@ -0,0 +1,124 @@
+#include <cassert>
+#include <cstdint>
+#include <ctime>
+#include <iostream>
+#include "misc/combinatorics.h"
+#include "misc/Matrix.h"
+#include "misc/PatternBuilder.h"
+#include "patternResolver.h"
+#include "fastPatternResolver.h"
+
+/**
+ * Проверка размещения матрицы в памяти
+ */
+void testLayout() {
+    for (int sz = 1; sz < 70; sz++) {
+        Matrix m(sz);
+        // шаг строки не меньше её размера и кратен кэш-линии
+        assert(m.getStride() >= sz);
+        assert(m.getStride() % 16 == 0);
+        // начало каждой строки выровнено по кэш-линии
+        for (int i = 0; i < sz; i++)
+            assert(reinterpret_cast<std::uintptr_t>(m.getRow(i)) % 64 == 0);
+        // новая матрица заполнена нулями
+        for (int i = 0; i < sz; i++)
+            for (int j = 0; j < sz; j++)
+                assert(m.get(i, j) == 0);
+
+        // без дополнения строки идут вплотную
+        Matrix packed(sz, false);
+        assert(packed.getStride() == sz);
+    }
+}
+
+/**
+ * Проверка преобразований между `int **` и матрицей
+ */
+void testConversion() {
+    for (int t = 0; t < 20; t++) {
+        int n = std::abs(std::rand()) % 40 + 1;
+        int **arr = randomMatrix(n, -100, 100, 0.5);
+
+        Matrix m(arr, n);
+        for (int i = 0; i < n; i++)
+            for (int j = 0; j < n; j++)
+                assert(m.get(i, j) == arr[i][j]);
+
+        // копия в формате `int **` совпадает с исходной
+        assert(areEqual(m.toArray(), arr, n));
+
+        // представление чужого буфера не копирует данные
+        Matrix view(m.getData(), n, m.getStride());
+        view.set(0, 0, 12345);
+        assert(m.get(0, 0) == 12345);
+
+        // копия представления владеет своей памятью
+        Matrix copy(view);
+        copy.set(0, 0, 1);
+        assert(m.get(0, 0) == 12345);
+
+        // подматрицы и перестановки совпадают для обоих форматов
+        int *p = getRandomPermutation(n);
+        assert(areEqual(makePermute(m, p), Matrix(makePermute(m.toArray(), n, p), n)));
+        int k = std::abs(std::rand()) % n + 1;
+        assert(areEqual(getSubMatrix(m, p, k), Matrix(getSubMatrix(m.toArray(), p, k), k)));
+
+        // степени вершин совпадают для обоих форматов
+        int *powers = getPowers(m);
+        int *arrPowers = getPowers(m.toArray(), n);
+        for (int i = 0; i < n; i++)
+            assert(powers[i] == arrPowers[i]);
+    }
+}
+
+/**
+ * Сверка результатов поиска по матрице и по `int **`
+ *
+ * @param hardCheck флаг, нужна ли жёсткая сверка
+ */
+void testResolvers(bool hardCheck) {
+    for (int t = 0; t < 10; t++) {
+        int sourceSize = std::abs(std::rand()) % 4 + 8;
+        int patternSize = std::abs(std::rand()) % 2 + 3;
+        Matrix source(randomMatrix(sourceSize, -3, 3, 0.6), sourceSize);
+        Matrix pattern(randomMatrix(patternSize, -3, 3, 0.6), patternSize);
+
+        // добавляем паттерн в дата-граф прямо через матрицу
+        PatternBuilder pb(source);
+        for (int j = 0; j < 3;)
+            if (pb.putPattern(pattern.toArray(), patternSize, getRandomCombination(sourceSize, patternSize)))
+                j++;
+
+        std::vector<CombinatoricsData> fast = fastGetAllPatterns(source, pattern, hardCheck);
+        std::vector<CombinatoricsData> fastArr =
+                fastGetAllPatterns(source.toArray(), sourceSize, pattern.toArray(), patternSize, hardCheck);
+        std::vector<CombinatoricsData> full = getAllPatterns(source, pattern, hardCheck);
+
+        std::unordered_set<CombinatoricsData, CombinatoricsData::HashFunction> fastSet(fast.begin(), fast.end());
+        std::unordered_set<CombinatoricsData, CombinatoricsData::HashFunction> fastArrSet(
+                fastArr.begin(), fastArr.end()
+        );
+        std::unordered_set<CombinatoricsData, CombinatoricsData::HashFunction> fullSet(full.begin(), full.end());
+
+        assert(fastSet == fastArrSet);
+        assert(fastSet == fullSet);
+    }
+}
+
+/**
+ * Главный метод
+ * @return код возрата
+ */
+int main() {
+    long ltime = time(nullptr);
+    int stime = (unsigned int) ltime / 2;
+    srand(stime);
+
+    std::cout << "TEST LAYOUT:" << std::endl;
+    testLayout();
+    std::cout << "TEST CONVERSION:" << std::endl;
+    testConversion();
+    std::cout << "TEST RESOLVERS:" << std::endl;
+    testResolvers(true);
+    testResolvers(false);
+}
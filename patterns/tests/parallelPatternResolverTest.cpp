@@ -0,0 +1,166 @@
+#include <atomic>
+#include <cassert>
+#include <ctime>
+#include <iostream>
+#include <stdexcept>
+#include "misc/combinatorics.h"
+#include "misc/Matrix.h"
+#include "misc/PatternBuilder.h"
+#include "patternResolver.h"
+#include "fastPatternResolver.h"
+
+/**
+ * Сверка результатов однопоточного и многопоточного быстрого поиска изоморфных подграфов
+ *
+ * @param testCnt     кол-во тестов
+ * @param minS        минимальный размер матрицы-источника
+ * @param maxS        максимальный размер матрицы-источника
+ * @param minP        минимальный размер матрицы-паттерна
+ * @param maxP        максимальный размер матрицы-паттерна
+ * @param minE        минимальное значение элементов матриц
+ * @param maxE        максимальный значение элементов матриц
+ * @param nonZeroPart доля ненулевых элементов
+ * @param hardCheck   флаг, нужна ли жёсткая сверка
+ */
+void compare(
+        int testCnt, int minS, int maxS, int minP, int maxP, int minE, int maxE, double nonZeroPart,
+        bool hardCheck
+) {
+    for (int i = 0; i < testCnt; i++) {
+        int sourceSize = std::abs(std::rand()) % (maxS - minS) + minS;
+        int patternSize = std::abs(std::rand()) % (maxP - minP) + minP;
+        // формируем случайные матрицы
+        Matrix source(randomMatrix(sourceSize, minE, maxE, nonZeroPart), sourceSize);
+        Matrix pattern(randomMatrix(patternSize, minE, maxE, nonZeroPart), patternSize);
+
+        // добавляем в дата-граф несколько паттернов
+        PatternBuilder pb(source);
+        for (int j = 0; j < 5;)
+            if (pb.putPattern(pattern.toArray(), patternSize, getRandomCombination(sourceSize, patternSize)))
+                j++;
+
+        std::vector<CombinatoricsData> sequential = fastGetAllPatterns(source, pattern, hardCheck);
+        std::unordered_set<CombinatoricsData, CombinatoricsData::HashFunction>
+                sequentialSet(sequential.begin(), sequential.end());
+
+        for (int threadCount = 2; threadCount <= 8; threadCount *= 2) {
+            // детерминированный режим возвращает комбинации в том же порядке
+            std::vector<CombinatoricsData> deterministic =
+                    fastGetAllPatterns(source, pattern, hardCheck, threadCount, true);
+            assert(deterministic.size() == sequential.size());
+            for (int k = 0; k < (int) sequential.size(); k++)
+                assert(deterministic[k] == sequential[k]);
+
+            // в обычном режиме совпадает множество комбинаций
+            std::vector<CombinatoricsData> parallel =
+                    fastGetAllPatterns(source, pattern, hardCheck, threadCount, false);
+            std::unordered_set<CombinatoricsData, CombinatoricsData::HashFunction>
+                    parallelSet(parallel.begin(), parallel.end());
+            assert(parallel.size() == sequential.size());
+            assert(parallelSet == sequentialSet);
+        }
+    }
+}
+
+/**
+ * Сверка многопоточного полного перебора с однопоточным и с быстрым поиском
+ *
+ * @param testCnt     кол-во тестов
+ * @param minS        минимальный размер матрицы-источника
+ * @param maxS        максимальный размер матрицы-источника
+ * @param minP        минимальный размер матрицы-паттерна
+ * @param maxP        максимальный размер матрицы-паттерна
+ * @param minE        минимальное значение элементов матриц
+ * @param maxE        максимальный значение элементов матриц
+ * @param nonZeroPart доля ненулевых элементов
+ * @param hardCheck   флаг, нужна ли жёсткая сверка
+ */
+void compareBruteForce(
+        int testCnt, int minS, int maxS, int minP, int maxP, int minE, int maxE, double nonZeroPart,
+        bool hardCheck
+) {
+    for (int i = 0; i < testCnt; i++) {
+        int sourceSize = std::abs(std::rand()) % (maxS - minS) + minS;
+        int patternSize = std::abs(std::rand()) % (maxP - minP) + minP;
+        // формируем случайные матрицы
+        Matrix source(randomMatrix(sourceSize, minE, maxE, nonZeroPart), sourceSize);
+        Matrix pattern(randomMatrix(patternSize, minE, maxE, nonZeroPart), patternSize);
+
+        // добавляем в дата-граф несколько паттернов
+        PatternBuilder pb(source);
+        for (int j = 0; j < 3;)
+            if (pb.putPattern(pattern.toArray(), patternSize, getRandomCombination(sourceSize, patternSize)))
+                j++;
+
+        std::vector<CombinatoricsData> sequential = getAllPatterns(source, pattern, hardCheck);
+        std::vector<CombinatoricsData> fast = fastGetAllPatterns(source, pattern, hardCheck);
+        std::unordered_set<CombinatoricsData, CombinatoricsData::HashFunction>
+                sequentialSet(sequential.begin(), sequential.end());
+        std::unordered_set<CombinatoricsData, CombinatoricsData::HashFunction> fastSet(fast.begin(), fast.end());
+        assert(sequential.size() == fast.size());
+        assert(sequentialSet == fastSet);
+
+        for (int threadCount = 2; threadCount <= 8; threadCount *= 2) {
+            // многопоточный перебор возвращает комбинации в том же порядке
+            std::vector<CombinatoricsData> parallel = getAllPatterns(source, pattern, hardCheck, threadCount);
+            assert(parallel.size() == sequential.size());
+            for (int k = 0; k < (int) sequential.size(); k++)
+                assert(parallel[k] == sequential[k]);
+        }
+    }
+}
+
+/**
+ * Проверка, что исключение обработчика из рабочего потока выбрасывается вызывающему
+ * потоку, а остальные потоки завершаются
+ *
+ * @param testCnt кол-во тестов
+ */
+void checkVisitorException(int testCnt) {
+    for (int i = 0; i < testCnt; i++) {
+        Matrix source(randomMatrix(40, 0, 2, 0.5), 40);
+        Matrix pattern(randomMatrix(3, 0, 2, 0.5), 3);
+        PatternBuilder pb(source);
+        for (int j = 0; j < 5;)
+            if (pb.putPattern(pattern.toArray(), 3, getRandomCombination(40, 3)))
+                j++;
+
+        for (int threadCount = 2; threadCount <= 8; threadCount *= 2) {
+            std::atomic<long long> visited(0);
+            bool thrown = false;
+            try {
+                fastForEachPattern(source, pattern, false, threadCount, [&visited](int, IntSpan) {
+                    if (++visited == 3)
+                        throw std::runtime_error("visitor failure");
+                    return true;
+                });
+            } catch (const std::runtime_error &) {
+                thrown = true;
+            }
+            assert(thrown);
+        }
+    }
+}
+
+/**
+ * Главный метод
+ * @return код возрата
+ */
+int main() {
+    long ltime = time(nullptr);
+    int stime = (unsigned int) ltime / 2;
+    srand(stime);
+
+    std::cout << "TEST 1:" << std::endl;
+    compare(10, 30, 40, 3, 5, 0, 3, 0.5, true);
+    std::cout << "TEST 2:" << std::endl;
+    compare(10, 30, 40, 3, 5, -2, 2, 0.3, false);
+    std::cout << "TEST 3:" << std::endl;
+    compare(10, 60, 80, 2, 4, 0, 2, 0.2, false);
+    std::cout << "TEST 4:" << std::endl;
+    compareBruteForce(10, 12, 16, 2, 5, 0, 2, 0.5, true);
+    std::cout << "TEST 5:" << std::endl;
+    compareBruteForce(10, 12, 16, 2, 5, -1, 1, 0.3, false);
+    std::cout << "TEST 6:" << std::endl;
+    checkVisitorException(10);
+}
@@ -0,0 +1,133 @@
+#include <algorithm>
+#include <cassert>
+#include <ctime>
+#include <iostream>
+#include "misc/combinatorics.h"
+#include "misc/GraphGenerator.h"
+#include "misc/MatchSet.h"
+#include "misc/Matrix.h"
+#include "misc/PatternBuilder.h"
+#include "fastPatternResolver.h"
+
+/**
+ * Проверка, что каждая добавленная комбинация несёт в результирующей матрице копию паттерна
+ *
+ * @param source  результирующая матрица
+ * @param pattern паттерн
+ * @param planted добавленные комбинации
+ */
+void checkPlanted(const Matrix &source, const Matrix &pattern, const MatchSet &planted) {
+    for (IntSpan c: planted)
+        for (int i = 0; i < pattern.getSize(); i++)
+            for (int j = 0; j < pattern.getSize(); j++)
+                assert(source.get(c[i], c[j]) == pattern.get(i, j));
+}
+
+/**
+ * Проверка одиночного добавления и разреженного учёта занятых ячеек
+ */
+void checkPutPattern() {
+    Matrix source(randomMatrix(10, 1, 4, 0.5), 10);
+    Matrix pattern(randomMatrix(3, 1, 4, 1), 3);
+    int **patternRows = pattern.toArray();
+
+    PatternBuilder pb(source);
+    int first[] = {4, 1, 7};
+    assert(pb.putPattern(patternRows, 3, CombinatoricsData(first, 3)));
+    for (int i = 0; i < 3; i++)
+        for (int j = 0; j < 3; j++) {
+            assert(pb.isOccupied(first[i], first[j]));
+            assert(source.get(first[i], first[j]) == pattern.get(i, j));
+        }
+    assert(!pb.isOccupied(4, 2) && !pb.isOccupied(0, 0));
+
+    // та же комбинация ничему не противоречит
+    assert(pb.putPattern(patternRows, 3, CombinatoricsData(first, 3)));
+    // комбинация, которая меняет занятую ячейку на другое значение, не добавляется
+    patternRows[0][1] = pattern.get(0, 1) + 1;
+    assert(!pb.putPattern(patternRows, 3, CombinatoricsData(first, 3)));
+    assert(source.get(4, 1) == pattern.get(0, 1));
+
+    bool thrown = false;
+    try {
+        pb.putPattern(patternRows, 2, CombinatoricsData(first, 3));
+    } catch (const std::invalid_argument &) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    for (int i = 0; i < 3; i++)
+        delete[] patternRows[i];
+    delete[] patternRows;
+}
+
+/**
+ * Проверка массового добавления: добавленные комбинации находятся поиском,
+ * а результат не зависит от кол-ва потоков
+ *
+ * @param testCnt    кол-во тестов
+ * @param sourceSize размер матрицы-источника
+ * @param count      кол-во копий паттерна
+ * @param hardCheck  флаг, нужна ли жёсткая сверка
+ */
+void checkPlantPatterns(int testCnt, int sourceSize, int count, bool hardCheck) {
+    for (int test = 0; test < testCnt; test++) {
+        int patternSize = std::abs(std::rand()) % 3 + 3;
+        uint64_t seed = std::rand();
+        GraphGenerator sourceGenerator(seed);
+        Matrix source = sourceGenerator.uniformMatrix(sourceSize, 1, 4, 0.1);
+        Matrix pattern = sourceGenerator.uniformMatrix(patternSize, 1, 4, 0.5);
+
+        Matrix parallelSource(source);
+        GraphGenerator generator(seed + 1), parallelGenerator(seed + 1);
+        PatternBuilder pb(source), parallelPb(parallelSource);
+        MatchSet planted = pb.plantPatterns(pattern, count, generator);
+        MatchSet parallelPlanted = parallelPb.plantPatterns(pattern, count, parallelGenerator, 4);
+
+        // разреженная матрица принимает все копии
+        assert(planted.getSize() == count);
+        checkPlanted(source, pattern, planted);
+        // результат не зависит от кол-ва потоков
+        assert(areEqual(source, parallelSource));
+        assert(planted.getSize() == parallelPlanted.getSize());
+        for (long long i = 0; i < planted.getSize(); i++)
+            for (int j = 0; j < patternSize; j++)
+                assert(planted[i][j] == parallelPlanted[i][j]);
+
+        // все добавленные комбинации находятся поиском
+        MatchSet found(patternSize);
+        fastGetAllPatterns(source, pattern, hardCheck, found);
+        std::vector<std::vector<int>> foundList;
+        for (IntSpan c: found)
+            foundList.emplace_back(c.begin(), c.end());
+        std::sort(foundList.begin(), foundList.end());
+        for (IntSpan c: planted)
+            assert(std::binary_search(foundList.begin(), foundList.end(), std::vector<int>(c.begin(), c.end())));
+    }
+
+    // паттерн, противоречащий сам себе на пересечениях, занимает матрицу лишь частично
+    Matrix source(randomMatrix(20, 1, 4, 0), 20);
+    Matrix pattern(randomMatrix(4, 1, 4, 1), 4);
+    GraphGenerator generator(3);
+    PatternBuilder pb(source);
+    MatchSet planted = pb.plantPatterns(pattern, 1000, generator, 2, 5);
+    assert(planted.getSize() < 1000 && planted.getSize() >= 5);
+    checkPlanted(source, pattern, planted);
+}
+
+/**
+ * Главный метод
+ * @return код возрата
+ */
+int main() {
+    long ltime = time(nullptr);
+    int stime = (unsigned int) ltime / 2;
+    srand(stime);
+
+    std::cout << "TEST 1:" << std::endl;
+    checkPutPattern();
+    std::cout << "TEST 2:" << std::endl;
+    checkPlantPatterns(5, 300, 40, true);
+    std::cout << "TEST 3:" << std::endl;
+    checkPlantPatterns(5, 300, 40, false);
+}
@@ -1,6 +1,7 @@
 #include <cassert>
 #include <ctime>
 #include <iostream>
+#include <vector>
 #include "patternResolver.h"
 
 /**
@@ -97,6 +98,50 @@ void test2() {
     }
 }
 
+/**
+ * Тест для проверки, что перебор с отсечением по префиксу находит те же перестановки,
+ * что и проверка каждой перестановки целиком
+ */
+void test3() {
+    // без отсечения генератор перебирает все перестановки в лексикографическом порядке
+    for (int n = 1; n <= 6; n++) {
+        std::vector<int> prev;
+        long long cnt = 0;
+        generatePermutations(n, [](const int *, int) {
+            return true;
+        }, [&prev, &cnt, &n](int *p) {
+            std::vector<int> current(p, p + n);
+            assert(prev.empty() || prev < current);
+            prev = current;
+            cnt++;
+        });
+        long long factorial = 1;
+        for (int k = 2; k <= n; k++)
+            factorial *= k;
+        assert(cnt == factorial);
+    }
+
+    for (int i = 0; i < 100; i++) {
+        int n = std::rand() % 6 + 2;
+        bool hardCheck = i % 2 == 0;
+        // небольшой разброс значений, чтобы подходящих перестановок было много
+        Matrix source(randomMatrix(n, 0, 2, 0.5), n);
+        Matrix target(randomMatrix(n, 0, 2, 0.3), n);
+
+        int *sourceSum = getPowers(source);
+        int *targetSum = getPowers(target);
+        std::unordered_set<CombinatoricsData, CombinatoricsData::HashFunction> expected;
+        generatePermutations(n, [&expected, &n, &source, &target, &sourceSum, &targetSum, &hardCheck](int *p) {
+            if (arePermutatedEquals(p, source, target, sourceSum, targetSum, hardCheck))
+                expected.insert(CombinatoricsData(p, n));
+        });
+        delete[] sourceSum;
+        delete[] targetSum;
+
+        assert(getAllIsomorphicPermutations(source, target, hardCheck) == expected);
+    }
+}
+
 /**
  * Главный метод
  * @return код возрата
@@ -110,4 +155,6 @@ int main() {
     test1();
     std::cout << "TEST 2:" << std::endl;
     test2();
-}
\ No newline at end of file
+    std::cout << "TEST 3:" << std::endl;
+    test3();
+}
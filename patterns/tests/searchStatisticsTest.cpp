@@ -0,0 +1,144 @@
+#include <cassert>
+#include <ctime>
+#include <iostream>
+#include "misc/combinatorics.h"
+#include "misc/Matrix.h"
+#include "misc/MatchSet.h"
+#include "misc/PatternBuilder.h"
+#include "misc/SearchStatistics.h"
+#include "fastPatternResolver.h"
+
+/**
+ * Проверка, что две статистики совпадают по всем счётчикам, кроме времени
+ *
+ * @param a первая статистика
+ * @param b вторая статистика
+ */
+void checkEqualCounters(const SearchStatistics &a, const SearchStatistics &b) {
+    assert(a.getMatches() == b.getMatches());
+    assert(a.getDepthsCount() == b.getDepthsCount());
+    for (int depth = 0; depth < a.getDepthsCount(); depth++)
+        assert(a.getNodes(depth) == b.getNodes(depth));
+    for (int reason = 0; reason < SearchStatistics::REASONS_COUNT; reason++)
+        assert(a.getPrunes((SearchStatistics::PruneReason) reason) ==
+               b.getPrunes((SearchStatistics::PruneReason) reason));
+}
+
+/**
+ * Проверка объединения и обнуления счётчиков
+ */
+void checkCounters() {
+    SearchStatistics a, b;
+    a.addNodes(0, 3);
+    a.addNodes(2);
+    a.addPrunes(SearchStatistics::DEGREE, 5);
+    b.addNodes(1, 4);
+    b.addMatches(2);
+    b.addSearchTime(10);
+    a.merge(b);
+
+    if (!SearchStatistics::isEnabled()) {
+        // без опции сборки счётчики не ведутся
+        assert(a.getTotalNodes() == 0 && a.getDepthsCount() == 0);
+        assert(a.getPrunes(SearchStatistics::DEGREE) == 0);
+        assert(a.getMatches() == 0 && a.getSearchTime() == 0);
+        return;
+    }
+
+    assert(a.getDepthsCount() == 3);
+    assert(a.getNodes(0) == 3 && a.getNodes(1) == 4 && a.getNodes(2) == 1 && a.getNodes(5) == 0);
+    assert(a.getTotalNodes() == 8);
+    assert(a.getPrunes(SearchStatistics::DEGREE) == 5);
+    assert(a.getMatches() == 2 && a.getSearchTime() == 10);
+
+    a.clear();
+    assert(a.getTotalNodes() == 0 && a.getMatches() == 0 && a.getPrunes(SearchStatistics::DEGREE) == 0);
+}
+
+/**
+ * Сверка статистики разных методов перебора с результатами поиска
+ *
+ * @param testCnt     кол-во тестов
+ * @param minS        минимальный размер матрицы-источника
+ * @param maxS        максимальный размер матрицы-источника
+ * @param minP        минимальный размер матрицы-паттерна
+ * @param maxP        максимальный размер матрицы-паттерна
+ * @param minE        минимальное значение элементов матриц
+ * @param maxE        максимальный значение элементов матриц
+ * @param nonZeroPart доля ненулевых элементов
+ * @param hardCheck   флаг, нужна ли жёсткая сверка
+ */
+void compare(
+        int testCnt, int minS, int maxS, int minP, int maxP, int minE, int maxE, double nonZeroPart,
+        bool hardCheck
+) {
+    for (int i = 0; i < testCnt; i++) {
+        int sourceSize = std::abs(std::rand()) % (maxS - minS) + minS;
+        int patternSize = std::abs(std::rand()) % (maxP - minP) + minP;
+        // формируем случайные матрицы
+        Matrix source(randomMatrix(sourceSize, minE, maxE, nonZeroPart), sourceSize);
+        Matrix pattern(randomMatrix(patternSize, minE, maxE, nonZeroPart), patternSize);
+
+        // добавляем в дата-граф несколько паттернов
+        PatternBuilder pb(source);
+        for (int j = 0; j < 3;)
+            if (pb.putPattern(pattern.toArray(), patternSize, getRandomCombination(sourceSize, patternSize)))
+                j++;
+
+        // статистика не влияет на результат поиска
+        MatchSet matches(patternSize);
+        SearchStatistics runStatistics;
+        fastGetAllPatterns(source, pattern, hardCheck, matches, runStatistics);
+        assert(matches.getSize() == fastCountAllPatterns(source, pattern, hardCheck));
+
+        SearchStatistics countStatistics;
+        assert(fastCountAllPatterns(source, pattern, hardCheck, countStatistics) == matches.getSize());
+
+        FastPatternSearch search(source, pattern, hardCheck);
+        SearchStatistics parallelStatistics;
+        assert(search.countParallel(4, &parallelStatistics) == matches.getSize());
+
+        if (!SearchStatistics::isEnabled()) {
+            assert(runStatistics.getTotalNodes() == 0 && runStatistics.getMatches() == 0);
+            assert(runStatistics.getBuildTime() == 0 && runStatistics.getSearchTime() == 0);
+            continue;
+        }
+
+        assert(runStatistics.getMatches() == matches.getSize());
+        // каждый узел последней глубины - найденное вхождение
+        assert(runStatistics.getNodes(patternSize - 1) == matches.getSize());
+        // из начальных доменов не может быть отброшено больше пар, чем их всего
+        assert(runStatistics.getPrunes(SearchStatistics::DIAGONAL) +
+               runStatistics.getPrunes(SearchStatistics::DEGREE) <= (long long) sourceSize * patternSize);
+        assert(runStatistics.getPrunes(SearchStatistics::PREFIX) == 0);
+
+        // подсчёт и параллельный подсчёт обходят то же дерево перебора
+        checkEqualCounters(runStatistics, countStatistics);
+        checkEqualCounters(runStatistics, parallelStatistics);
+        // отсечения начальных доменов попадают в статистику при построении поиска
+        assert(search.getBuildStatistics().getPrunes(SearchStatistics::DIAGONAL) ==
+               runStatistics.getPrunes(SearchStatistics::DIAGONAL));
+        assert(search.getBuildStatistics().getPrunes(SearchStatistics::DEGREE) ==
+               runStatistics.getPrunes(SearchStatistics::DEGREE));
+        assert(search.getBuildStatistics().getBuildTime() > 0);
+        assert(search.getBuildStatistics().getTotalNodes() == 0);
+    }
+}
+
+/**
+ * Главный метод
+ * @return код возрата
+ */
+int main() {
+    long ltime = time(nullptr);
+    int stime = (unsigned int) ltime / 2;
+    srand(stime);
+
+    std::cout << "statistics " << (SearchStatistics::isEnabled() ? "enabled" : "disabled") << std::endl;
+    std::cout << "TEST 1:" << std::endl;
+    checkCounters();
+    std::cout << "TEST 2:" << std::endl;
+    compare(10, 30, 40, 3, 5, 0, 3, 0.5, true);
+    std::cout << "TEST 3:" << std::endl;
+    compare(10, 30, 40, 3, 5, -2, 2, 0.3, false);
+}
@@ -0,0 +1,83 @@
+#include <cassert>
+#include <ctime>
+#include <iostream>
+#include <sstream>
+#include "misc/combinatorics.h"
+#include "misc/Matrix.h"
+#include "misc/PatternBuilder.h"
+#include "misc/textIO.h"
+#include "fastPatternResolver.h"
+
+/**
+ * Сверка результатов поиска по частям перебора с результатом полного быстрого поиска
+ *
+ * @param testCnt     кол-во тестов
+ * @param minS        минимальный размер матрицы-источника
+ * @param maxS        максимальный размер матрицы-источника
+ * @param minP        минимальный размер матрицы-паттерна
+ * @param maxP        максимальный размер матрицы-паттерна
+ * @param minE        минимальное значение элементов матриц
+ * @param maxE        максимальный значение элементов матриц
+ * @param nonZeroPart доля ненулевых элементов
+ * @param hardCheck   флаг, нужна ли жёсткая сверка
+ */
+void compare(
+        int testCnt, int minS, int maxS, int minP, int maxP, int minE, int maxE, double nonZeroPart,
+        bool hardCheck
+) {
+    for (int i = 0; i < testCnt; i++) {
+        int sourceSize = std::abs(std::rand()) % (maxS - minS) + minS;
+        int patternSize = std::abs(std::rand()) % (maxP - minP) + minP;
+        // формируем случайные матрицы
+        Matrix source(randomMatrix(sourceSize, minE, maxE, nonZeroPart), sourceSize);
+        Matrix pattern(randomMatrix(patternSize, minE, maxE, nonZeroPart), patternSize);
+
+        // добавляем в дата-граф несколько паттернов
+        PatternBuilder pb(source);
+        for (int j = 0; j < 5;)
+            if (pb.putPattern(pattern.toArray(), patternSize, getRandomCombination(sourceSize, patternSize)))
+                j++;
+
+        // матрицы проходят через текстовый формат без изменений
+        std::stringstream matrixStream;
+        writeMatrix(matrixStream, source);
+        assert(areEqual(readMatrix(matrixStream), source));
+
+        std::vector<CombinatoricsData> full = fastGetAllPatterns(source, pattern, hardCheck);
+        std::unordered_set<CombinatoricsData, CombinatoricsData::HashFunction>
+                fullSet(full.begin(), full.end());
+
+        for (int shardCount = 1; shardCount <= 7; shardCount += 3) {
+            // объединяем результаты всех частей через текстовый формат
+            std::stringstream shardStream;
+            for (int shardIndex = 0; shardIndex < shardCount; shardIndex++)
+                writeCombinations(
+                        shardStream, fastGetAllPatternsShard(source, pattern, hardCheck, shardIndex, shardCount)
+                );
+            std::vector<CombinatoricsData> merged = readCombinations(shardStream);
+            std::unordered_set<CombinatoricsData, CombinatoricsData::HashFunction>
+                    mergedSet(merged.begin(), merged.end());
+
+            // части не пересекаются, а вместе дают полный результат
+            assert(merged.size() == full.size());
+            assert(mergedSet == fullSet);
+        }
+    }
+}
+
+/**
+ * Главный метод
+ * @return код возрата
+ */
+int main() {
+    long ltime = time(nullptr);
+    int stime = (unsigned int) ltime / 2;
+    srand(stime);
+
+    std::cout << "TEST 1:" << std::endl;
+    compare(10, 30, 40, 3, 5, 0, 3, 0.5, true);
+    std::cout << "TEST 2:" << std::endl;
+    compare(10, 30, 40, 3, 5, -2, 2, 0.3, false);
+    std::cout << "TEST 3:" << std::endl;
+    compare(10, 60, 80, 2, 4, 0, 2, 0.2, false);
+}
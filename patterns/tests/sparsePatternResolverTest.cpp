@@ -0,0 +1,138 @@
+#include <algorithm>
+#include <cassert>
+#include <ctime>
+#include <iostream>
+#include "misc/combinatorics.h"
+#include "misc/CsrGraph.h"
+#include "misc/Matrix.h"
+#include "misc/PatternBuilder.h"
+#include "fastPatternResolver.h"
+#include "sparsePatternResolver.h"
+
+/**
+ * Проверка построения разреженного графа по списку рёбер
+ */
+void testCsrGraph() {
+    std::vector<CsrGraph::Edge> edges = {{2, 0, 5}, {0, 1, 1}, {1, 1, 7}, {0, 2, -3}, {2, 1, 0}};
+    CsrGraph graph(3, edges);
+    // нулевое ребро пропущено, петля хранится отдельно
+    assert(graph.getEdgeCount() == 3);
+    assert(graph.getLoop(1) == 7);
+    assert(graph.get(0, 2) == -3 && graph.get(2, 0) == 5 && graph.get(2, 1) == 0 && graph.get(1, 1) == 7);
+    // списки отсортированы по номеру соседа
+    assert(graph.getOutDegree(0) == 2 && graph.getOutTargets(0)[0] == 1 && graph.getOutTargets(0)[1] == 2);
+    assert(graph.getInDegree(1) == 1 && graph.getInSources(1)[0] == 0);
+
+    // плотная матрица восстанавливается без изменений
+    Matrix dense = graph.toMatrix();
+    assert(areEqual(CsrGraph(dense).toMatrix(), dense));
+
+    // повторное ребро недопустимо
+    edges.push_back({0, 1, 2});
+    bool thrown = false;
+    try {
+        CsrGraph duplicated(3, edges);
+    } catch (const std::invalid_argument &) {
+        thrown = true;
+    }
+    assert(thrown);
+}
+
+/**
+ * Проверка поиска в большом разреженном графе: каждая вершина связана с двумя следующими,
+ * поэтому треугольники образуют ровно тройки соседних вершин
+ *
+ * @param sz кол-во вершин
+ */
+void testLargeGraph(int sz) {
+    std::vector<CsrGraph::Edge> edges;
+    for (int i = 0; i < sz; i++)
+        for (int d = 1; d <= 2; d++)
+            if (i + d < sz)
+                edges.push_back({i, i + d, d});
+    CsrGraph graph(sz, edges);
+
+    Matrix triangle(3);
+    triangle.set(0, 1, 1);
+    triangle.set(1, 2, 1);
+    triangle.set(0, 2, 2);
+
+    assert(sparseCountAllPatterns(graph, triangle, true) == sz - 2);
+    assert(sparseCountAllPatterns(graph, triangle, false) == sz - 2);
+
+    // остановка на первом вхождении
+    int visited = 0;
+    assert(!sparseForEachPattern(graph, triangle, true, [&visited](IntSpan c) {
+        assert(c[1] == c[0] + 1 && c[2] == c[0] + 2);
+        visited++;
+        return false;
+    }));
+    assert(visited == 1);
+}
+
+/**
+ * Сверка поиска в разреженном графе с быстрым поиском в плотной матрице
+ *
+ * @param testCnt     кол-во тестов
+ * @param minS        минимальный размер матрицы-источника
+ * @param maxS        максимальный размер матрицы-источника
+ * @param minP        минимальный размер матрицы-паттерна
+ * @param maxP        максимальный размер матрицы-паттерна
+ * @param minE        минимальное значение элементов матриц
+ * @param maxE        максимальный значение элементов матриц
+ * @param nonZeroPart доля ненулевых элементов
+ * @param hardCheck   флаг, нужна ли жёсткая сверка
+ */
+void compare(
+        int testCnt, int minS, int maxS, int minP, int maxP, int minE, int maxE, double nonZeroPart,
+        bool hardCheck
+) {
+    for (int i = 0; i < testCnt; i++) {
+        int sourceSize = std::abs(std::rand()) % (maxS - minS) + minS;
+        int patternSize = std::abs(std::rand()) % (maxP - minP) + minP;
+        // формируем случайные матрицы
+        Matrix source(randomMatrix(sourceSize, minE, maxE, nonZeroPart), sourceSize);
+        Matrix pattern(randomMatrix(patternSize, minE, maxE, nonZeroPart), patternSize);
+
+        // добавляем в дата-граф несколько паттернов
+        PatternBuilder pb(source);
+        for (int j = 0; j < 5;)
+            if (pb.putPattern(pattern.toArray(), patternSize, getRandomCombination(sourceSize, patternSize)))
+                j++;
+
+        std::vector<CombinatoricsData> dense = fastGetAllPatterns(source, pattern, hardCheck);
+        CsrGraph graph(source);
+        std::vector<CombinatoricsData> sparse = sparseGetAllPatterns(graph, pattern, hardCheck);
+
+        // комбинации совпадают с точностью до порядка
+        std::sort(dense.begin(), dense.end());
+        std::sort(sparse.begin(), sparse.end());
+        assert(dense.size() == sparse.size());
+        for (int k = 0; k < (int) dense.size(); k++)
+            assert(dense[k] == sparse[k]);
+        assert(sparseCountAllPatterns(graph, pattern, hardCheck) == (long long) dense.size());
+    }
+}
+
+/**
+ * Главный метод
+ * @return код возрата
+ */
+int main() {
+    long ltime = time(nullptr);
+    int stime = (unsigned int) ltime / 2;
+    srand(stime);
+
+    std::cout << "TEST 1:" << std::endl;
+    testCsrGraph();
+    std::cout << "TEST 2:" << std::endl;
+    testLargeGraph(1000000);
+    std::cout << "TEST 3:" << std::endl;
+    compare(10, 30, 40, 3, 5, 0, 3, 0.5, true);
+    std::cout << "TEST 4:" << std::endl;
+    compare(10, 30, 40, 3, 5, -2, 2, 0.3, false);
+    std::cout << "TEST 5:" << std::endl;
+    compare(10, 60, 80, 2, 4, 1, 3, 0.2, false);
+    std::cout << "TEST 6:" << std::endl;
+    compare(10, 60, 80, 3, 5, -1, 2, 0.3, true);
+}
@@ -0,0 +1,140 @@
+#include <cassert>
+#include <ctime>
+#include <iostream>
+#include <set>
+#include "misc/combinatorics.h"
+#include "misc/Matrix.h"
+#include "misc/PatternBuilder.h"
+#include "fastPatternResolver.h"
+#include "patternSymmetry.h"
+
+/**
+ * Проверка кол-ва автоморфизмов у известных паттернов
+ */
+void testKnownGroups() {
+    // ориентированный цикл из трёх вершин: только повороты
+    Matrix cycle(3);
+    for (int i = 0; i < 3; i++)
+        cycle.set(i, (i + 1) % 3, 1);
+    assert(getAutomorphisms(cycle).size() == 3);
+
+    // неориентированный цикл из четырёх вершин: повороты и отражения
+    Matrix square(4);
+    for (int i = 0; i < 4; i++) {
+        square.set(i, (i + 1) % 4, 1);
+        square.set((i + 1) % 4, i, 1);
+    }
+    assert(getAutomorphisms(square).size() == 8);
+
+    // полный граф из четырёх вершин: все перестановки
+    Matrix clique(4);
+    for (int i = 0; i < 4; i++)
+        for (int j = 0; j < 4; j++)
+            if (i != j)
+                clique.set(i, j, 1);
+    std::vector<CombinatoricsData> automorphisms = getAutomorphisms(clique);
+    assert(automorphisms.size() == 24);
+    // первым идёт тождественный автоморфизм
+    for (int i = 0; i < 4; i++)
+        assert(automorphisms.front().getData()[i] == i);
+    // у полного графа ограничения задают возрастающий порядок всех точек
+    assert(getSymmetryBreakingConstraints(automorphisms).size() == 6);
+}
+
+/**
+ * Получить случайный связный симметричный паттерн: у таких паттернов чаще есть нетождественные
+ * автоморфизмы, а связность не даёт кол-ву вхождений расти как кол-во всех комбинаций
+ *
+ * @param sz          размер стороны паттерна
+ * @param maxE        максимальное значение элементов
+ * @param nonZeroPart доля ненулевых элементов
+ * @return паттерн
+ */
+Matrix randomSymmetricPattern(int sz, int maxE, double nonZeroPart) {
+    Matrix res(sz);
+    for (int i = 0; i < sz; i++)
+        for (int j = i + 1; j < sz; j++)
+            if (j == i + 1 || (double) std::rand() / RAND_MAX < nonZeroPart) {
+                int value = std::rand() % maxE + 1;
+                res.set(i, j, value);
+                res.set(j, i, value);
+            }
+    return res;
+}
+
+/**
+ * Сверка поиска без симметричных повторов с полным быстрым поиском
+ *
+ * @param testCnt     кол-во тестов
+ * @param minS        минимальный размер матрицы-источника
+ * @param maxS        максимальный размер матрицы-источника
+ * @param minP        минимальный размер матрицы-паттерна
+ * @param maxP        максимальный размер матрицы-паттерна
+ * @param maxE        максимальный значение элементов матриц
+ * @param nonZeroPart доля ненулевых элементов
+ * @param hardCheck   флаг, нужна ли жёсткая сверка
+ */
+void compare(int testCnt, int minS, int maxS, int minP, int maxP, int maxE, double nonZeroPart, bool hardCheck) {
+    for (int i = 0; i < testCnt; i++) {
+        int sourceSize = std::abs(std::rand()) % (maxS - minS) + minS;
+        int patternSize = std::abs(std::rand()) % (maxP - minP) + minP;
+        // формируем случайные матрицы
+        Matrix source(randomMatrix(sourceSize, 0, maxE, nonZeroPart), sourceSize);
+        Matrix pattern = randomSymmetricPattern(patternSize, maxE, nonZeroPart);
+
+        // добавляем в дата-граф несколько паттернов
+        PatternBuilder pb(source);
+        for (int j = 0; j < 5;)
+            if (pb.putPattern(pattern.toArray(), patternSize, getRandomCombination(sourceSize, patternSize)))
+                j++;
+
+        std::vector<CombinatoricsData> automorphisms = getAutomorphisms(pattern);
+        std::vector<CombinatoricsData> all = fastGetAllPatterns(source, pattern, hardCheck);
+        std::vector<CombinatoricsData> unique = fastGetAllUniquePatterns(source, pattern, hardCheck);
+
+        // каждый подграф найден ровно столько раз, сколько у паттерна автоморфизмов
+        assert(unique.size() * automorphisms.size() == all.size());
+        assert(fastCountAllUniquePatterns(source, pattern, hardCheck) == (long long) unique.size());
+
+        // отображения, восстановленные по представителям, совпадают с полным результатом
+        std::unordered_set<CombinatoricsData, CombinatoricsData::HashFunction> allSet(all.begin(), all.end());
+        std::unordered_set<CombinatoricsData, CombinatoricsData::HashFunction> expandedSet;
+        for (const CombinatoricsData &cd: unique)
+            forEachAutomorphicMapping(
+                    IntSpan(cd.getData(), cd.getSize()), automorphisms, [&expandedSet](IntSpan c) {
+                        expandedSet.insert(CombinatoricsData(c.data(), c.size()));
+                        return true;
+                    });
+        assert(expandedSet == allSet);
+
+        // при жёсткой проверке у каждого представителя своё множество вершин
+        if (hardCheck) {
+            std::set<std::vector<int>> vertexSets;
+            for (const CombinatoricsData &cd: unique) {
+                std::vector<int> vertexSet(cd.getData(), cd.getData() + cd.getSize());
+                std::sort(vertexSet.begin(), vertexSet.end());
+                vertexSets.insert(vertexSet);
+            }
+            assert(vertexSets.size() == unique.size());
+        }
+    }
+}
+
+/**
+ * Главный метод
+ * @return код возрата
+ */
+int main() {
+    long ltime = time(nullptr);
+    int stime = (unsigned int) ltime / 2;
+    srand(stime);
+
+    std::cout << "TEST 1:" << std::endl;
+    testKnownGroups();
+    std::cout << "TEST 2:" << std::endl;
+    compare(20, 20, 30, 3, 6, 2, 0.5, true);
+    std::cout << "TEST 3:" << std::endl;
+    compare(20, 20, 30, 3, 6, 3, 0.4, false);
+    std::cout << "TEST 4:" << std::endl;
+    compare(10, 60, 80, 3, 5, 1, 0.1, true);
+}
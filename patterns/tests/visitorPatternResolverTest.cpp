@@ -0,0 +1,101 @@
+#include <atomic>
+#include <cassert>
+#include <ctime>
+#include <iostream>
+#include "misc/combinatorics.h"
+#include "misc/Matrix.h"
+#include "misc/PatternBuilder.h"
+#include "fastPatternResolver.h"
+
+/**
+ * Сверка поиска с обработчиком комбинаций с результатом `fastGetAllPatterns`
+ *
+ * @param testCnt     кол-во тестов
+ * @param minS        минимальный размер матрицы-источника
+ * @param maxS        максимальный размер матрицы-источника
+ * @param minP        минимальный размер матрицы-паттерна
+ * @param maxP        максимальный размер матрицы-паттерна
+ * @param minE        минимальное значение элементов матриц
+ * @param maxE        максимальный значение элементов матриц
+ * @param nonZeroPart доля ненулевых элементов
+ * @param hardCheck   флаг, нужна ли жёсткая сверка
+ */
+void compare(
+        int testCnt, int minS, int maxS, int minP, int maxP, int minE, int maxE, double nonZeroPart,
+        bool hardCheck
+) {
+    for (int i = 0; i < testCnt; i++) {
+        int sourceSize = std::abs(std::rand()) % (maxS - minS) + minS;
+        int patternSize = std::abs(std::rand()) % (maxP - minP) + minP;
+        // формируем случайные матрицы
+        Matrix source(randomMatrix(sourceSize, minE, maxE, nonZeroPart), sourceSize);
+        Matrix pattern(randomMatrix(patternSize, minE, maxE, nonZeroPart), patternSize);
+
+        // добавляем в дата-граф несколько паттернов
+        PatternBuilder pb(source);
+        for (int j = 0; j < 5;)
+            if (pb.putPattern(pattern.toArray(), patternSize, getRandomCombination(sourceSize, patternSize)))
+                j++;
+
+        std::vector<CombinatoricsData> expected = fastGetAllPatterns(source, pattern, hardCheck);
+        long long expectedCnt = (long long) expected.size();
+
+        // обработчик получает те же комбинации в том же порядке
+        long long visited = 0;
+        bool completed = fastForEachPattern(source, pattern, hardCheck, [&expected, &visited](IntSpan c) {
+            assert(c.size() == expected[visited].getSize());
+            for (int k = 0; k < c.size(); k++)
+                assert(c[k] == expected[visited].getData()[k]);
+            visited++;
+            return true;
+        });
+        assert(completed);
+        assert(visited == expectedCnt);
+
+        // остановка после заданного кол-ва комбинаций
+        long long limit = expectedCnt / 2 + 1;
+        visited = 0;
+        completed = fastForEachPattern(source, pattern, hardCheck, [&visited, &limit](IntSpan) {
+            return ++visited < limit;
+        });
+        assert(visited == std::min(limit, expectedCnt));
+        assert(completed == (expectedCnt < limit));
+
+        // в несколько потоков кол-во переданных комбинаций совпадает
+        std::atomic<long long> parallelVisited(0);
+        completed = fastForEachPattern(source, pattern, hardCheck, 4, [&parallelVisited](int, IntSpan) {
+            parallelVisited++;
+            return true;
+        });
+        assert(completed);
+        assert(parallelVisited.load() == expectedCnt);
+
+        // после остановки в несколько потоков новые ветки не начинаются
+        if (expectedCnt > 0) {
+            parallelVisited = 0;
+            completed = fastForEachPattern(source, pattern, hardCheck, 4, [&parallelVisited](int, IntSpan) {
+                parallelVisited++;
+                return false;
+            });
+            assert(!completed);
+            assert(parallelVisited.load() >= 1 && parallelVisited.load() <= 4);
+        }
+    }
+}
+
+/**
+ * Главный метод
+ * @return код возрата
+ */
+int main() {
+    long ltime = time(nullptr);
+    int stime = (unsigned int) ltime / 2;
+    srand(stime);
+
+    std::cout << "TEST 1:" << std::endl;
+    compare(10, 30, 40, 3, 5, 0, 3, 0.5, true);
+    std::cout << "TEST 2:" << std::endl;
+    compare(10, 30, 40, 3, 5, -2, 2, 0.3, false);
+    std::cout << "TEST 3:" << std::endl;
+    compare(10, 60, 80, 2, 4, 0, 2, 0.2, false);
+}